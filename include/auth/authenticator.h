@@ -5,22 +5,30 @@
 #include <QString> // More powerful version of <string>
 // Allows seamless use as soneone building a QT-based application
 #include <QHash> // Implements hash maps for key value pairs
+#include <functional> // Holds the callbacks that report login and registration results
 #include "../include/auth/email_validator.h"
-#include "../include/auth/user_session.h"
+#include "../include/auth/password_validator.h"
+#include "../include/auth/session_manager.h"
+#include "../include/auth/database_manager.h"
+#include "../include/auth/login_throttle.h"
 
 
 // Puts together user session tracking and logging athentication
+// Passwords are hashed on worker threads, so registering, logging in and
+// changing a password report back through a callback on the context object's
+// thread. Input that fails validation is reported before the call returns.
 class Authenticator {
-   private:
-       // BMCC password requirments/limits
-       const int MIN_PASSWORD_LENGTH = 8;
-       const int MAX_PASSWORD_LENGTH = 16;
-
+   public:
+       // Called with whether it worked and, if not, the message to show
+       using Result = std::function<void(bool ok, const QString &errorMsg)>;
 
-       // Creates hash mapping for email to password key to value pairs
-       QHash<QString, QString> userCredentials;
-       // Creates hash mapping for email to UserSession class objects key to value pairs
-       QHash<QString, UserSession*> activeSessions;
+   private:
+       // Persistent email to salted password hash store
+       AuthDatabaseManager credentials;
+       // Live sessions by token and by email, expired ones reclaimed by a timer wheel
+       SessionManager sessions;
+       // Turns away login attempts over the per account and global rates before hashing
+       LoginThrottle throttle;
        // Create email validator object
        // Basically a helper object to access validating email methods
        EmailValidator emailValidator;
@@ -28,14 +36,8 @@ class Authenticator {
 
        // Function validates password inputted and sends error if PW is invalid
        bool validatePassword(const QString &password, QString &errorMsg) const;
-
-
-       // My hash function! Turns key into hash code/index for secure storage
-       QString hashPassword(const QString &password) const;
-
-
-       // Creates unique session token to track and identify user
-       QString generateSessionToken() const;
+       // Takes a login attempt from the throttle and sends error if over the limit
+       bool allowAttempt(const QString &email, QString &errorMsg);
 
 
    public:
@@ -43,28 +45,41 @@ class Authenticator {
 
 
        // Registration
-       // User gets registered and mapped onto userCredentials hash map
-       bool registerUser(const QString &email,
+       // User gets registered and stored in the credentials table
+       void registerUser(const QString &email,
                        const QString &password,
-                       QString &errorMsg);
+                       QObject *context,
+                       Result done);
 
 
        // Login/Logout
-       // Logins user if valid and adds them into activeSessions hash map,
-       // creates session object
-       bool login(const QString &email,
+       // Logins user if valid and starts their session
+       void login(const QString &email,
                const QString &password,
-               QString &errorMsg);
-       // Logs user out and ends session
+               QObject *context,
+               Result done);
+       // Logs user out and ends session, forgetting them on this machine
        void logout(const QString &email);
 
 
+       // Keep me signed in
+       // Saves a long lived token so the next launch can skip the login window
+       void rememberUser(const QString &email);
+       // Whether a token was saved on this machine
+       bool hasRememberedUser() const;
+       // Checks the saved token and starts a session; done gets the email, or
+       // an empty string if the token was refused and the user has to log in
+       void resumeRememberedSession(QObject *context,
+                                    std::function<void(const QString &email)> done);
+
+
        // Password manager
        // Changes password unless old password is invalid, sends error message
-       bool changePassword(const QString &email,
+       void changePassword(const QString &email,
                            const QString &oldPassword,
                            const QString &newPassword,
-                           QString &errorMsg);
+                           QObject *context,
+                           Result done);
        // Resets password byt sending verification to email unless email doesnt exist
        bool resetPassword(const QString& email, QString& errorMsg);
 
@@ -72,8 +87,8 @@ class Authenticator {
        // Session manager
        // Checks if user is logged in
        bool isUserLoggedIn(const QString &email) const;
-       // Returns pointer to userSession object to get current user session
-       UserSession* getCurrentSession(const QString &email) const;
+       // Token of the user's current session, null if they have none
+       QUuid getSessionToken(const QString &email) const;
 };
 
 
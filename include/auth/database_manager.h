@@ -0,0 +1,108 @@
+#ifndef AUTH_DATABASE_MANAGER_H
+#define AUTH_DATABASE_MANAGER_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QThreadPool>
+#include <QVector>
+#include <QMutex>
+#include <atomic>
+#include <functional>
+
+// Stores user credentials in the credentials table of the shop's SQLite file.
+// Passwords are kept as salted PBKDF2-HMAC-SHA256 hashes. Each row records the
+// iteration count it was hashed with, so raising the cost never breaks
+// existing logins. A login that verifies against a cheaper hash rehashes it
+// at the current cost.
+//
+// Hashing is deliberately slow, so every operation runs on a small worker
+// pool and reports back through a callback. The callback runs on the thread of
+// the context object and is dropped if that object is gone. When the store is
+// created, the first worker task creates the tables and calibrates the
+// iteration count to Config::PASSWORD_HASH_TARGET_MS on this machine. Only
+// new hashes wait for the calibration; checks use the stored count.
+//
+// "Remember me" tokens are a random selector, which finds the row, and a
+// random validator, of which only the SHA-256 is stored, so a leaked table
+// can't be replayed. A token is single use: redeeming it returns a new one.
+// A known selector with the wrong validator means the token was copied, so
+// every token of that user is revoked.
+class AuthDatabaseManager : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Status { Ok, UnknownEmail, WrongPassword, EmailTaken, DatabaseError };
+    using Callback = std::function<void(Status)>;
+    struct NewUser {
+        QString email;
+        QString password;
+    };
+    // Email of a redeemed remember me token, empty if it was refused, and its replacement
+    struct Resumed {
+        QString email;
+        QString token;
+    };
+
+    explicit AuthDatabaseManager(QObject* parent = nullptr);
+    ~AuthDatabaseManager();
+
+    // Hashes and stores a new user, EmailTaken if one exists
+    void addUser(const QString& email, const QString& password, QObject* context, Callback done);
+    // Checks a password against the stored hash
+    void verify(const QString& email, const QString& password, QObject* context, Callback done);
+    // Replaces an existing user's password
+    void setPassword(const QString& email, const QString& password, QObject* context, Callback done);
+
+    // Long lived login token for the user, empty on failure
+    void issueRememberToken(const QString& email, QObject* context,
+                            std::function<void(const QString& token)> done);
+    void redeemRememberToken(const QString& token, QObject* context,
+                             std::function<void(const Resumed& resumed)> done);
+    // Signs the user out everywhere they chose to be remembered
+    void revokeRememberTokens(const QString& email);
+
+    // Bulk provisioning: hashes every password across the global thread pool,
+    // then inserts the users on the calling thread's connection, inside the
+    // caller's transaction if one is open. Users whose email already has
+    // credentials are skipped and come back false in added. Returns false on
+    // a database error, after which the caller should roll the batch back.
+    // Blocks for the whole batch, so never call it on the GUI thread.
+    bool insertUsers(const QVector<NewUser>& users, QVector<bool>& added);
+
+    // Iterations new hashes use, 0 until calibration has finished
+    int iterations() const { return cost.load(); }
+    // Blocks until every queued operation has finished
+    void waitForDone() { workers.waitForDone(); }
+
+    static QByteArray pbkdf2Sha256(const QByteArray& password, const QByteArray& salt,
+                                   int iterations, int length = 32);
+    // Iterations one hash needs to take about targetMs here, at least the configured minimum
+    static int calibrateIterations(int targetMs);
+
+private:
+    struct Hash {
+        QByteArray salt;
+        int iterations = 0;
+        QByteArray key;
+    };
+
+    // Creates the tables once, on whichever worker gets there first
+    bool prepare();
+    // Calibrates the cost the first time a new hash needs it
+    int iterationCost();
+    QString insertRememberToken(const QString& email);
+    void run(QObject* context, Callback done, std::function<Status()> work);
+    Hash hashPassword(const QString& password);
+    static bool matches(const Hash& stored, const QString& password);
+    // Ok, EmailTaken when inserting an existing email, UnknownEmail when updating a missing one
+    Status storeHash(const QString& email, const Hash& hash, bool insert);
+
+    QThreadPool workers;
+    QMutex prepareLock;
+    bool prepared = false;
+    QMutex calibrateLock;
+    std::atomic<int> cost{0};
+};
+
+#endif
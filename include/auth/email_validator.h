@@ -4,25 +4,27 @@
 
 #include <QtCore/QString>  // More powerful version of <string>
 // Allows seamless use as soneone building a QT-based application
-#include <QtCore/QRegularExpression> // This header allows you to allows you to define
-// patterns to search for in strings.
+#include <QtCore/QStringList>
+#include <QtCore/QStringView>
+#include <QtCore/QVector>
 
 
 // Define Email Validator class which will only enable BMCC domains
+// Checked by one scan over the characters with a lookup table, no regex and
+// no allocation, so a roster of thousands of emails can be checked at once
 
 
 class EmailValidator {
-   private:
-       // Only allowed domain to log in
-       const QString ALLOWED_DOMAIN = "@stu.bmcc.cuny.edu";
-
-
    public:
        EmailValidator();   // Constructor
 
 
        // Validates if the email is form @stu.bmcc.cuny.edu: returns T or F
-       bool isValidEmail(const QString &email) const;
+       bool isValidEmail(QStringView email) const;
+
+
+       // Validates every email, in parallel for large batches
+       QVector<bool> validateAll(const QStringList &emails) const;
 
 
        // Gets the domain from email to check for validation: returns string
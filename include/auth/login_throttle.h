@@ -0,0 +1,58 @@
+#ifndef LOGIN_THROTTLE_H
+#define LOGIN_THROTTLE_H
+
+#include <QString>
+#include <QElapsedTimer>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// Rate limits login attempts before any password is hashed, with one token
+// bucket per account and one for the whole app. An attempt takes a token
+// from its account's bucket, then from the global one; the account bucket
+// stops one email being hammered, the global one caps hashing work when a
+// script tries many emails.
+//
+// Each bucket is a single 64 bit atomic, updated with a compare and swap, so
+// any thread can check an attempt without a lock. It holds the bucket as the
+// time at which it will be full again (the GCRA form of a token bucket): an
+// attempt is allowed while that time is less than a burst ahead of now, and
+// moves it one refill interval later. A bucket at zero is full, which lets
+// accounts share a fixed table of buckets picked by a seeded hash of the
+// email. The table never grows however many distinct emails arrive; two
+// emails that land in the same bucket only ever throttle each other sooner.
+class LoginThrottle {
+public:
+    using Clock = std::function<qint64()>;  // Milliseconds, never going backwards
+
+    enum class Verdict {
+        Allowed,
+        AccountLimited,  // Too many recent attempts for this email
+        GlobalLimited    // Too many recent attempts overall
+    };
+
+    // Limits from Config; the clock is injectable so tests can move time
+    explicit LoginThrottle(Clock clock = Clock());
+
+    // Takes a token for an attempt at this email if both buckets have one
+    Verdict tryAcquire(const QString& email);
+
+    quint64 allowed() const { return allowedCount.load(std::memory_order_relaxed); }
+    quint64 accountLimited() const { return accountLimitedCount.load(std::memory_order_relaxed); }
+    quint64 globalLimited() const { return globalLimitedCount.load(std::memory_order_relaxed); }
+
+private:
+    static bool take(std::atomic<qint64>& fullAtUs, qint64 nowUs, int burst, int perMinute);
+    qint64 nowMs() const;
+
+    Clock clock;
+    QElapsedTimer monotonic;
+    size_t seed;
+    std::unique_ptr<std::atomic<qint64>[]> accounts;
+    std::atomic<qint64> global{0};
+    std::atomic<quint64> allowedCount{0};
+    std::atomic<quint64> accountLimitedCount{0};
+    std::atomic<quint64> globalLimitedCount{0};
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef PASSWORD_VALIDATOR_H
+#define PASSWORD_VALIDATOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QVector>
+
+// BMCC password rules: 8 to 16 characters with at least one uppercase letter
+// and one digit. A single pass over the characters, no regex and no
+// allocation, so a whole roster can be checked at once.
+class PasswordValidator {
+public:
+    static constexpr int MIN_LENGTH = 8;
+    static constexpr int MAX_LENGTH = 16;
+
+    // First rule a password breaks, in the order they are reported
+    enum class Problem { None, TooShort, TooLong, NoUppercase, NoDigit };
+
+    static Problem check(QStringView password);
+    // The message shown for a problem, empty for None
+    static QString message(Problem problem);
+
+    // Checks every password, in parallel for large batches
+    static QVector<Problem> checkAll(const QStringList& passwords);
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef ROSTER_PROVISIONER_H
+#define ROSTER_PROVISIONER_H
+
+#include <QString>
+#include <QVector>
+#include <QSet>
+
+class QIODevice;
+class QTextStream;
+class AuthDatabaseManager;
+class DatabaseManager;
+
+// Creates student accounts in bulk from a roster CSV with the columns
+// email,major,semester_level[,initial_password]. A header row is skipped.
+//
+// The roster is streamed in batches of Config::PROVISION_BATCH_ROWS rows.
+// Each batch is validated across the thread pool, its passwords are hashed
+// across the pool, and its credentials and student_profiles rows are written
+// in one transaction, so an interrupted run leaves whole batches behind.
+// Rows without an initial password get a random one, written to the
+// passwords output as email,password.
+class RosterProvisioner {
+public:
+    struct Rejected {
+        int line;
+        QString email;
+        QString reason;
+    };
+
+    struct Report {
+        int rows = 0;
+        int created = 0;
+        int batches = 0;
+        QVector<Rejected> rejected;
+        double seconds = 0.0;
+        double rowsPerSecond() const { return seconds > 0 ? rows / seconds : 0.0; }
+    };
+
+    RosterProvisioner(AuthDatabaseManager* credentials, DatabaseManager* db);
+
+    // passwords may be null when every row has its own initial password
+    Report run(QIODevice* roster, QTextStream* passwords);
+
+private:
+    struct Row {
+        int line;
+        QString email;
+        QString major;
+        QString semesterLevel;
+        QString password;
+        bool generated;
+    };
+
+    void provisionBatch(const QVector<Row>& batch, QTextStream* passwords, Report& report);
+    static QStringList splitCsvLine(const QString& line);
+    static QString generatePassword();
+
+    AuthDatabaseManager* credentials;
+    DatabaseManager* dbManager;
+    QSet<QString> seen;  // Emails of earlier, committed batches of this roster
+};
+
+#endif
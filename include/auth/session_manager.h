@@ -0,0 +1,85 @@
+#ifndef SESSION_MANAGER_H
+#define SESSION_MANAGER_H
+
+#include <QString>
+#include <QUuid>
+#include <QHash>
+#include <QVector>
+#include <QElapsedTimer>
+#include <array>
+#include <functional>
+
+// Logged in sessions, found by token or by user, one session per user.
+// Expiry times come from a monotonic millisecond clock, so checking a token
+// is one hash lookup and one compare, with no wall clock or time zone work.
+//
+// Expired sessions are reclaimed by a hierarchical timer wheel of one second
+// ticks: four levels of 64 slots, each slot spanning 64 times the one below,
+// which covers about 194 days. A session sits in one slot's list. Each tick
+// empties one level 0 slot, and when level 0 wraps, the next due slot of the
+// level above is redistributed into it. Adding, refreshing and removing a
+// session are O(1); the wheel is advanced by whichever call comes next.
+//
+// Sessions live in a flat array reused through a free list. Tokens are
+// stored as 16 byte UUIDs, so each session costs a fixed record plus its user
+// id, and the memory stays flat as sessions come and go.
+class SessionManager {
+public:
+    using Clock = std::function<qint64()>;  // Milliseconds, never going backwards
+
+    // Sessions last lifetimeSecs from their last refresh; the clock is
+    // injectable so tests can move time forward
+    explicit SessionManager(qint64 lifetimeSecs, Clock clock = Clock());
+
+    // Starts a session for the user, ending any they had, and returns its token
+    QUuid create(const QString& userId);
+    bool isValid(const QUuid& token) const;
+    // Token of the user's live session, null if there is none
+    QUuid tokenFor(const QString& userId) const;
+    // Pushes the session's expiry back to a full lifetime from now
+    bool refresh(const QUuid& token);
+    void remove(const QUuid& token);
+    void removeUser(const QString& userId);
+
+    // Runs the wheel up to now, reclaiming expired sessions
+    void advance();
+
+    int count() const { return byToken.size(); }
+    quint64 evictions() const { return evicted; }
+    // Session records allocated, live or on the free list
+    int capacity() const { return sessions.size(); }
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr qint32 NONE = -1;
+
+    struct Session {
+        QUuid token;
+        QString userId;
+        qint64 expiresMs = 0;
+        qint32 prev = NONE;   // Neighbours in the wheel slot list, or the free list
+        qint32 next = NONE;
+        qint16 bucket = NONE; // level * SLOTS + slot, NONE while free
+    };
+
+    qint64 nowMs() const;
+    void schedule(qint32 index);
+    void unlink(qint32 index);
+    void release(qint32 index);
+    void cascade(int level);
+
+    qint64 lifetimeMs;
+    Clock clock;
+    QElapsedTimer monotonic;
+    qint64 currentTick = 0;  // Last second the wheel has been run up to
+    QVector<Session> sessions;
+    qint32 freeList = NONE;
+    std::array<qint32, LEVELS * SLOTS> buckets;
+    QHash<QUuid, qint32> byToken;
+    QHash<QString, qint32> byUser;
+    quint64 evicted = 0;
+};
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef CATALOG_SNAPSHOT_H
+#define CATALOG_SNAPSHOT_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QPair>
+#include <climits>
+#include "database/textbook.h"
+#include "utils/compressed_bitmap.h"
+
+// Read-only copy of the textbooks table laid out column by column, so a
+// filter is a tight scan over one small integer array instead of a SQLite
+// query. Department, lec, category and course code are interned to ids and
+// prices are stored as integer cents; titles, authors and paths sit in their
+// own columns and are only read for rows that survive the filters.
+//
+// Each filter produces a selection bitmap, 64 rows per word, and the filters
+// are ANDed together. Newest pages walk the bitmap backwards; the price and
+// title sorts walk a precomputed row order and test each row's bit, the same
+// orders the SQLite covering indexes give the getTextbooks() queries.
+//
+// Alongside the columns every department, category, course code and price
+// bucket keeps a compressed bitmap of its rows, so the number of books each
+// filter choice would leave is one bitmap intersection with the selection.
+// Result orders offered by the catalog, ties broken by product id
+enum class CatalogSort {
+    Newest,
+    PriceLowToHigh,
+    PriceHighToLow,
+    Title
+};
+
+class CatalogSnapshot {
+public:
+    // Same meaning as the getTextbooks() parameters; empty strings match everything
+    struct Filter {
+        QString department;
+        QString lec;
+        QString category;
+        QString code;
+        QString text;           // Substring of title, author or "CSC 101"
+        int minPriceCents = 0;
+        int maxPriceCents = INT_MAX;
+        CatalogSort sort = CatalogSort::Newest;
+    };
+
+    using Selection = QVector<quint64>;
+
+    struct FacetCount {
+        QString value;
+        int count;
+    };
+
+    // Per choice counts, each facet counted with every other filter applied
+    // but its own, so the counts show what picking that choice would return
+    struct Facets {
+        QVector<FacetCount> departments;
+        QVector<FacetCount> categories;
+        QVector<FacetCount> codes;
+        QVector<FacetCount> prices;  // One per price bucket, in bucket order
+    };
+
+    static int priceBucketCount();
+    static QString priceBucketLabel(int bucket);
+    static QPair<int, int> priceBucketRange(int bucket);  // Inclusive, in cents
+
+    CatalogSnapshot();
+
+    void reserve(int rows);
+    void append(const Textbook& book);
+    void clear();
+    int size() const { return rowCount; }
+
+    // Bitmap of the rows passing every column filter (the text filter is not
+    // part of it, it is checked while paging)
+    Selection select(const Filter& filter) const;
+    QVector<Textbook> search(const Filter& filter, int page, int pageSize) const;
+    Facets facets(const Filter& filter) const;
+
+    Textbook book(int row) const;
+
+    // Brings the price and title row orders up to date with appended rows.
+    // Call once after a batch of append(); search() sorts on the fly until then.
+    void buildSortOrders();
+
+private:
+    // Interned strings of one column, id 0 is the empty string
+    struct Dictionary {
+        QVector<QString> values;
+        QHash<QString, quint32> ids;
+
+        Dictionary() { intern(QString()); }
+        quint32 intern(const QString& value);
+        int find(const QString& value) const { return ids.value(value, -1); }
+    };
+
+    bool matchesText(int row, const QString& text) const;
+    // select() narrowed by the text filter as well
+    Selection selectMatching(const Filter& filter) const;
+    bool priceBefore(quint32 a, quint32 b) const;
+    bool titleBefore(quint32 a, quint32 b) const;
+    // Rows in price or title order, up to date even before buildSortOrders()
+    QVector<quint32> sortedRows(CatalogSort sort) const;
+    static QVector<FacetCount> countFacet(const Dictionary& dictionary,
+                                          const QVector<CompressedBitmap>& rows,
+                                          const Selection& selection);
+
+    int rowCount;
+    Dictionary departments;
+    Dictionary lecs;
+    Dictionary categories;
+    Dictionary codes;
+
+    // Hot columns, scanned by the filters
+    QVector<quint32> departmentIds;
+    QVector<quint32> lecIds;
+    QVector<quint32> categoryIds;
+    QVector<quint32> codeIds;
+    QVector<qint32> priceCents;
+
+    // Facet bitmaps, indexed by dictionary id or price bucket
+    QVector<CompressedBitmap> departmentRows;
+    QVector<CompressedBitmap> categoryRows;
+    QVector<CompressedBitmap> codeRows;
+    QVector<CompressedBitmap> priceRows;
+
+    // Every row by (price, product id) and by (title, product id)
+    QVector<quint32> priceOrder;
+    QVector<quint32> titleOrder;
+
+    // Cold columns, read for matching rows only
+    QVector<QString> productIds;
+    QVector<QString> titles;
+    QVector<QString> authors;
+    QVector<QString> imagePaths;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef CATALOG_STORE_H
+#define CATALOG_STORE_H
+
+#include <QMutex>
+#include <QPair>
+#include <QVector>
+#include <atomic>
+#include "database/catalog_snapshot.h"
+
+// Publishes immutable CatalogSnapshot versions to any number of reader
+// threads. Readers pin the current version with two atomic operations and
+// never wait for a writer; a writer copies the current version, changes the
+// copy and swaps it in with one atomic store.
+//
+// Replaced versions are freed by epoch: a pin announces the epoch it started
+// in, every publish advances the epoch, and a retired version is deleted once
+// no pin that could have seen it is still held. Writers are serialized among
+// themselves with a mutex that readers never touch.
+class CatalogStore {
+    struct Version {
+        CatalogSnapshot snapshot;
+        quint64 number;
+    };
+
+public:
+    // Pins held at the same time, across all threads. A pin beyond this
+    // yields until another reader lets go.
+    static constexpr int MAX_READERS = 64;
+
+    // Keeps one version alive while in scope; hold it only as long as the read
+    class Pin {
+    public:
+        Pin(Pin&& other) noexcept;
+        ~Pin();
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+        Pin& operator=(Pin&&) = delete;
+
+        bool isNull() const { return version == nullptr; }  // Nothing published yet
+        const CatalogSnapshot& operator*() const { return version->snapshot; }
+        const CatalogSnapshot* operator->() const { return &version->snapshot; }
+        quint64 number() const { return version ? version->number : 0; }
+
+    private:
+        friend class CatalogStore;
+        Pin(const Version* version, std::atomic<quint64>* slot) : version(version), slot(slot) {}
+
+        const Version* version;
+        std::atomic<quint64>* slot;
+    };
+
+    CatalogStore();
+    ~CatalogStore();  // No pins may outlive the store
+
+    Pin pin() const;
+    quint64 version() const;
+
+    // Replaces the current version
+    void publish(CatalogSnapshot snapshot);
+    // Publishes a changed copy of the current version
+    template <typename Change>
+    void update(Change change) {
+        QMutexLocker lock(&writeLock);
+        const Version* latest = current.load();
+        CatalogSnapshot next = latest ? latest->snapshot : CatalogSnapshot();
+        change(next);
+        publishLocked(std::move(next));
+    }
+
+    // Frees retired versions no pin can still see, returns how many remain
+    int reclaim();
+
+private:
+    // One cache line per slot so readers on different cores do not contend
+    struct alignas(64) Slot {
+        std::atomic<quint64> epoch{0};  // 0 while free
+    };
+
+    void publishLocked(CatalogSnapshot&& snapshot);
+    int reclaimLocked();
+
+    mutable Slot slots[MAX_READERS];
+    std::atomic<const Version*> current;
+    std::atomic<quint64> epoch;
+    QMutex writeLock;
+    QVector<QPair<const Version*, quint64>> retired;  // Version and the epoch it was replaced in
+    quint64 nextNumber;
+};
+
+#endif
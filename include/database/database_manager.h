@@ -5,11 +5,24 @@
 #include <QtSql/QSqlDatabase>
 #include <QDateTime>
 #include <QCoreApplication>
+#include <QObject>
+#include <QMutex>
+#include <QStringList>
+#include <climits>
 #include "textbook.h"
+#include "catalog_store.h"
+#include "user_profile.h"
+
+class DatabaseManager : public QObject {
+    Q_OBJECT
 
-class DatabaseManager {
 public:
-    DatabaseManager();
+    // The per-user product lists removeMany() can take from
+    enum class ItemList { Cart, Wishlist };
+
+    // Pass initializeNow = false to open and migrate later, e.g. on a worker
+    // thread through initializeDatabase() while the login window is up
+    explicit DatabaseManager(QObject* parent = nullptr, bool initializeNow = true);
     ~DatabaseManager();
 
     // Add Listing To DataBase Functionality
@@ -21,7 +34,8 @@ public:
         const QString& title,
         const QString& author,
         double price,
-        const QString& imagePath
+        const QString& imagePath,
+        const QString& sellerEmail = QString()
     );
     // Wishlist Functionality
     bool addToWishlist(const QString& userEmail, const QString& productId);
@@ -33,6 +47,15 @@ public:
     bool updateCartQuantity(const QString& userEmail, const QString& productId, int quantity);
     bool removeFromCart(const QString& userEmail, const QString& productId);
     QVector<QPair<Textbook, int>> getCart(const QString& userEmail);
+
+    // Batch versions, each one transaction with one prepared statement reused
+    // for every row. They return how many products changed, or -1 if the
+    // transaction failed and nothing was written.
+    // Adds one of each product that isn't in the cart yet
+    int addManyToCart(const QString& userEmail, const QStringList& productIds);
+    // Puts the wishlisted products in the cart, unless already there, and takes them off the wishlist
+    int moveWishlistToCart(const QString& userEmail, const QStringList& productIds);
+    int removeMany(const QString& userEmail, const QStringList& productIds, ItemList list);
     bool initializeDatabase();
     bool addTextbook(const Textbook& textbook);
     QVector<Textbook> getTextbooks(
@@ -42,17 +65,59 @@ public:
         const QString& code = "",
         const QString& title = "",
         int page = 1,
-        int itemsPerPage = 9
+        int itemsPerPage = 9,
+        int minPriceCents = 0,
+        int maxPriceCents = INT_MAX,
+        CatalogSort sort = CatalogSort::Newest
     );
+    // Cheapest and dearest listing in cents, for the price slider
+    QPair<int, int> getPriceBoundsCents();
+    // EXPLAIN QUERY PLAN lines of the query behind getTextbooks(), for the plan regression tests
+    QStringList explainTextbookSearch(const CatalogSnapshot::Filter& filter);
 
     // For student profiles and recommendations
     bool updateStudentProfile(const QString& email, const QString& major, const QString& semesterLevel);
-    QString getStudentMajor(const QString& email);
-    QString getStudentSemesterLevel(const QString& email);
-    QVector<Textbook> getRecommendedBooks(const QString& email);
-    
+    // Same for many students with one prepared statement, inside the caller's transaction if any
+    bool updateStudentProfiles(const QStringList& emails, const QStringList& majors, const QStringList& semesterLevels);
+    // Takes the fields from the loaded UserProfile, so no profile row is read again
+    QVector<Textbook> getRecommendedBooks(const QString& major, const QString& semester);
+
+    // Profile fields, cart totals, cart and wishlist ids and listing count in one query
+    UserProfile::Data getUserProfile(const QString& email);
+    // Items in the cart and what they cost together
+    QPair<int, double> getCartSummary(const QString& userEmail);
+
+    // Every textbook, in table order, for the in-memory catalog
+    QVector<Textbook> getAllTextbooks();
+    // Books the user has posted, newest first
+    QVector<Textbook> getListingsBySeller(const QString& sellerEmail);
+    // In-memory copy of the textbooks table, safe to read from any thread
+    CatalogStore& catalog() { return catalogStore; }
+    // Rebuilds the in-memory catalog from the table
+    void reloadCatalog();
+    // Every textbook with how many carts and wishlists it is in, for the search suggestions
+    QVector<QPair<Textbook, int>> getTextbookPopularity();
+
+signals:
+    void textbookAdded(const Textbook& textbook);
+    // Emitted after a write succeeds, so per-user state can follow without re-reading
+    void listingPosted(const QString& sellerEmail, const QString& productId);
+    // Batch calls report all their products in one signal
+    void cartChanged(const QString& userEmail, const QStringList& productIds, bool inCart);
+    void wishlistChanged(const QString& userEmail, const QStringList& productIds, bool added);
+    void studentProfileChanged(const QString& email, const QString& major, const QString& semesterLevel);
+
+private slots:
+    void flushCatalogAppends();
+
 private:
-    QSqlDatabase db;
+    CatalogStore catalogStore;
+    QMutex pendingLock;
+    QVector<Textbook> pendingBooks;  // Inserted since the last published version
+    void queueCatalogAppend(const Textbook& book);
+
+    // Id query of one catalog page, without LIMIT; appends its bind values
+    QString textbookSearchSql(const CatalogSnapshot::Filter& filter, QVariantList& values) const;
     void createTables();
     void populateInitialData();
     void createRecommendationTables();
@@ -0,0 +1,18 @@
+#ifndef DB_CONNECTOR_H
+#define DB_CONNECTOR_H
+
+#include <QSqlDatabase>
+
+// Hands out the SQLite connection for the calling thread. A QSqlDatabase may
+// only be used by the thread that created it, so the GUI thread gets the
+// default connection and every worker thread lazily opens its own connection
+// to the same file, which is closed again when that thread exits.
+class DbConnector {
+public:
+    static QSqlDatabase database();
+
+private:
+    static QSqlDatabase open(const QString& connectionName);
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef MUTATION_QUEUE_H
+#define MUTATION_QUEUE_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <functional>
+
+class DatabaseManager;
+
+// Runs cart and wishlist writes off the GUI thread so a click never waits on
+// SQLite. Writes run one at a time in the order they were submitted, on a
+// worker with its own connection, and none is ever dropped; the destructor
+// waits for the queue to drain. DatabaseManager's change signals are queued
+// back to the GUI thread ahead of finished, so by the time a page hears a
+// write succeeded UserProfile already reflects it.
+class MutationQueue : public QObject {
+    Q_OBJECT
+
+public:
+    // Returns whether the write went through
+    using Write = std::function<bool(DatabaseManager&)>;
+
+    explicit MutationQueue(DatabaseManager* db, QObject* parent = nullptr);
+    ~MutationQueue();
+
+    // Queues a write and returns its ticket for matching up finished
+    quint64 submit(Write write);
+    int pending() const { return queued; }
+
+signals:
+    void finished(quint64 ticket, bool ok);
+
+private:
+    DatabaseManager* dbManager;
+    QThreadPool worker;
+    quint64 nextTicket;
+    int queued;
+};
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef QUERY_HANDLER_H
+#define QUERY_HANDLER_H
+
+#include <QObject>
+#include <QVector>
+#include <QThreadPool>
+#include <QTimer>
+#include <QHash>
+#include <atomic>
+#include <memory>
+#include "database/database_manager.h"
+#include "utils/config.h"
+#include "utils/fuzzy_index.h"
+
+// Runs catalog searches off the GUI thread. Every search() call gets a new
+// generation number and supersedes all earlier ones: a query that is still
+// waiting for the worker is skipped, and results of a query that finished
+// after a newer one was submitted are dropped instead of being shown.
+// Only the newest search ever reaches searchFinished.
+//
+// A title search that finds nothing is checked against a spelling index of
+// every title and author word, and the corrected text, if any, is offered
+// through didYouMean right after the empty results.
+//
+// With Config::IN_MEMORY_CATALOG the worker answers searches from the
+// catalog version it pins in DatabaseManager::catalog(), and follows the
+// results with facet counts for the filter choices through facetsUpdated.
+//
+// Once a page has been shown and nothing new is searched for a moment, the
+// worker speculatively fetches the next and previous pages with the same
+// filters at low priority and decodes their covers into the ThumbnailCache.
+// A page turn that finds its page prefetched is answered without touching
+// the worker, and so is one turning back to a page already shown. Any new search, or cancelPrefetch(), stops that work between
+// two steps.
+class QueryHandler : public QObject {
+    Q_OBJECT
+
+public:
+    struct SearchRequest {
+        QString department;
+        QString lec;
+        QString category;
+        QString code;
+        QString title;
+        int minPriceCents = 0;
+        int maxPriceCents = INT_MAX;
+        CatalogSort sort = CatalogSort::Newest;
+        int page = 1;
+        int pageSize = Config::CATALOG_PAGE_SIZE;
+    };
+
+    explicit QueryHandler(DatabaseManager* db, QObject* parent = nullptr);
+    ~QueryHandler();
+
+    // Queues a search and returns its generation
+    quint64 search(const SearchRequest& request);
+    quint64 currentGeneration() const { return generation->load(); }
+
+    // Submit to results latency percentile over the recent searches, in milliseconds
+    double latencyPercentile(double percentile) const;
+
+    // Stops background prefetching, for when the catalog is no longer on screen
+    void cancelPrefetch();
+    // Page turns answered from a prefetched page, and those that had to wait
+    int prefetchHits() const { return pageTurnHits; }
+    int prefetchMisses() const { return pageTurnMisses; }
+    // Whether a turn to the page with the current filters would be answered at once
+    bool hasPrefetched(int page) const { return prefetched.contains(page); }
+
+signals:
+    void searchFinished(quint64 generation, const QVector<Textbook>& results);
+    void didYouMean(quint64 generation, const QString& correction);
+    void facetsUpdated(quint64 generation, const CatalogSnapshot::Facets& facets);
+
+private:
+    struct Answer {
+        QVector<Textbook> results;
+        CatalogSnapshot::Facets facets;
+        bool hasFacets = false;
+        QString correction;
+    };
+
+    void deliver(quint64 searchGeneration, const Answer& answer, double queryMs, double totalMs);
+    void startPrefetch();
+    // Every request field but the page, prefetched pages are kept per filter
+    static QString filterKey(const SearchRequest& request);
+    QString correctSpelling(const QString& text);  // Worker thread only
+    Answer searchCatalog(const SearchRequest& request);
+
+    DatabaseManager* dbManager;
+    // Shared with queued tasks so they can see they were superseded
+    std::shared_ptr<std::atomic<quint64>> generation;
+    QThreadPool workers;
+    FuzzyIndex spelling;                    // Touched only by the worker
+    std::atomic<bool> spellingStale;        // Set when a listing is added
+    QVector<double> latencies;  // Ring buffer of total latencies
+
+    // Bumped by every search and cancelPrefetch(), running prefetches watch it
+    std::shared_ptr<std::atomic<quint64>> prefetchEpoch;
+    QTimer prefetchIdle;
+    SearchRequest lastRequest;
+    int lastResultCount;
+    QString prefetchedFilter;       // filterKey() the prefetched pages belong to
+    QHash<int, Answer> prefetched;  // By page number, shown pages included
+    int pageTurnHits;
+    int pageTurnMisses;
+    int nextLatency;
+    int skipped;
+};
+
+#endif
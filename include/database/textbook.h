@@ -2,6 +2,7 @@
 #define TEXTBOOK_H
 
 #include <QString>
+#include <QStringList>
 
 class Textbook {
 public:
@@ -28,6 +29,8 @@ public:
     );
     
     QString getImagePath() const { return imagePath; }
+    // Title, author and "CSC 101" style course codes, as typed into the search bar
+    QStringList searchTerms() const;
 };
 
 #endif
\ No newline at end of file
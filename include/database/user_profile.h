@@ -0,0 +1,57 @@
+#ifndef USER_PROFILE_H
+#define USER_PROFILE_H
+
+#include <QObject>
+#include <QString>
+#include "utils/sorted_id_set.h"
+
+class DatabaseManager;
+
+// What the shop shows about the signed in user: their major and semester,
+// cart size and total, wishlisted products and how many listings they have
+// posted, plus which products are in the cart and wishlist. It is read in
+// one query at login and then kept current from DatabaseManager's change
+// signals, so the nav bar badges, the pages and every catalog card read it
+// without going back to the database. Membership, profile and listing
+// changes are applied from the signal itself; a cart change also re-reads
+// the cart's two sums, since the signal doesn't carry the prices.
+class UserProfile : public QObject {
+    Q_OBJECT
+
+public:
+    struct Data {
+        QString email;
+        QString major;
+        QString semesterLevel;
+        int cartCount = 0;       // Items, counting quantities
+        double cartTotal = 0.0;
+        SortedIdSet cart;        // Product ids
+        SortedIdSet wishlist;
+        int listingCount = 0;
+    };
+
+    explicit UserProfile(DatabaseManager* db, QObject* parent = nullptr);
+
+    // Loads everything for the user in one read; an empty email clears it
+    void load(const QString& email);
+
+    const QString& email() const { return data.email; }
+    const QString& major() const { return data.major; }
+    const QString& semesterLevel() const { return data.semesterLevel; }
+    int cartCount() const { return data.cartCount; }
+    double cartTotal() const { return data.cartTotal; }
+    const SortedIdSet& cart() const { return data.cart; }
+    const SortedIdSet& wishlist() const { return data.wishlist; }
+    bool isInCart(const QString& productId) const { return data.cart.contains(productId); }
+    bool isWishlisted(const QString& productId) const { return data.wishlist.contains(productId); }
+    int listingCount() const { return data.listingCount; }
+
+signals:
+    void changed();
+
+private:
+    DatabaseManager* dbManager;
+    Data data;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef CARD_FRAME_H
+#define CARD_FRAME_H
+
+#include <QWidget>
+#include <QColor>
+#include <QPixmap>
+
+// Card container used by every shop page (book cards, cart rows, listings...)
+// Instead of a QGraphicsDropShadowEffect per card, which renders each card
+// offscreen and blurs it on every repaint, the shadow is drawn from a
+// pre-blurred nine-patch pixmap that is generated once and shared by all cards.
+class CardFrame : public QWidget {
+    Q_OBJECT
+
+public:
+    // Shadow presets matching the drop shadows the pages used before
+    enum class Shadow {
+        Small,   // blur 10, alpha 30, offset 2 - list rows and small cards
+        Medium,  // blur 15, alpha 50, offset 2 - catalog cards
+        Large    // blur 20, alpha 50, offset 5 - page containers
+    };
+
+    explicit CardFrame(Shadow shadow = Shadow::Small, int cornerRadius = 10, QWidget* parent = nullptr);
+
+    void setCornerRadius(int radius);
+    void setBackgroundColor(const QColor& color);
+    void setBorderColor(const QColor& color);   // Transparent disables the border
+    void setHoverColor(const QColor& color);    // Invalid color disables hover
+
+    // Fixes the visible card size; the shadow margins are added around it
+    void setFixedCardSize(int width, int height);
+
+    // Rectangle of the card itself, without the shadow margins
+    QRect cardRect() const;
+
+    // Shared, cached nine-patch for a shadow preset and corner radius
+    static QPixmap shadowPixmap(Shadow shadow, int cornerRadius);
+    // Paints a shadow for a card occupying cardRect
+    static void paintShadow(QPainter& painter, const QRect& cardRect, Shadow shadow, int cornerRadius);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void enterEvent(QEnterEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+
+private:
+    struct ShadowSpec {
+        int blurRadius;
+        int alpha;
+        int offsetY;
+    };
+    static ShadowSpec specFor(Shadow shadow);
+    static QImage blurredRoundedRect(const ShadowSpec& spec, int cornerRadius);
+
+    Shadow shadowStyle;
+    int radius;
+    QColor background;
+    QColor border;
+    QColor hover;
+    bool hovered;
+};
+
+#endif
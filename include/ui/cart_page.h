@@ -6,8 +6,10 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QScrollArea>
-#include <QSpinBox>
+#include <memory>
 #include "database/database_manager.h"
+#include "ui/listing_widget.h"
+#include "ui/row_pool.h"
 
 class CartPage : public QWidget {
     Q_OBJECT
@@ -33,6 +35,7 @@ private:
     DatabaseManager* dbManager;
     QString currentUserEmail;
     QVBoxLayout* cartItemsLayout;
+    std::unique_ptr<RowPool<CartRow>> cartRows;  // One row per product, reused across refreshes
     QLabel* totalLabel;
     QLabel* itemCountLabel;
     double cartTotal;
@@ -40,16 +43,11 @@ private:
     double total;
 
     void setupUI();
-    QWidget* createCartItem(const Textbook& book, int quantity);
+    CartRow* createCartRow(const QPair<Textbook, int>& item);
     void updateTotal();
     void updateItemCount();
     QScrollArea* createStyledScrollArea();
     QPushButton* createStyledButton(const QString& text, bool isPrimary = false);
-    
-    // Style constants
-    const QString sageGreen = "#9CAF88";    
-    const QString darkBlue = "#2C3E50";
-    const QString lightSage = "#E8F0E3";
 };
 
 #endif
\ No newline at end of file
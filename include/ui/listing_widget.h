@@ -0,0 +1,136 @@
+#ifndef LISTING_WIDGET_H
+#define LISTING_WIDGET_H
+
+#include <QPair>
+#include <QLabel>
+#include <QPushButton>
+#include <QSpinBox>
+#include "ui/card_frame.h"
+#include "database/textbook.h"
+
+// Row and card widgets that each show one textbook. They are kept alive by a
+// RowPool between refreshes, so every widget can be refilled in place with
+// setItem() and reports the product id it currently shows in its signals
+// instead of capturing the book it was created for.
+
+// Cart row: cover, title, course details, line price, quantity and remove link
+class CartRow : public CardFrame {
+    Q_OBJECT
+
+public:
+    explicit CartRow(const QPair<Textbook, int>& item, QWidget* parent = nullptr);
+    void setItem(const QPair<Textbook, int>& item);
+    QString productId() const { return id; }
+
+signals:
+    void quantityChanged(const QString& productId, int quantity);
+    void removeRequested(const QString& productId);
+
+private:
+    QString id;
+    QString imagePath;
+    bool imageLoaded;
+    QLabel* imageLabel;
+    QLabel* titleLabel;
+    QLabel* detailsLabel;
+    QLabel* priceLabel;
+    QSpinBox* quantityBox;
+};
+
+// Wishlist row: cover, title, course details, price, move to cart and remove
+class WishlistRow : public CardFrame {
+    Q_OBJECT
+
+public:
+    explicit WishlistRow(const Textbook& book, QWidget* parent = nullptr);
+    void setItem(const Textbook& book);
+    QString productId() const { return id; }
+
+signals:
+    void moveToCartRequested(const QString& productId);
+    void removeRequested(const QString& productId);
+
+private:
+    QString id;
+    QString imagePath;
+    bool imageLoaded;
+    QLabel* imageLabel;
+    QLabel* titleLabel;
+    QLabel* detailsLabel;
+    QLabel* priceLabel;
+};
+
+// Catalog card on the All Books tab, with cart and wishlist icon buttons
+class BookCard : public CardFrame {
+    Q_OBJECT
+
+public:
+    explicit BookCard(const Textbook& book, QWidget* parent = nullptr);
+    void setItem(const Textbook& book);
+    QString productId() const { return id; }
+    // Marks the cart and wishlist buttons when the product is already in them
+    void setMembership(bool inCart, bool inWishlist);
+    bool isInWishlist() const { return inWishlist; }
+
+signals:
+    void addToCartRequested(const QString& productId);
+    void addToWishlistRequested(const QString& productId);
+    void removeFromWishlistRequested(const QString& productId);  // The heart is a toggle
+
+private:
+    QString id;
+    QString imagePath;
+    bool imageLoaded;
+    bool inWishlist;
+    QLabel* imageLabel;
+    QLabel* titleLabel;
+    QLabel* courseLabel;
+    QLabel* priceLabel;
+    QPushButton* cartButton;
+    QPushButton* wishlistButton;
+};
+
+// List entry on the Recommended tab
+class RecommendedRow : public CardFrame {
+    Q_OBJECT
+
+public:
+    explicit RecommendedRow(const Textbook& book, QWidget* parent = nullptr);
+    void setItem(const Textbook& book);
+    QString productId() const { return id; }
+    void setInCart(bool inCart);
+
+signals:
+    void addToCartRequested(const QString& productId);
+
+private:
+    QString id;
+    QString imagePath;
+    bool imageLoaded;
+    QLabel* imageLabel;
+    QLabel* titleLabel;
+    QLabel* courseLabel;
+    QLabel* priceLabel;
+    QPushButton* cartButton;
+};
+
+// Card in the profile page's Your Listings grid
+class ListingCard : public CardFrame {
+    Q_OBJECT
+
+public:
+    explicit ListingCard(const Textbook& book, QWidget* parent = nullptr);
+    void setItem(const Textbook& book);
+    QString productId() const { return id; }
+
+private:
+    QString id;
+    QString imagePath;
+    bool imageLoaded;
+    QLabel* imageLabel;
+    QLabel* titleLabel;
+    QLabel* priceLabel;
+    QLabel* statusLabel;
+};
+
+#endif
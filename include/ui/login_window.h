@@ -5,14 +5,13 @@
 #include <QLineEdit> // Creates single line input box
 #include <QPushButton> // Gives clickable button
 #include <QLabel> // Displays static, dynamic text, or images
+#include <QCheckBox> // Keep me signed in option
 #include <QVBoxLayout> // Arranges widgets in a vertical column
 #include "../auth/authenticator.h"
 
 #include <QGraphicsEffect>  // For modifying my widgets appearence like CSS
 #include <QPropertyAnimation>  // Smooth time based transtions for objects
-#include <QGraphicsDropShadowEffect>  // Enables drop shadow effects for widgets
 
-class QGraphicsDropShadowEffect;  // Access effects
 class QGraphicsOpacityEffect;  // Access effects
 class QPropertyAnimation;  // Access transitions
 
@@ -29,6 +28,9 @@ class LoginWindow : public QWidget {
    // Class constructor that is only called intentionally
    explicit LoginWindow(Authenticator* auth, QWidget *parent = nullptr);
 
+   // Locks the form while a remembered session is checked at startup
+   void setResuming(bool resuming);
+
 
    // My signal responders
    private slots:
@@ -50,6 +52,7 @@ class LoginWindow : public QWidget {
        QLineEdit* passwordInput;   // password input field
        QPushButton* loginButton;   // Login Button
        QPushButton* registerButton;    // Register Button
+       QCheckBox* rememberCheck;   // Keep me signed in
        QLabel* statusLabel;    // Status Update for login success/failure
       
        // Pointer to Authentication object to handle authentication login process
@@ -12,18 +12,19 @@
 #include <QApplication>   // Add this for qApp
 #include "../auth/authenticator.h"
 #include "database/database_manager.h"
+#include "database/user_profile.h"
 #include "../ui/profile_menu.h"    // Add this for ProfileMenu
 #include "ui/profile_page.h" // This is for the profile page
+#include "utils/suggestion_index.h"
 
 #include <QGraphicsEffect>  // For modifying my widgets appearance like CSS
 #include <QPropertyAnimation>  // Smooth time based transitions for objects
-#include <QGraphicsDropShadowEffect>  // Enables drop shadow effects for widgets
 
 class QHBoxLayout;
 class QVBoxLayout;
-class TextbookPage;
-class CartPage;
-class WishlistPage;
+class QCompleter;
+class QStringListModel;
+class PageManager;
 
 class MainShopWindow : public QMainWindow {
     Q_OBJECT    // How I make my slots and signal connections
@@ -41,6 +42,7 @@ protected:
 
 private slots:
     void handleSearch();    // My slots to respond to signals
+    void updateSuggestions(const QString& text);    // Refills the search bar's completer
     void showHomepage();    // Returns to main homepage
     void showTextbooks();
     void showFurniture();
@@ -64,20 +66,15 @@ private:
     QWidget* createFeaturedTab(const QString& category);
     void switchFeaturedTab(int index);
 
-    // Profile Components
-    ProfilePage* profilePage;
-
-    // Wishlist page
-    WishlistPage* wishlistPage;
-
-    // Cart Page
-    CartPage* cartPage;
+    // Builds the category, cart, wishlist and profile pages on first use
+    PageManager* pages;
 
     // Core components
     Authenticator* authenticator;   // Manages my user authentication
     QString currentUserEmail;   // Stores the email of the user logged in
     QStackedWidget* contentStack;   // Stack for displaying my windows
     DatabaseManager* dbManager; // Stores my database for products
+    UserProfile* profile;   // Signed in user's profile, cart and wishlist figures, loaded once at login
     QLabel* logoLabel;         // Clickable BMCC logo
 
     // Related to my profile button
@@ -90,9 +87,14 @@ private:
     QToolBar* preNavBar;   // My pre-navigation bar
     QToolBar* navBar;   // My navigation bar
     QLineEdit* searchBar;   // My search bar input box
+    QCompleter* searchCompleter;    // Typeahead popup under the search bar
+    QStringListModel* suggestionModel;  // Rows currently shown in the popup
+    SuggestionIndex suggestions;    // Titles, authors and course codes to suggest
     QPushButton* homeButton;   // Returns to homepage
     QPushButton* cartButton;    // Open cart button
     QPushButton* wishlistButton;    // Wishlist button
+    QLabel* cartBadge;      // Item count over the cart icon
+    QLabel* wishlistBadge;  // Item count over the wishlist icon
     
     // Category buttons
     QPushButton* textbooksButton;   // Textbook category button
@@ -108,22 +110,17 @@ private:
     void setupCategoryBar();  // Loads in my category bar
     void setupContentArea();    // Loads in my content area, under category bar
     void setupStyles();  // Styles for my main shop/global
+    void buildSuggestionIndex();  // Loads every textbook into the suggestion index
     
     // Helper methods
     QPushButton* createNavButton(const QString& iconPath, const QString& text); // Automatically creates new nav bar button
-    QPushButton* createPreNavButton(const QString& iconPath, const QString& style);
+    QPushButton* createPreNavButton(const QString& iconPath);
     QPushButton* createCategoryButton(const QString& text); // Makes new category button
+    QWidget* showPage(const QString& name);  // Hides the homepage and shows a content page
     QWidget* createCategoryWidget(const QString& category); // Makes new category widget to add to stack
     void applyButtonStyle(QPushButton* button, bool isCategory = false); // Applies consistent styling to buttons
-
-    // My Main Style Colors
-    const QString sageGreen = "#9CAF88";    
-    const QString darkBlue = "#2C3E50";
-    const QString lightSage = "#E8F0E3";
-    const QString white = "#FFFFFF";
-    const QString black = "#000000";
-    const QString darkGrey = "#666666";
-    const QString lightGrey = "#D3D3D3";
+    QLabel* createBadge(QPushButton* button);  // Count bubble in the icon's top right corner
+    void updateBadges();    // Shows the profile's cart and wishlist counts
 
 signals:
     void logoutRequested(); // logout request is emitted on logout button click
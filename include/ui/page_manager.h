@@ -0,0 +1,69 @@
+#ifndef PAGE_MANAGER_H
+#define PAGE_MANAGER_H
+
+#include <QObject>
+#include <QHash>
+#include <QStringList>
+#include <functional>
+
+class QStackedWidget;
+class QWidget;
+
+// Owns the pages of a QStackedWidget and builds each one the first time it
+// is shown, instead of all of them when the window opens. Built pages are
+// kept for quick return visits, up to a fixed number; the least recently
+// shown one is deleted when another is built. Pinned pages are never evicted.
+//
+// A page's factory also makes the page's outside connections. Those are made
+// once per page object and die with it, so showing a page again never stacks
+// up duplicate handlers.
+class PageManager : public QObject {
+    Q_OBJECT
+
+public:
+    using Factory = std::function<QWidget*()>;
+
+    // Build time of one page, for the startup and navigation logs
+    struct BuildStats {
+        int builds = 0;
+        double lastMs = 0.0;
+        double totalMs = 0.0;
+    };
+
+    PageManager(QStackedWidget* stack, int capacity, QObject* parent = nullptr);
+
+    void registerPage(const QString& name, Factory factory, bool pinned = false);
+
+    // Builds the page if needed and makes it the current one
+    QWidget* show(const QString& name);
+    // The page if it is built, without building it
+    QWidget* page(const QString& name) const { return built.value(name); }
+    template <typename T>
+    T* page(const QString& name) const { return qobject_cast<T*>(page(name)); }
+    QString current() const;
+
+    // Drops a built page, e.g. one that holds the previous user's data
+    void evict(const QString& name);
+
+    BuildStats stats(const QString& name) const { return buildStats.value(name); }
+
+signals:
+    void pageBuilt(const QString& name, QWidget* page, double ms);
+
+private:
+    struct Entry {
+        Factory factory;
+        bool pinned;
+    };
+
+    void evictOverCapacity();
+
+    QStackedWidget* stack;
+    int capacity;                    // Unpinned pages kept built
+    QHash<QString, Entry> entries;
+    QHash<QString, QWidget*> built;
+    QStringList recent;              // Built unpinned pages, least recently shown first
+    QHash<QString, BuildStats> buildStats;
+};
+
+#endif
@@ -14,6 +14,9 @@ signals:
     void profileRequested();
     void logoutRequested();
 
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
 private:
     QPushButton* profileButton;
     QPushButton* logoutButton;
@@ -15,8 +15,11 @@
 #include <QGridLayout>
 #include <QVBoxLayout>
 #include <QMessageBox>
+#include <memory>
 #include "../auth/authenticator.h"
 #include "../database/database_manager.h"
+#include "ui/listing_widget.h"
+#include "ui/row_pool.h"
 
 // Define Order structure
 class Order {
@@ -36,7 +39,8 @@ class ProfilePage : public QWidget {
     Q_OBJECT
 
 public:
-    explicit ProfilePage(Authenticator* auth, DatabaseManager* db, const QString& email, QWidget* parent = nullptr);
+    explicit ProfilePage(Authenticator* auth, DatabaseManager* db, UserProfile* profile,
+                         const QString& email, QWidget* parent = nullptr);
     void loadUserProfile();
 
 private slots:
@@ -49,9 +53,11 @@ private slots:
 
 private:
     QGridLayout* listingsGrid;
+    std::unique_ptr<RowPool<ListingCard>> listingCards;  // One card per listing, reused across refreshes
     // Core components
     Authenticator* authenticator;
     DatabaseManager* dbManager;
+    UserProfile* profile;  // Loaded at login, so opening the page reads no profile rows
     QString userEmail;
     QString firstName;
     QString lastName;
@@ -70,10 +76,6 @@ private:
     QWidget* createOrderHistorySection();  // Add new section for orders
     QWidget* createOrderItem(const QString& title, double price, const QString& status, const QString& imagePath);
     QScrollArea* createStyledScrollArea();
-    QWidget* createListingCard(const QString& title = "Sample Listing", 
-                             double price = 99.99,
-                             const QString& status = "Active",
-                             const QString& imagePath = "");
     QPushButton* createStyledButton(const QString& text, bool isPrimary = false);
     
     void setupUI();
@@ -83,11 +85,6 @@ private:
     QString handleImageUpload();
     bool validateListingForm(const QString& title, const QString& price, const QString& description);
     void loadOrderHistory();  // Load order history into the UI
-    
-    // Style constants
-    const QString sageGreen = "#9CAF88";    
-    const QString darkBlue = "#2C3E50";
-    const QString lightSage = "#E8F0E3";
 };
 
 #endif
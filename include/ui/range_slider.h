@@ -0,0 +1,45 @@
+#ifndef RANGE_SLIDER_H
+#define RANGE_SLIDER_H
+
+#include <QWidget>
+
+// Horizontal slider with a low and a high handle over 0..maximum. Qt has no
+// two handle slider, and two QSliders side by side let the ends cross.
+class RangeSlider : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit RangeSlider(QWidget* parent = nullptr);
+
+    void setMaximum(int maximum);  // Clamps the handles into the new range
+    int maximum() const { return maxValue; }
+
+    // Moves both handles without emitting rangeChanged
+    void setRange(int low, int high);
+    int low() const { return lowValue; }
+    int high() const { return highValue; }
+
+    QSize sizeHint() const override;
+
+signals:
+    void rangeChanged(int low, int high);  // Emitted while a handle is dragged
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+
+private:
+    enum class Handle { None, Low, High };
+
+    int positionOf(int value) const;
+    int valueAt(int x) const;
+
+    int maxValue;
+    int lowValue;
+    int highValue;
+    Handle dragging;
+};
+
+#endif
@@ -10,7 +10,6 @@
 
 #include <QGraphicsEffect>  // For modifying my widgets appearence like CSS
 #include <QPropertyAnimation>  // Smooth time based transtions for objects
-#include <QGraphicsDropShadowEffect>  // Enables drop shadow effects for widgets
 
 
 class RegistrationWindow : public QWidget {
@@ -0,0 +1,143 @@
+#ifndef ROW_POOL_H
+#define ROW_POOL_H
+
+#include <QBoxLayout>
+#include <QGridLayout>
+#include <QHash>
+#include <QVector>
+#include <QWidget>
+#include <utility>
+
+// Keeps one row widget per product id inside a layout. reconcile() diffs the
+// rows on screen against a fresh list of items: rows whose id is still present
+// are kept and updated in place, rows for new ids are created and rows whose id
+// disappeared are destroyed. Nothing else is rebuilt on a refresh.
+//
+// Row must be a QWidget subclass with a void setItem(const Item&) overload that
+// refreshes only the fields that changed.
+template <typename Row>
+class RowPool {
+public:
+    struct Stats {
+        int reused = 0;
+        int created = 0;
+        int removed = 0;
+    };
+
+    // Rows fill a QBoxLayout from the front, or a QGridLayout row by row when
+    // columns is greater than zero. Widgets the layout holds after the rows
+    // (stretches, footers) stay after them.
+    explicit RowPool(QLayout* layout, int columns = 0)
+        : layout(layout), columns(columns), placeholder(nullptr) {}
+
+    // Widget shown in place of the rows while the list is empty
+    void setPlaceholder(QWidget* widget) {
+        placeholder = widget;
+        placeholder->hide();
+    }
+
+    template <typename Item, typename KeyFn, typename CreateFn>
+    Stats reconcile(const QVector<Item>& items, KeyFn keyOf, CreateFn create) {
+        Stats stats;
+        QHash<QString, Row*> previous;
+        previous.swap(rows);
+
+        QVector<Row*> ordered;
+        ordered.reserve(items.size());
+        for (const Item& item : items) {
+            QString key = keyOf(item);
+            for (int n = 1; rows.contains(key); ++n) {
+                key = keyOf(item) + '#' + QString::number(n);  // Same id listed twice
+            }
+
+            Row* row = previous.take(key);
+            if (row) {
+                row->setItem(item);
+                ++stats.reused;
+            } else {
+                row = create(item);
+                ++stats.created;
+            }
+            rows.insert(key, row);
+            ordered.append(row);
+        }
+
+        for (Row* row : std::as_const(previous)) {
+            layout->removeWidget(row);
+            row->hide();
+            row->deleteLater();  // The row may be the sender that triggered this refresh
+            ++stats.removed;
+        }
+
+        showPlaceholder(ordered.isEmpty());
+        place(ordered);
+        return stats;
+    }
+
+    Row* row(const QString& key) const { return rows.value(key, nullptr); }
+    int count() const { return rows.size(); }
+
+    // Calls fn(Row*) for every row, in no particular order
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (Row* row : rows) {
+            fn(row);
+        }
+    }
+
+private:
+    // Moves only the rows whose position changed
+    void place(const QVector<Row*>& ordered) {
+        QGridLayout* grid = qobject_cast<QGridLayout*>(layout);
+        QBoxLayout* box = qobject_cast<QBoxLayout*>(layout);
+        for (int i = 0; i < ordered.size(); ++i) {
+            QWidget* row = ordered[i];
+            int current = layout->indexOf(row);
+            if (grid && columns > 0) {
+                int r = i / columns, c = i % columns;
+                if (current >= 0) {
+                    int curRow, curCol, rowSpan, colSpan;
+                    grid->getItemPosition(current, &curRow, &curCol, &rowSpan, &colSpan);
+                    if (curRow == r && curCol == c) {
+                        continue;
+                    }
+                    grid->removeWidget(row);
+                }
+                grid->addWidget(row, r, c);
+            } else if (box) {
+                if (current == i) {
+                    continue;
+                }
+                if (current >= 0) {
+                    box->removeWidget(row);
+                }
+                box->insertWidget(i, row);
+            }
+        }
+    }
+
+    void showPlaceholder(bool empty) {
+        if (!placeholder) {
+            return;
+        }
+        bool inLayout = layout->indexOf(placeholder) >= 0;
+        if (empty && !inLayout) {
+            if (QGridLayout* grid = qobject_cast<QGridLayout*>(layout)) {
+                grid->addWidget(placeholder, 0, 0, 1, qMax(columns, 1));
+            } else if (QBoxLayout* box = qobject_cast<QBoxLayout*>(layout)) {
+                box->insertWidget(0, placeholder);
+            }
+            placeholder->show();
+        } else if (!empty && inLayout) {
+            layout->removeWidget(placeholder);
+            placeholder->hide();
+        }
+    }
+
+    QLayout* layout;
+    int columns;
+    QWidget* placeholder;
+    QHash<QString, Row*> rows;
+};
+
+#endif
@@ -9,58 +9,125 @@
 #include <QLabel>
 #include <QScrollArea>
 #include <QVBoxLayout>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <memory>
 #include "database/database_manager.h"
+#include "database/mutation_queue.h"
+#include "database/query_handler.h"
+#include "ui/listing_widget.h"
+#include "ui/row_pool.h"
+#include "ui/range_slider.h"
+#include "ui/toast.h"
 
 class TextbookPage : public QWidget {
     Q_OBJECT
 
 public:
-    explicit TextbookPage(DatabaseManager* db, QWidget *parent = nullptr);
+    // Cards read cart and wishlist membership from profile, never from the database
+    TextbookPage(DatabaseManager* db, UserProfile* profile, QWidget *parent = nullptr);
     void setUserEmail(const QString& email);
     void refreshRecommendations();
+    void setSearchText(const QString& text);  // Live search from the main search bar
+
+    // Click to feedback latency percentile over the recent cart and wishlist clicks, in milliseconds
+    double feedbackLatencyPercentile(double percentile) const;
 
 private slots:
     void handleFilter();
+    void showDidYouMean(quint64 generation, const QString& correction);
+    void updateFacets(quint64 generation, const CatalogSnapshot::Facets& facets);
+    void acceptDidYouMean();
+    void scheduleSearch();
+    void applyPriceBucket();
+    void applyPriceSlider(int lowDollars, int highDollars);
     void handleNextPage();
     void handlePrevPage();
     void handleTabChange(int index);
+    void handleAddToCart(const QString& productId);
+    void handleAddToWishlist(const QString& productId);
+    void handleRemoveFromWishlist(const QString& productId);
+    void handleAddBundle();  // Every recommended book not yet in the cart
+    void updateMembership();  // Marks the cards and rows on screen from the profile
+    void finishMutation(quint64 ticket, bool ok);
+    void recordFeedback();
+
+protected:
+    void hideEvent(QHideEvent* event) override;
 
 private:
     DatabaseManager* dbManager;
+    UserProfile* profile;
     QString currentUserEmail;
     QTabWidget* mainTabWidget;
-    QWidget* createAllBooksTab();
     QWidget* createRecommendedTab();
-    QWidget* allBooksTab;
     QWidget* recommendedTab;
     QVBoxLayout* recommendedLayout;
-    QWidget* createRecommendedBookItem(const Textbook& book);
+    QPushButton* addBundleButton;
+    QStringList recommendedIds;  // Products on the recommended tab, in order
+    RecommendedRow* createRecommendedRow(const Textbook& book);
     QWidget* filterPanel;
     
     // Filter panel widgets
     QComboBox* departmentCombo;
     QLineEdit* lecInput;
     QComboBox* categoryCombo;
+    QComboBox* priceCombo;
+    QComboBox* sortCombo;
+    RangeSlider* priceSlider;   // Whole dollars, the top end means no upper limit
+    QLabel* priceRangeLabel;
+    QPair<int, int> priceRangeCents;  // Inclusive, from the slider or a picked bucket
     QLineEdit* codeInput;
     QLineEdit* searchInput;
+    QPushButton* didYouMeanButton;  // Offers a corrected search when nothing matched
+    QString suggestedSearch;
     QGridLayout* booksGrid;
     QGridLayout* recommendedGrid;
     QPushButton* prevButton;
     QPushButton* nextButton;
     int currentPage;
+    QueryHandler* queryHandler;  // Runs searches off the GUI thread
+    QTimer* searchDebounce;      // Restarted on every keystroke
+    std::unique_ptr<RowPool<BookCard>> bookCards;  // Catalog cards, reused across filters and pages
+    std::unique_ptr<RowPool<RecommendedRow>> recommendedRows;
+
+    // Cart and wishlist clicks update the cards at once and write in the
+    // background; the state a click asked for is shown until its write
+    // finishes, and a failed write falls back to what the profile says
+    struct Pending {
+        quint64 ticket;
+        bool state;
+    };
+    struct Mutation {
+        QStringList productIds;
+        bool cart;        // Which overlay the ids are pending in
+        QString failure;  // Error toast when the write fails
+    };
+    MutationQueue* mutations;
+    Toast* toast;
+    QHash<QString, Pending> pendingCart;
+    QHash<QString, Pending> pendingWishlist;
+    QHash<quint64, Mutation> inFlight;  // By ticket
+    QElapsedTimer clickTimer;           // From the latest click to its toast on screen
+    bool timingClick;
+    QVector<double> feedbackLatencies;  // Ring buffer
+    int nextFeedbackLatency;
     
     void setupUI();
     void setupFilterPanel();
-    void displayBooks(const QVector<Textbook>& books, QGridLayout* targetGrid);
-    QWidget* createBookCard(const Textbook& book);
-    void loadDepartments();
-    void loadCategories();
+    void setupLiveSearch();
+    void runSearch();
+    void displayBooks(const QVector<Textbook>& books);
+    BookCard* createBookCard(const Textbook& book);
+    void fillFacetCombo(QComboBox* combo, const QVector<CatalogSnapshot::FacetCount>& counts,
+                        bool valuesAreBuckets = false);
     void updateRecommendedBooks();
-
-    // Style constants
-    const QString sageGreen = "#9CAF88";    
-    const QString darkBlue = "#2C3E50";
-    const QString lightSage = "#E8F0E3";
+    void mutate(const QStringList& productIds, bool cart, bool state, MutationQueue::Write write,
+                const QString& message, const QString& failure);
+    bool shownInCart(const QString& productId) const;
+    bool shownWishlisted(const QString& productId) const;
+    void setPriceRange(int minCents, int maxCents);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef THEME_H
+#define THEME_H
+
+#include <QProxyStyle>
+#include <QColor>
+
+class QApplication;
+class QWidget;
+
+// Application wide look and feel. Colors live here once instead of in every
+// page header, and widgets are tagged with a Role instead of getting their own
+// style sheet string. Theme::Style reads the role when it polishes or paints a
+// widget, so nothing is parsed at runtime and every widget shares one style.
+namespace Theme {
+
+// Brand colors
+inline const QColor sageGreen(0x9C, 0xAF, 0x88);
+inline const QColor darkBlue(0x2C, 0x3E, 0x50);
+inline const QColor lightSage(0xE8, 0xF0, 0xE3);
+inline const QColor white(0xFF, 0xFF, 0xFF);
+inline const QColor darkGrey(0x66, 0x66, 0x66);
+inline const QColor lightGrey(0xD3, 0xD3, 0xD3);
+inline const QColor borderGrey(0xE0, 0xE0, 0xE0);
+inline const QColor trackGrey(0xF0, 0xF0, 0xF0);
+inline const QColor errorRed(0xFF, 0x52, 0x52);
+inline const QColor successGreen(0x4C, 0xAF, 0x50);
+
+enum class Role {
+    None,
+
+    // Labels
+    HeroTitle,      // 32px bold, dark blue
+    PageTitle,      // 28px bold, dark blue
+    SectionTitle,   // 24px bold, dark blue
+    Logo,           // 22px bold, dark blue
+    CardTitle,      // 16px bold, dark blue
+    Subtitle,       // 16px, grey
+    Muted,          // Body text, grey
+    FieldLabel,     // Bold, dark blue
+    Price,          // 18px bold, sage
+    Error,          // Red status text
+    Success,        // Green status text
+    Placeholder,    // 16px grey with 40px padding, for empty lists
+    ImageFrame,     // Light sage rounded box behind cover images
+    Badge,          // 11px bold white count on a sage pill, over nav icons
+
+    // Buttons
+    PrimaryButton,    // Sage pill, white text, dark blue on hover
+    SecondaryButton,  // White pill with sage border, sage on hover
+    LinkButton,       // Text only, underlined sage on hover
+    DangerLink,       // Red text only, underlined on hover
+    NavButton,        // Category bar entry, light sage on hover
+    IconButton,       // Transparent round icon button
+    RoundIconButton,  // Sage round icon button, dark blue when selected
+    TabButton,        // Featured section tab, sage when selected
+    MenuItem,         // Left aligned drop down menu entry
+
+    // Inputs
+    SearchField,    // Pill shaped line edit
+
+    // Containers
+    Panel,          // Light sage rounded panel
+    Divider,        // 1px light grey line
+    Indicator       // Tab indicator line, dark grey when selected
+};
+
+// Tags a widget with a role; must be called before the widget is first shown
+void setRole(QWidget* widget, Role role);
+Role role(const QWidget* widget);
+
+// Selection state for TabButton, RoundIconButton and Indicator widgets, restyles immediately
+void setSelected(QWidget* widget, bool selected);
+bool isSelected(const QWidget* widget);
+
+// Installs the palette, default font and Theme::Style on the application
+void apply(QApplication& app);
+
+class Style : public QProxyStyle {
+    Q_OBJECT
+
+public:
+    Style();
+
+    void polish(QWidget* widget) override;
+    void polish(QPalette& palette) override;
+
+    void drawPrimitive(PrimitiveElement element, const QStyleOption* option,
+                       QPainter* painter, const QWidget* widget = nullptr) const override;
+    void drawControl(ControlElement element, const QStyleOption* option,
+                     QPainter* painter, const QWidget* widget = nullptr) const override;
+    void drawComplexControl(ComplexControl control, const QStyleOptionComplex* option,
+                            QPainter* painter, const QWidget* widget = nullptr) const override;
+    QSize sizeFromContents(ContentsType type, const QStyleOption* option,
+                           const QSize& contentsSize, const QWidget* widget = nullptr) const override;
+    int pixelMetric(PixelMetric metric, const QStyleOption* option = nullptr,
+                    const QWidget* widget = nullptr) const override;
+
+private:
+    void drawButtonPanel(const QStyleOption* option, QPainter* painter, const QWidget* widget) const;
+    void drawButtonLabel(const QStyleOption* option, QPainter* painter, const QWidget* widget) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef TOAST_H
+#define TOAST_H
+
+#include <QWidget>
+#include <QTimer>
+
+// Short status message floating over the bottom of its parent page, in
+// place of a modal QMessageBox for routine feedback. It never takes focus or
+// input and hides itself after Config::TOAST_DURATION_MS; a new message
+// replaces the one showing. The toast follows its parent's size through an
+// event filter, so the page needs no layout slot for it.
+class Toast : public QWidget {
+    Q_OBJECT
+
+public:
+    enum class Kind { Info, Error };
+
+    explicit Toast(QWidget* parent);
+
+    void showMessage(const QString& text, Kind kind = Kind::Info);
+
+signals:
+    // A new message has reached the screen, for click to feedback timing
+    void painted();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    void place();
+
+    QString message;
+    Kind kind;
+    QTimer hideTimer;
+    bool awaitingPaint;
+};
+
+#endif
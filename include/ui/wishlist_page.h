@@ -6,7 +6,10 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QScrollArea>
+#include <memory>
 #include "database/database_manager.h"
+#include "ui/listing_widget.h"
+#include "ui/row_pool.h"
 
 class WishlistPage : public QWidget {
     Q_OBJECT
@@ -21,6 +24,7 @@ signals:
 
 private slots:
     void handleMoveToCart(const QString& productId);
+    void handleMoveAllToCart();
     void handleRemoveItem(const QString& productId);
     void handleContinueShopping();
 
@@ -28,19 +32,17 @@ private:
     DatabaseManager* dbManager;
     QString currentUserEmail;
     QVBoxLayout* wishlistItemsLayout;
+    std::unique_ptr<RowPool<WishlistRow>> wishlistRows;  // One row per product, reused across refreshes
     QLabel* itemCountLabel;
+    QPushButton* moveAllButton;
+    QStringList productIds;  // Products listed, in order
     int itemCount;
 
     void setupUI();
-    QWidget* createWishlistItem(const Textbook& book);
+    WishlistRow* createWishlistRow(const Textbook& book);
     QScrollArea* createStyledScrollArea();
     QPushButton* createStyledButton(const QString& text, bool isPrimary = false);
     void updateItemCount();
-    
-    // Style constants
-    const QString sageGreen = "#9CAF88";    
-    const QString darkBlue = "#2C3E50";
-    const QString lightSage = "#E8F0E3";
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef COMPRESSED_BITMAP_H
+#define COMPRESSED_BITMAP_H
+
+#include <QVector>
+
+// Set of row numbers stored the way Roaring bitmaps do it: rows are split
+// into chunks of 65536, and each chunk is either a sorted array of 16-bit
+// offsets (while it has few rows) or a plain 8 KB bitset (once it has many).
+// A rare facet value costs two bytes per row instead of a bit per catalog
+// row, and a common one never costs more than the bitset.
+class CompressedBitmap {
+public:
+    // Rows must be added in increasing order, as a table is loaded
+    void add(quint32 row);
+    bool contains(quint32 row) const;
+    int cardinality() const { return total; }
+
+    // Rows also set in a plain bitmap of 64 rows per word
+    int intersectionCount(const QVector<quint64>& words) const;
+
+    // Bytes held by the chunks, for the memory figures in the benchmarks
+    qint64 byteSize() const;
+
+private:
+    // A chunk converts to a bitset when its array would outgrow one
+    static constexpr int ARRAY_LIMIT = 4096;
+    static constexpr int CHUNK_WORDS = 65536 / 64;
+
+    struct Chunk {
+        quint32 key;                // Row >> 16
+        QVector<quint16> offsets;   // Sorted, while the chunk is an array
+        QVector<quint64> bits;      // CHUNK_WORDS words, once it is a bitset
+    };
+
+    QVector<Chunk> chunks;
+    int total = 0;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+// Application wide settings that more than one module needs
+namespace Config {
+
+// SQLite file every connection opens, relative to the working directory
+inline constexpr const char* DATABASE_FILE = "bmcc_store.db";
+
+// Quiet period after the last keystroke before a live search runs
+inline constexpr int SEARCH_DEBOUNCE_MS = 150;
+
+// Books per catalog page, also the size of the first batch of search results
+inline constexpr int CATALOG_PAGE_SIZE = 9;
+
+// Answer catalog filters from an in-memory copy of the textbooks table
+// instead of querying SQLite on every search
+inline constexpr bool IN_MEMORY_CATALOG = true;
+
+// Cover size on catalog cards, which the thumbnail cache decodes to
+inline constexpr int CARD_COVER_WIDTH = 200;
+inline constexpr int CARD_COVER_HEIGHT = 250;
+
+// Memory for decoded cover thumbnails, shared by cards and the prefetcher
+inline constexpr int THUMBNAIL_CACHE_KB = 32 * 1024;
+
+// Time on a catalog page with nothing new to search before the neighbouring
+// pages and their covers are fetched in the background
+inline constexpr int PREFETCH_IDLE_MS = 250;
+
+// Content pages kept built after they are left, besides the catalog
+inline constexpr int PAGE_CACHE_SIZE = 3;
+
+// Time one password hash should take on this machine; the PBKDF2 iteration
+// count is calibrated to it at startup, but never drops below the minimum
+inline constexpr int PASSWORD_HASH_TARGET_MS = 250;
+inline constexpr int PASSWORD_HASH_MIN_ITERATIONS = 100000;
+
+// Threads hashing passwords, so a slow hash never blocks the login window
+inline constexpr int PASSWORD_HASH_THREADS = 2;
+
+// How long a login session lasts after it was started or last refreshed
+inline constexpr int SESSION_LIFETIME_SECS = 24 * 3600;
+
+// How long "keep me signed in" lasts without opening the app
+inline constexpr int REMEMBER_ME_DAYS = 30;
+
+// Login attempts allowed before hashing: a burst, then a steady rate per
+// minute, for each email and for the whole app. The global rate stays under
+// what PASSWORD_HASH_THREADS can hash, so an attack can't queue up work.
+inline constexpr int LOGIN_ACCOUNT_BURST = 5;
+inline constexpr int LOGIN_ACCOUNT_PER_MINUTE = 5;
+inline constexpr int LOGIN_GLOBAL_BURST = 20;
+inline constexpr int LOGIN_GLOBAL_PER_MINUTE = 240;
+// Account buckets shared by all emails, eight bytes each
+inline constexpr int LOGIN_THROTTLE_SLOTS = 4096;
+
+// QSettings location of per-machine state such as the remember me token
+inline constexpr const char* SETTINGS_ORGANIZATION = "BMCC";
+inline constexpr const char* SETTINGS_APPLICATION = "E-Store";
+
+// Roster rows validated, hashed and committed together by the provisioning tool
+inline constexpr int PROVISION_BATCH_ROWS = 1000;
+
+// Number of recent searches kept for the latency percentiles
+inline constexpr int SEARCH_LATENCY_WINDOW = 200;
+
+// How long a toast message stays up
+inline constexpr int TOAST_DURATION_MS = 2500;
+
+// Click to feedback budget for cart and wishlist buttons, one 60 Hz frame,
+// and the number of recent clicks kept for its percentiles
+inline constexpr double FEEDBACK_BUDGET_MS = 16.7;
+inline constexpr int FEEDBACK_LATENCY_WINDOW = 200;
+
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef FUZZY_INDEX_H
+#define FUZZY_INDEX_H
+
+#include <QHash>
+#include <QString>
+#include <QStringView>
+#include <QVector>
+
+// Spelling index over the words of titles and authors, for "did you mean"
+// corrections. A trigram inverted index narrows a misspelled word down to the
+// few terms that share enough trigrams with it, and only those are checked
+// with a bounded edit distance.
+//
+// An edit changes at most three of a word's trigrams, so a term within k edits
+// shares at least grams(word) - 3k of them; terms below that count, or whose
+// length differs by more than k, are never compared at all.
+class FuzzyIndex {
+public:
+    struct Match {
+        QString term;
+        int distance;
+        quint32 frequency;
+    };
+
+    FuzzyIndex();
+
+    // Indexes every word of text, counting repeats
+    void insertText(const QString& text);
+    void insert(const QString& word, quint32 count = 1);
+    void clear();
+
+    // Closest known terms to word, nearest first and then most frequent
+    QVector<Match> lookup(const QString& word, int limit = 5) const;
+    // query with every unknown word replaced by its closest term, or an
+    // empty string when no word needed correcting
+    QString correct(const QString& query) const;
+
+    bool contains(const QString& word) const { return termIds.contains(fold(word)); }
+    int size() const { return keys.size(); }
+
+    // Edits allowed for a word of the given length
+    static int maxDistanceFor(int length);
+    // Levenshtein distance, or maxDistance + 1 if it is larger than maxDistance
+    static int editDistance(QStringView pattern, QStringView text, int maxDistance);
+
+private:
+    static QString fold(const QString& word);
+    static QVector<quint64> trigrams(QStringView key);
+
+    QVector<QString> keys;          // Case folded term, what is matched against
+    QVector<QString> display;       // Term as first seen, what is suggested
+    QVector<quint32> frequencies;
+    QHash<QString, quint32> termIds;
+    QHash<quint64, QVector<quint32>> postings;  // Trigram to the terms containing it
+};
+
+#endif
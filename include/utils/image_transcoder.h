@@ -0,0 +1,49 @@
+#ifndef IMAGE_TRANSCODER_H
+#define IMAGE_TRANSCODER_H
+
+#include <QString>
+#include <QSize>
+#include <QByteArray>
+
+// Re-encodes seller uploaded covers before they go into the asset directory.
+// Phone photos come in as multi-megabyte JPEG/PNG files with EXIF data, but the
+// shop never shows a cover bigger than a few hundred pixels, so we downscale
+// to a size cap, flatten onto white, drop all metadata and save with a tuned
+// quality setting (WebP when the Qt image plugin is available, JPEG otherwise).
+class ImageTranscoder {
+public:
+    // Per cover report so we can size the asset volume
+    struct Report {
+        bool ok = false;
+        QString outputPath;
+        QByteArray format;      // "webp" or "jpg"
+        QSize sourceSize;
+        QSize outputSize;
+        qint64 sourceBytes = 0;
+        qint64 outputBytes = 0;
+        double decodeMs = 0.0;  // Time to decode the transcoded cover
+        QString error;
+    };
+
+    // Largest cover we ever store, 2x the biggest card image for HiDPI screens
+    static constexpr int MAX_COVER_WIDTH = 500;
+    static constexpr int MAX_COVER_HEIGHT = 640;
+    static constexpr int WEBP_QUALITY = 80;
+    static constexpr int JPEG_QUALITY = 82;
+
+    // Transcodes sourcePath into destDir as <baseName>.<ext> and fills in the report
+    static Report transcodeCover(const QString& sourcePath,
+                                 const QString& destDir,
+                                 const QString& baseName);
+
+    // Format used for new covers on this build
+    static QByteArray preferredFormat();
+
+    // Total size in bytes and number of covers currently in an asset directory
+    static qint64 directoryFootprint(const QString& dir, int* fileCount = nullptr);
+
+    // Measures how long a cover takes to decode, in milliseconds
+    static double measureDecodeMs(const QString& path);
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+
+// Runs body(begin, end) over [0, count) in chunks of at least minChunk on the
+// global thread pool, and returns once every chunk is done. The calling
+// thread takes chunks too, so this finishes even when the pool is busy, and
+// pool tasks that start after the work ran out just return.
+template <typename Body>
+void parallelFor(int count, int minChunk, const Body& body) {
+    if (count <= 0) {
+        return;
+    }
+    const int threads = qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+    const int chunkSize = qMax(minChunk, (count + threads - 1) / threads);
+    const int chunks = (count + chunkSize - 1) / chunkSize;
+    if (chunks == 1) {
+        body(0, count);
+        return;
+    }
+
+    // Shared with pool tasks that may outlive this call, but never touch
+    // body once every chunk has been claimed
+    struct State {
+        std::atomic<int> next{0};
+        QSemaphore finished;
+    };
+    auto state = std::make_shared<State>();
+    const Body* work = &body;
+    auto drain = [state, work, count, chunkSize, chunks]() {
+        for (int chunk = state->next++; chunk < chunks; chunk = state->next++) {
+            const int begin = chunk * chunkSize;
+            (*work)(begin, qMin(count, begin + chunkSize));
+            state->finished.release();
+        }
+    };
+
+    for (int i = 1; i < chunks; ++i) {
+        QThreadPool::globalInstance()->start(drain);
+    }
+    drain();
+    state->finished.acquire(chunks);
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef SORTED_ID_SET_H
+#define SORTED_ID_SET_H
+
+#include <QString>
+#include <QStringList>
+#include <algorithm>
+#include <utility>
+
+// Product ids kept in one sorted array, for asking whether a catalog card's
+// product is in the user's cart or wishlist. A lookup is a binary search
+// over contiguous ids, with no hashing and no per-entry node; a user's cart
+// or wishlist holds tens of ids, so inserting into the array is cheap too.
+class SortedIdSet {
+public:
+    SortedIdSet() = default;
+
+    // Takes ids in any order, with repeats
+    explicit SortedIdSet(QStringList unsorted) {
+        std::sort(unsorted.begin(), unsorted.end());
+        unsorted.erase(std::unique(unsorted.begin(), unsorted.end()), unsorted.end());
+        ids = std::move(unsorted);
+    }
+
+    bool contains(const QString& id) const {
+        auto it = std::lower_bound(ids.cbegin(), ids.cend(), id);
+        return it != ids.cend() && *it == id;
+    }
+
+    // Both return whether the set changed
+    bool insert(const QString& id) {
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it != ids.end() && *it == id) {
+            return false;
+        }
+        ids.insert(it, id);
+        return true;
+    }
+
+    bool remove(const QString& id) {
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it == ids.end() || *it != id) {
+            return false;
+        }
+        ids.erase(it);
+        return true;
+    }
+
+    int size() const { return int(ids.size()); }
+    bool isEmpty() const { return ids.isEmpty(); }
+    const QStringList& toList() const { return ids; }
+
+    bool operator==(const SortedIdSet& other) const { return ids == other.ids; }
+    bool operator!=(const SortedIdSet& other) const { return ids != other.ids; }
+
+private:
+    QStringList ids;  // Ascending, no repeats
+};
+
+#endif
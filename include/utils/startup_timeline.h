@@ -0,0 +1,51 @@
+#ifndef STARTUP_TIMELINE_H
+#define STARTUP_TIMELINE_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// Records when each startup phase began and ended, in milliseconds since
+// the process started, from whichever thread ran it. main() dumps it with
+// --startup-timeline once the shop window is ready.
+class StartupTimeline {
+public:
+    // Times the enclosing scope as one phase
+    class Phase {
+    public:
+        explicit Phase(const QString& name);
+        ~Phase();
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+    private:
+        int index;
+    };
+
+    static StartupTimeline& instance();
+
+    int begin(const QString& name);
+    void end(int phase);
+    void mark(const QString& name);  // A point in time, like the first frame
+    double elapsedMs() const;
+
+    // One line per phase in start order, with its thread and duration
+    QString report() const;
+
+private:
+    StartupTimeline();
+
+    struct Entry {
+        QString name;
+        QString thread;
+        double startMs;
+        double endMs;  // Negative while running, equal to startMs for marks
+    };
+
+    QElapsedTimer clock;
+    mutable QMutex lock;
+    QVector<Entry> entries;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef SUGGESTION_INDEX_H
+#define SUGGESTION_INDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// In-memory typeahead index: a radix trie over case folded suggestion keys.
+// Every node keeps the ids of the heaviest entries below it, so a lookup only
+// walks the typed prefix and reads one small list; nothing is searched or
+// sorted per keystroke.
+//
+// Nodes live in one flat vector and address their children by index, and
+// every edge label is a slice of a shared character pool, so the index makes
+// no per-node allocations. Weights only ever grow, which is what keeps the
+// cached top lists exact without re-scanning subtrees.
+class SuggestionIndex {
+public:
+    // Suggestions kept per node, the number of rows the completer popup shows
+    static constexpr int TOP_K = 7;
+
+    SuggestionIndex();
+
+    // Adds text, or adds weight to it if the same key is already indexed
+    void insert(const QString& text, quint32 weight = 1);
+    // Up to limit entries starting with prefix, heaviest first
+    QStringList complete(const QString& prefix, int limit = TOP_K) const;
+
+    void clear();
+    int size() const { return entries.size(); }
+    int nodeCount() const { return nodes.size(); }
+
+private:
+    static constexpr quint32 NONE = 0xFFFFFFFF;
+
+    struct Node {
+        quint32 labelStart = 0;     // Edge label is labels.mid(labelStart, labelLength)
+        quint32 labelLength = 0;
+        quint32 firstChild = NONE;
+        quint32 nextSibling = NONE;
+        quint32 entry = NONE;       // Entry whose key ends at this node
+        quint32 topCount = 0;
+        quint32 top[TOP_K];         // Heaviest entries in this subtree
+    };
+
+    struct Entry {
+        QString text;
+        quint32 weight;
+    };
+
+    static QString normalize(const QString& text);
+    quint32 findChild(quint32 node, QChar first) const;
+    quint32 addNode(quint32 parent, const QString& key, int from);
+    quint32 splitEdge(quint32 node, quint32 at);
+    void promote(quint32 node, quint32 entry);
+
+    QVector<Node> nodes;
+    QVector<Entry> entries;
+    QString labels;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef THUMBNAIL_CACHE_H
+#define THUMBNAIL_CACHE_H
+
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+
+// Book covers decoded straight to card size and kept in memory, shared by
+// every thread. Cards on the GUI thread and the catalog prefetcher on the
+// search worker read through the same cache, so a cover warmed in the
+// background is only turned into a pixmap when its card is shown. Images,
+// not pixmaps, are cached because QPixmap may only be used by the GUI thread.
+class ThumbnailCache {
+public:
+    static ThumbnailCache& shared();
+
+    // Decodes on a miss, scaled to fit bounds. Null if the file can't be read.
+    QImage load(const QString& path, const QSize& bounds);
+    bool contains(const QString& path, const QSize& bounds) const;
+
+    int hits() const;
+    int misses() const;
+
+private:
+    ThumbnailCache();
+    static QString keyFor(const QString& path, const QSize& bounds);
+
+    mutable QMutex lock;
+    QCache<QString, QImage> images;  // Cost is in kilobytes
+    int hitCount;
+    int missCount;
+};
+
+#endif
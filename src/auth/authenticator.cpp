@@ -1,193 +1,217 @@
 #include "../include/auth/authenticator.h"
-#include <QCryptographicHash>
-// QT Class often used to securely has passwords using crypto hashes
-// I'm storing my passwords in non plain text
-#include <QUuid> // Generates unqiue identifiers
-// Using this to create my unqiue session tokens
+#include "../include/utils/config.h"
+#include <QSettings> // Keeps the remember me token between launches
+
+
+// Settings key of the remember me token
+static const char* const REMEMBER_TOKEN_KEY = "auth/rememberToken";
 
 // Define functions from authenticator class
 
 // Default Constructor
-Authenticator::Authenticator() {}
+Authenticator::Authenticator() : sessions(Config::SESSION_LIFETIME_SECS) {}
 
 
 // Registers user
-bool Authenticator::registerUser(const QString &email,
+void Authenticator::registerUser(const QString &email,
                                const QString &password,
-                               QString &errorMsg) {
+                               QObject *context,
+                               Result done) {
   
    // Error handling -- Validating email
    if(!emailValidator.isValidEmail(email)) {
-       errorMsg = QString::fromUtf8("Invalid email. Must be a @stu.bmcc.cuny.edu address");
-       return false;
-   }
-
-
-   // Check Users existance
-   // contains() checks if key exists in map
-   if(userCredentials.contains(email)) {
-       errorMsg = QString::fromUtf8("Email already registered");
-       return false;
+       done(false, QString::fromUtf8("Invalid email. Must be a @stu.bmcc.cuny.edu address"));
+       return;
    }
 
 
    // Error handling -- Validating password
+   QString errorMsg;
    if(!validatePassword(password, errorMsg)) {
-       return false;
+       done(false, errorMsg);
+       return;
    }
 
 
    // Registers user if passes validation
-   // Adds key-value pair with a HASHED password that is cryptohashed
-   userCredentials.insert(email, hashPassword(password));
-   return true;
+   // Stores a salted hash of the password, worked out on a worker thread
+   credentials.addUser(email, password, context, [done](AuthDatabaseManager::Status status) {
+       switch (status) {
+       case AuthDatabaseManager::Status::Ok:
+           done(true, QString());
+           break;
+       case AuthDatabaseManager::Status::EmailTaken:
+           done(false, QString::fromUtf8("Email already registered"));
+           break;
+       default:
+           done(false, QString::fromUtf8("Registration is unavailable right now, please try again"));
+           break;
+       }
+   });
 }
 
 
 // Logins in User
-bool Authenticator::login(const QString &email,
+void Authenticator::login(const QString &email,
                        const QString &password,
-                       QString &errorMsg) {
-
-
-   // If no key exists with email in hashmap, false
-   if (!userCredentials.contains(email)) {
-       errorMsg = QString::fromUtf8("Email not found");
-       return false;
+                       QObject *context,
+                       Result done) {
+   // Error handling -- Too many attempts, turned away before the costly hash
+   QString errorMsg;
+   if(!allowAttempt(email, errorMsg)) {
+       done(false, errorMsg);
+       return;
    }
 
 
-   // Verifys password
-   // If key to value pair don't match, Wrong password
-   if (userCredentials[email] != hashPassword(password)) {
-       errorMsg = QString::fromUtf8("Incorrect password");
-       return false;
-   }
-
-
-   // If validation is passed, create new session
+   credentials.verify(email, password, context, [this, email, done](AuthDatabaseManager::Status status) {
+       switch (status) {
+       case AuthDatabaseManager::Status::Ok:
+           break;
+       case AuthDatabaseManager::Status::UnknownEmail:
+           done(false, QString::fromUtf8("Email not found"));
+           return;
+       case AuthDatabaseManager::Status::WrongPassword:
+           done(false, QString::fromUtf8("Incorrect password"));
+           return;
+       default:
+           done(false, QString::fromUtf8("Login is unavailable right now, please try again"));
+           return;
+       }
+
+
+       // If validation is passed, create new session
+       // Replaces the user's existing session if any
+       sessions.create(email);
+       done(true, QString());
+   });
+}
 
 
-   // Generates unique session token
-   QString token = generateSessionToken();
+// Logs out of account and ends the user's session
+void Authenticator::logout(const QString &email) {
+   sessions.removeUser(email);
+   // Signing out also means not being signed back in on the next launch
+   credentials.revokeRememberTokens(email);
+   QSettings(Config::SETTINGS_ORGANIZATION, Config::SETTINGS_APPLICATION).remove(REMEMBER_TOKEN_KEY);
+}
 
 
-   // Delete existing session if any
-   if (activeSessions.contains(email)) {
-       delete activeSessions[email];
-   }
+// Issues a token on a worker and saves it once it is stored
+void Authenticator::rememberUser(const QString &email) {
+   credentials.issueRememberToken(email, &credentials, [](const QString &token) {
+       if (!token.isEmpty()) {
+           QSettings(Config::SETTINGS_ORGANIZATION, Config::SETTINGS_APPLICATION).setValue(REMEMBER_TOKEN_KEY, token);
+       }
+   });
+}
 
 
-   activeSessions[email] = new UserSession(email, token);
-  
-   return true;
+bool Authenticator::hasRememberedUser() const {
+   return QSettings(Config::SETTINGS_ORGANIZATION, Config::SETTINGS_APPLICATION).contains(REMEMBER_TOKEN_KEY);
 }
 
 
-// Logs out of account and removes active session token from activeSessions has map
-void Authenticator::logout(const QString &email) {
-   if (activeSessions.contains(email)) {
-       delete activeSessions[email];
-       activeSessions.remove(email);
+// Redeems the saved token, which hands back its replacement to save
+void Authenticator::resumeRememberedSession(QObject *context,
+                                            std::function<void(const QString &email)> done) {
+   const QString token = QSettings(Config::SETTINGS_ORGANIZATION, Config::SETTINGS_APPLICATION)
+                             .value(REMEMBER_TOKEN_KEY).toString();
+   if (token.isEmpty()) {
+       done(QString());
+       return;
    }
+   credentials.redeemRememberToken(token, context, [this, done](const AuthDatabaseManager::Resumed &resumed) {
+       QSettings settings(Config::SETTINGS_ORGANIZATION, Config::SETTINGS_APPLICATION);
+       if (resumed.email.isEmpty()) {
+           settings.remove(REMEMBER_TOKEN_KEY);
+           done(QString());
+           return;
+       }
+       settings.setValue(REMEMBER_TOKEN_KEY, resumed.token);
+       sessions.create(resumed.email);
+       done(resumed.email);
+   });
 }
 
 
 // Changes password with proper email and old password
-bool Authenticator::changePassword(const QString &email,
+void Authenticator::changePassword(const QString &email,
                    const QString &oldPassword,
                    const QString &newPassword,
-                   QString &errorMsg) {
-   // Verify the old password
-   // If login doesn't go through, something is incorrect or user doesn't exist
-   if(!login(email, oldPassword, errorMsg)) {
-       return false;
+                   QObject *context,
+                   Result done) {
+   // Validate new password
+   QString errorMsg;
+   if (!validatePassword(newPassword, errorMsg)) {
+       done(false, errorMsg);
+       return;
    }
 
 
-   // Validate new password
-   if (!validatePassword(newPassword, errorMsg)) {
-       return false;
+   // Guessing the old password here counts against the same limits as logging in
+   if (!allowAttempt(email, errorMsg)) {
+       done(false, errorMsg);
+       return;
    }
 
 
-   // If validation is passed, update password
-   // Updates key to value pair's value associated with key (email)
-   userCredentials[email] = hashPassword(newPassword);
-   return true;
+   // Verify the old password
+   // If it doesn't match, something is incorrect or user doesn't exist
+   credentials.verify(email, oldPassword, context,
+       [this, email, newPassword, context, done](AuthDatabaseManager::Status status) {
+           if (status != AuthDatabaseManager::Status::Ok) {
+               done(false, status == AuthDatabaseManager::Status::UnknownEmail
+                               ? QString::fromUtf8("Email not found")
+                               : QString::fromUtf8("Incorrect password"));
+               return;
+           }
+           // If validation is passed, update password
+           credentials.setPassword(email, newPassword, context, [done](AuthDatabaseManager::Status status) {
+               done(status == AuthDatabaseManager::Status::Ok,
+                    status == AuthDatabaseManager::Status::Ok ? QString()
+                        : QString::fromUtf8("Password could not be changed, please try again"));
+           });
+       });
 }
 
 
-// Checks if user is logged in using session object associated with key (email)
+// Checks if user is logged in with a session that hasn't expired
 bool Authenticator::isUserLoggedIn(const QString &email) const {
-   // If there is no active sessions associated with key, return false
-   if (!activeSessions.contains(email)) {
-       return false;
-   }
-  
-   // Creates pointer that points to a user session object
-   // Pointer points to session associated with key (email)
-   UserSession* session = activeSessions[email];
-   // Returns whether or not the session is valid
-   return session->isValid();
+   // A user without a session gets a null token, which is never valid
+   return sessions.isValid(sessions.tokenFor(email));
 }
 
 
-// Gets current session
-// Returns pointer pointing to key to value pair associated with email
-// pointing to a user session object
-UserSession* Authenticator::getCurrentSession(const QString& email) const {
-   return activeSessions.value(email, nullptr);
+// Gets current session token
+QUuid Authenticator::getSessionToken(const QString& email) const {
+   return sessions.tokenFor(email);
 }
 
 
 // Validates password according to length and charcters, returns error messages
 bool Authenticator::validatePassword(const QString &password, QString &errorMsg) const {
-   // Length Validator
-   if (password.length() < MIN_PASSWORD_LENGTH) {
-       errorMsg = QString("Password must be at least %1 characters long").arg(MIN_PASSWORD_LENGTH);
-       return false;
-   }
-  
-   if (password.length() > MAX_PASSWORD_LENGTH) {
-       errorMsg = QString("Password must not exceed %1 characters").arg(MAX_PASSWORD_LENGTH);
-       return false;
-   }
-  
-   // Check for at least one uppercase letter in password QString
-   if (!password.contains(QRegularExpression("[A-Z]"))) {
-       errorMsg = "Password must contain at least one uppercase letter";
-       return false;
-   }
-  
-   // Check for at least one number in password QString
-   if (!password.contains(QRegularExpression("[0-9]"))) {
-       errorMsg = "Password must contain at least one number";
+   // BMCC password requirments/limits, checked in one pass
+   const PasswordValidator::Problem problem = PasswordValidator::check(password);
+   if (problem != PasswordValidator::Problem::None) {
+       errorMsg = PasswordValidator::message(problem);
        return false;
    }
-  
    return true;
 }
 
 
-// Creates a crypto hash code / index code for password
-// Can be converted back to original format, this is purely for security
-QString Authenticator::hashPassword(const QString& password) const {
-   QByteArray hash = QCryptographicHash::hash(
-       password.toUtf8(),
-       QCryptographicHash::Sha256 // Uses the SHA-256 has algorithm
-   );
-   return QString(hash.toHex());
-   // Returns hex version of hashed password
-}
-
-
-// Creates unique intricate session codes use <QUuid> in QStrings
-QString Authenticator::generateSessionToken() const {
-   return QUuid::createUuid().toString();
+// Checks the login rate limits, returns error messages
+bool Authenticator::allowAttempt(const QString &email, QString &errorMsg) {
+   switch (throttle.tryAcquire(email)) {
+   case LoginThrottle::Verdict::Allowed:
+       return true;
+   case LoginThrottle::Verdict::AccountLimited:
+       errorMsg = QString::fromUtf8("Too many attempts for this account, please wait a minute and try again");
+       return false;
+   case LoginThrottle::Verdict::GlobalLimited:
+       errorMsg = QString::fromUtf8("Too many sign in attempts right now, please try again shortly");
+       return false;
+   }
+   return false;
 }
-
-
-
-
-
@@ -0,0 +1,408 @@
+#include "auth/database_manager.h"
+#include "database/db_connector.h"
+#include "utils/config.h"
+#include "utils/parallel.h"
+#include <QMessageAuthenticationCode>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QStringList>
+#include <QRandomGenerator>
+#include <QElapsedTimer>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QPointer>
+#include <QDebug>
+#include <climits>
+
+namespace {
+
+constexpr int SALT_BYTES = 16;
+constexpr int SELECTOR_BYTES = 12;
+constexpr int VALIDATOR_BYTES = 32;
+
+QByteArray randomBytes(int count) {
+    QByteArray bytes(count, Qt::Uninitialized);
+    QRandomGenerator* random = QRandomGenerator::system();
+    for (int i = 0; i < count; ++i) {
+        bytes[i] = char(random->bounded(256));
+    }
+    return bytes;
+}
+
+QByteArray sha256(const QByteArray& data) {
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+}
+
+// Runs a worker's callback on the context object's thread, or drops it if
+// the context was destroyed while the worker ran
+template <typename Done, typename Result>
+void deliver(const QPointer<QObject>& context, const Done& done, const Result& result) {
+    QObject* receiver = context.data();
+    if (!receiver) {
+        return;
+    }
+    QMetaObject::invokeMethod(receiver, [done, result]() { done(result); }, Qt::QueuedConnection);
+}
+
+// Compares every byte, so the time taken doesn't tell how much of a guess matched
+bool constantTimeEquals(const QByteArray& a, const QByteArray& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    char diff = 0;
+    for (int i = 0; i < a.size(); ++i) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+}
+
+AuthDatabaseManager::AuthDatabaseManager(QObject* parent) : QObject(parent) {
+    workers.setMaxThreadCount(Config::PASSWORD_HASH_THREADS);
+    workers.start([this]() {
+        prepare();
+        iterationCost();  // Calibrates while the login window is up
+    });
+}
+
+AuthDatabaseManager::~AuthDatabaseManager() {
+    workers.waitForDone();
+}
+
+bool AuthDatabaseManager::prepare() {
+    QMutexLocker locker(&prepareLock);
+    if (prepared) {
+        return true;
+    }
+
+    QSqlDatabase db = DbConnector::database();
+    if (!db.isOpen()) {
+        return false;  // DbConnector already logged the error; the next operation retries
+    }
+    QSqlQuery query(db);
+    if (!query.exec(
+            "CREATE TABLE IF NOT EXISTS credentials ("
+            "email TEXT PRIMARY KEY,"
+            "salt BLOB NOT NULL,"
+            "iterations INTEGER NOT NULL,"
+            "hash BLOB NOT NULL)")) {
+        qDebug() << "Error creating credentials table:" << query.lastError().text();
+        return false;
+    }
+    if (!query.exec(
+            "CREATE TABLE IF NOT EXISTS remember_tokens ("
+            "selector TEXT PRIMARY KEY,"
+            "validator_hash BLOB NOT NULL,"
+            "email TEXT NOT NULL,"
+            "expires_at INTEGER NOT NULL)")) {
+        qDebug() << "Error creating remember_tokens table:" << query.lastError().text();
+        return false;
+    }
+    query.exec("CREATE INDEX IF NOT EXISTS idx_remember_tokens_email ON remember_tokens (email)");
+    prepared = true;
+    return true;
+}
+
+int AuthDatabaseManager::iterationCost() {
+    QMutexLocker locker(&calibrateLock);
+    if (cost.load() == 0) {
+        QElapsedTimer timer;
+        timer.start();
+        cost.store(calibrateIterations(Config::PASSWORD_HASH_TARGET_MS));
+        qDebug() << "Password hashing calibrated to" << cost.load() << "iterations in"
+                 << timer.elapsed() << "ms";
+    }
+    return cost.load();
+}
+
+void AuthDatabaseManager::run(QObject* context, Callback done, std::function<Status()> work) {
+    const QPointer<QObject> guard(context);
+    workers.start([this, guard, done, work]() {
+        deliver(guard, done, prepare() ? work() : Status::DatabaseError);
+    });
+}
+
+void AuthDatabaseManager::addUser(const QString& email, const QString& password,
+                                  QObject* context, Callback done) {
+    run(context, done, [this, email, password]() {
+        QSqlQuery query(DbConnector::database());
+        query.prepare("SELECT 1 FROM credentials WHERE email = ?");
+        query.addBindValue(email);
+        if (!query.exec()) {
+            qDebug() << "Error checking credentials:" << query.lastError().text();
+            return Status::DatabaseError;
+        }
+        if (query.next()) {
+            return Status::EmailTaken;  // Checked first so a duplicate costs no hash
+        }
+        // A racing registration of the same email inserts nothing instead
+        return storeHash(email, hashPassword(password), true);
+    });
+}
+
+void AuthDatabaseManager::verify(const QString& email, const QString& password,
+                                 QObject* context, Callback done) {
+    run(context, done, [this, email, password]() {
+        QSqlQuery query(DbConnector::database());
+        query.prepare("SELECT salt, iterations, hash FROM credentials WHERE email = ?");
+        query.addBindValue(email);
+        if (!query.exec()) {
+            qDebug() << "Error reading credentials:" << query.lastError().text();
+            return Status::DatabaseError;
+        }
+        if (!query.next()) {
+            // Hashed anyway, so an unknown email takes as long as a wrong password
+            Hash dummy;
+            dummy.salt = randomBytes(SALT_BYTES);
+            dummy.iterations = iterationCost();
+            dummy.key = QByteArray(32, '\0');
+            matches(dummy, password);
+            return Status::UnknownEmail;
+        }
+        Hash stored;
+        stored.salt = query.value(0).toByteArray();
+        stored.iterations = query.value(1).toInt();
+        stored.key = query.value(2).toByteArray();
+        if (!matches(stored, password)) {
+            return Status::WrongPassword;
+        }
+        if (stored.iterations < cost.load()) {
+            storeHash(email, hashPassword(password), false);  // Hashed on a slower machine or older config
+        }
+        return Status::Ok;
+    });
+}
+
+void AuthDatabaseManager::setPassword(const QString& email, const QString& password,
+                                      QObject* context, Callback done) {
+    run(context, done, [this, email, password]() {
+        return storeHash(email, hashPassword(password), false);
+    });
+}
+
+bool AuthDatabaseManager::insertUsers(const QVector<NewUser>& users, QVector<bool>& added) {
+    added.fill(false, users.size());
+    if (!prepare()) {
+        return false;
+    }
+
+    // Existing accounts are found first so their passwords are never hashed
+    QVector<bool> wanted(users.size(), true);
+    QSqlQuery exists(DbConnector::database());
+    exists.prepare("SELECT 1 FROM credentials WHERE email = ?");
+    for (int i = 0; i < users.size(); ++i) {
+        exists.addBindValue(users[i].email);
+        if (!exists.exec()) {
+            qDebug() << "Error looking up credentials:" << exists.lastError().text();
+            return false;
+        }
+        wanted[i] = !exists.next();
+    }
+
+    iterationCost();  // Calibrated once here rather than raced for by every thread
+    QVector<Hash> hashes(users.size());
+    Hash* out = hashes.data();
+    parallelFor(int(users.size()), 1, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            if (wanted[i]) {
+                out[i] = hashPassword(users[i].password);
+            }
+        }
+    });
+
+    QSqlQuery insert(DbConnector::database());
+    insert.prepare("INSERT OR IGNORE INTO credentials (email, salt, iterations, hash) VALUES (?, ?, ?, ?)");
+    for (int i = 0; i < users.size(); ++i) {
+        if (!wanted[i]) {
+            continue;
+        }
+        insert.addBindValue(users[i].email);
+        insert.addBindValue(hashes[i].salt);
+        insert.addBindValue(hashes[i].iterations);
+        insert.addBindValue(hashes[i].key);
+        if (!insert.exec()) {
+            qDebug() << "Error storing credentials:" << insert.lastError().text();
+            return false;
+        }
+        added[i] = insert.numRowsAffected() == 1;  // 0 when registered since the lookup
+    }
+    return true;
+}
+
+void AuthDatabaseManager::issueRememberToken(const QString& email, QObject* context,
+                                             std::function<void(const QString& token)> done) {
+    const QPointer<QObject> guard(context);
+    workers.start([this, email, guard, done]() {
+        deliver(guard, done, prepare() ? insertRememberToken(email) : QString());
+    });
+}
+
+void AuthDatabaseManager::redeemRememberToken(const QString& token, QObject* context,
+                                              std::function<void(const Resumed& resumed)> done) {
+    const QPointer<QObject> guard(context);
+    workers.start([this, token, guard, done]() {
+        Resumed resumed;
+        const QStringList parts = token.split(':');
+        if (parts.size() != 2 || !prepare()) {
+            deliver(guard, done, resumed);
+            return;
+        }
+
+        QSqlQuery query(DbConnector::database());
+        query.prepare("SELECT email, validator_hash, expires_at FROM remember_tokens WHERE selector = ?");
+        query.addBindValue(parts[0]);
+        if (!query.exec() || !query.next()) {
+            deliver(guard, done, resumed);  // Revoked, expired and swept, or never issued
+            return;
+        }
+        const QString email = query.value(0).toString();
+        const QByteArray storedHash = query.value(1).toByteArray();
+        const qint64 expiresAt = query.value(2).toLongLong();
+        const QByteArray validator = QByteArray::fromBase64(parts[1].toLatin1(), QByteArray::Base64UrlEncoding);
+
+        QSqlQuery remove(DbConnector::database());
+        if (!constantTimeEquals(sha256(validator), storedHash)) {
+            qDebug() << "Remember me token replayed for" << email << "- revoking all of them";
+            remove.prepare("DELETE FROM remember_tokens WHERE email = ?");
+            remove.addBindValue(email);
+            remove.exec();
+            deliver(guard, done, resumed);
+            return;
+        }
+
+        // Single use: this one is spent whether or not it was still valid
+        remove.prepare("DELETE FROM remember_tokens WHERE selector = ?");
+        remove.addBindValue(parts[0]);
+        remove.exec();
+        if (expiresAt > QDateTime::currentSecsSinceEpoch()) {
+            resumed.token = insertRememberToken(email);
+            resumed.email = resumed.token.isEmpty() ? QString() : email;
+        }
+        deliver(guard, done, resumed);
+    });
+}
+
+void AuthDatabaseManager::revokeRememberTokens(const QString& email) {
+    workers.start([this, email]() {
+        if (!prepare()) {
+            return;
+        }
+        QSqlQuery query(DbConnector::database());
+        query.prepare("DELETE FROM remember_tokens WHERE email = ?");
+        query.addBindValue(email);
+        if (!query.exec()) {
+            qDebug() << "Error revoking remember me tokens:" << query.lastError().text();
+        }
+    });
+}
+
+// Stores a new token for the user and returns it as selector:validator
+QString AuthDatabaseManager::insertRememberToken(const QString& email) {
+    const QByteArray selector = randomBytes(SELECTOR_BYTES).toBase64(QByteArray::Base64UrlEncoding);
+    const QByteArray validator = randomBytes(VALIDATOR_BYTES);
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+    QSqlQuery query(DbConnector::database());
+    query.prepare("DELETE FROM remember_tokens WHERE expires_at <= ?");  // Sweeps abandoned ones
+    query.addBindValue(now);
+    query.exec();
+
+    query.prepare("INSERT INTO remember_tokens (selector, validator_hash, email, expires_at) VALUES (?, ?, ?, ?)");
+    query.addBindValue(QString::fromLatin1(selector));
+    query.addBindValue(sha256(validator));
+    query.addBindValue(email);
+    query.addBindValue(now + qint64(Config::REMEMBER_ME_DAYS) * 24 * 3600);
+    if (!query.exec()) {
+        qDebug() << "Error storing remember me token:" << query.lastError().text();
+        return QString();
+    }
+    return QString::fromLatin1(selector) + ':'
+         + QString::fromLatin1(validator.toBase64(QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals));
+}
+
+AuthDatabaseManager::Hash AuthDatabaseManager::hashPassword(const QString& password) {
+    Hash hash;
+    hash.salt = randomBytes(SALT_BYTES);
+    hash.iterations = iterationCost();
+    hash.key = pbkdf2Sha256(password.toUtf8(), hash.salt, hash.iterations);
+    return hash;
+}
+
+bool AuthDatabaseManager::matches(const Hash& stored, const QString& password) {
+    if (stored.iterations <= 0) {
+        return false;
+    }
+    const QByteArray key = pbkdf2Sha256(password.toUtf8(), stored.salt, stored.iterations, stored.key.size());
+    return constantTimeEquals(key, stored.key);
+}
+
+AuthDatabaseManager::Status AuthDatabaseManager::storeHash(const QString& email, const Hash& hash, bool insert) {
+    QSqlQuery query(DbConnector::database());
+    if (insert) {
+        // An existing email is ignored rather than failing, so any error left is a real one
+        query.prepare("INSERT OR IGNORE INTO credentials (salt, iterations, hash, email) VALUES (?, ?, ?, ?)");
+    } else {
+        query.prepare("UPDATE credentials SET salt = ?, iterations = ?, hash = ? WHERE email = ?");
+    }
+    query.addBindValue(hash.salt);
+    query.addBindValue(hash.iterations);
+    query.addBindValue(hash.key);
+    query.addBindValue(email);
+    if (!query.exec()) {
+        qDebug() << "Error storing credentials:" << query.lastError().text();
+        return Status::DatabaseError;
+    }
+    if (query.numRowsAffected() == 1) {
+        return Status::Ok;
+    }
+    return insert ? Status::EmailTaken : Status::UnknownEmail;
+}
+
+// PBKDF2 (RFC 8018) with HMAC-SHA256 as the pseudorandom function
+QByteArray AuthDatabaseManager::pbkdf2Sha256(const QByteArray& password, const QByteArray& salt,
+                                             int iterations, int length) {
+    QMessageAuthenticationCode mac(QCryptographicHash::Sha256, password);
+    QByteArray key;
+    for (quint32 block = 1; key.size() < length; ++block) {
+        QByteArray u = salt;
+        u.append(char(block >> 24)).append(char(block >> 16)).append(char(block >> 8)).append(char(block));
+        mac.addData(u);
+        u = mac.result();
+        QByteArray t = u;
+        for (int i = 1; i < iterations; ++i) {
+            mac.reset();  // Keeps the key, only the message starts over
+            mac.addData(u);
+            u = mac.result();
+            char* out = t.data();
+            const char* in = u.constData();
+            for (int j = 0; j < t.size(); ++j) {
+                out[j] ^= in[j];
+            }
+        }
+        mac.reset();
+        key += t;
+    }
+    return key.left(length);
+}
+
+int AuthDatabaseManager::calibrateIterations(int targetMs) {
+    // Time a short run that is long enough to measure, then scale it
+    const QByteArray password = "calibration";
+    const QByteArray salt(SALT_BYTES, 's');
+    int probe = 1000;
+    qint64 elapsedNs = 0;
+    while (true) {
+        QElapsedTimer timer;
+        timer.start();
+        pbkdf2Sha256(password, salt, probe);
+        elapsedNs = timer.nsecsElapsed();
+        if (elapsedNs >= 20 * 1000000LL || probe >= Config::PASSWORD_HASH_MIN_ITERATIONS) {
+            break;
+        }
+        probe *= 4;
+    }
+    const double perIterationNs = double(elapsedNs) / probe;
+    const double iterations = targetMs * 1e6 / qMax(perIterationNs, 1.0);
+    return int(qBound(double(Config::PASSWORD_HASH_MIN_ITERATIONS), iterations, double(INT_MAX / 2)));
+}
@@ -1,7 +1,27 @@
 #include "../include/auth/email_validator.h"
-#include <QtCore/QRegularExpression>
-// This header allows you to allows you to define
-// patterns to search for in strings.
+#include "../include/utils/parallel.h"
+#include <array>
+
+
+namespace {
+
+// Characters the old pattern allowed before the @: [A-Za-z0-9._%+-]
+constexpr std::array<bool, 128> makeLocalChars() {
+   std::array<bool, 128> allowed{};
+   for (int c = 'A'; c <= 'Z'; ++c) allowed[c] = true;
+   for (int c = 'a'; c <= 'z'; ++c) allowed[c] = true;
+   for (int c = '0'; c <= '9'; ++c) allowed[c] = true;
+   for (char c : {'.', '_', '%', '+', '-'}) allowed[c] = true;
+   return allowed;
+}
+
+constexpr std::array<bool, 128> LOCAL_CHARS = makeLocalChars();
+
+// Only allowed domain to log in
+constexpr char DOMAIN[] = "@stu.bmcc.cuny.edu";
+constexpr int DOMAIN_LENGTH = int(sizeof(DOMAIN)) - 1;
+
+}
 
 
 // Define functions from email validator class
@@ -12,20 +32,43 @@ EmailValidator::EmailValidator() {}
 
 
 // Define email validator
-bool EmailValidator::isValidEmail(const QString &email) const {
-   // Using a typical email check format to compare email to regex
-   QRegularExpression emailRegex("^[A-Za-z0-9._%+-]+@[A-Za-z0-9.-]+\\.[A-Za-z]{2,}$");
-   if (!emailRegex.match(email).hasMatch()) {
+// The old regex plus domain check accepted exactly this: one or more
+// [A-Za-z0-9._%+-] and then the BMCC domain, which itself passes the
+// regex's domain part. Nothing else may follow, not even a newline.
+bool EmailValidator::isValidEmail(QStringView email) const {
+   const int localLength = int(email.size()) - DOMAIN_LENGTH;
+   if (localLength < 1) {
        return false;
    }
-   // .match(email)   Matches the inputed email to the regex
-   // .hasMatch()   Return whether the email matches the pattern
+
+   // Local part, every character must be in the table
+   for (int i = 0; i < localLength; ++i) {
+       const char16_t c = email[i].unicode();
+       if (c >= 128 || !LOCAL_CHARS[c]) {
+           return false;
+       }
+   }
+
+   // Check for domain match (stu.bmcc.cuny.edu), case sensitive as before
+   for (int i = 0; i < DOMAIN_LENGTH; ++i) {
+       if (email[localLength + i].unicode() != char16_t(DOMAIN[i])) {
+           return false;
+       }
+   }
+   return true;
+}
 
 
-   // Check for domain match (stu.bmcc.cuny.edu)
-   QString domain = extractDomain(email);  // Takes email domain from inputted email
-   return domain == ALLOWED_DOMAIN;
-   // Checks if domain is == to private ALLOWED_DOMAIN
+// Validates a batch of emails across the thread pool
+QVector<bool> EmailValidator::validateAll(const QStringList &emails) const {
+   QVector<bool> valid(emails.size());
+   bool *out = valid.data();
+   parallelFor(int(emails.size()), 4096, [&](int begin, int end) {
+       for (int i = begin; i < end; ++i) {
+           out[i] = isValidEmail(emails[i]);
+       }
+   });
+   return valid;
 }
 
 
@@ -0,0 +1,55 @@
+#include "auth/login_throttle.h"
+#include "utils/config.h"
+#include <QHash>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <utility>
+
+static_assert((Config::LOGIN_THROTTLE_SLOTS & (Config::LOGIN_THROTTLE_SLOTS - 1)) == 0,
+              "LOGIN_THROTTLE_SLOTS must be a power of two");
+
+LoginThrottle::LoginThrottle(Clock clock)
+    : clock(std::move(clock))
+    // A per-run seed, so nobody can pick emails that share a victim's bucket
+    , seed(QRandomGenerator::system()->generate())
+    , accounts(new std::atomic<qint64>[Config::LOGIN_THROTTLE_SLOTS]())
+{
+    monotonic.start();
+}
+
+LoginThrottle::Verdict LoginThrottle::tryAcquire(const QString& email) {
+    const qint64 now = nowMs() * 1000;
+    // The account first, so hammering one email never drains the global bucket
+    std::atomic<qint64>& account = accounts[qHash(email, seed) & (Config::LOGIN_THROTTLE_SLOTS - 1)];
+    if (!take(account, now, Config::LOGIN_ACCOUNT_BURST, Config::LOGIN_ACCOUNT_PER_MINUTE)) {
+        accountLimitedCount.fetch_add(1, std::memory_order_relaxed);
+        return Verdict::AccountLimited;
+    }
+    if (!take(global, now, Config::LOGIN_GLOBAL_BURST, Config::LOGIN_GLOBAL_PER_MINUTE)) {
+        globalLimitedCount.fetch_add(1, std::memory_order_relaxed);
+        return Verdict::GlobalLimited;
+    }
+    allowedCount.fetch_add(1, std::memory_order_relaxed);
+    return Verdict::Allowed;
+}
+
+// Takes one token if the bucket will be full again less than a burst from
+// now. A refused attempt leaves the bucket untouched, so it costs one load.
+bool LoginThrottle::take(std::atomic<qint64>& fullAtUs, qint64 nowUs, int burst, int perMinute) {
+    const qint64 intervalUs = 60 * qint64(1000000) / perMinute;  // Refill time of one token
+    const qint64 limitUs = qint64(burst - 1) * intervalUs;
+    qint64 fullAt = fullAtUs.load(std::memory_order_relaxed);
+    for (;;) {
+        const qint64 start = std::max(fullAt, nowUs);
+        if (start - nowUs > limitUs) {
+            return false;
+        }
+        if (fullAtUs.compare_exchange_weak(fullAt, start + intervalUs, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+qint64 LoginThrottle::nowMs() const {
+    return clock ? clock() : monotonic.elapsed();
+}
@@ -0,0 +1,74 @@
+#include "auth/password_validator.h"
+#include "utils/parallel.h"
+#include <array>
+
+namespace {
+
+enum : quint8 { UPPER = 1, DIGIT = 2 };
+
+// Class bits of each ASCII character; the old regexes were [A-Z] and [0-9]
+constexpr std::array<quint8, 128> makeClasses() {
+    std::array<quint8, 128> classes{};
+    for (int c = 'A'; c <= 'Z'; ++c) {
+        classes[c] |= UPPER;
+    }
+    for (int c = '0'; c <= '9'; ++c) {
+        classes[c] |= DIGIT;
+    }
+    return classes;
+}
+
+constexpr std::array<quint8, 128> CLASSES = makeClasses();
+
+}
+
+PasswordValidator::Problem PasswordValidator::check(QStringView password) {
+    if (password.size() < MIN_LENGTH) {
+        return Problem::TooShort;
+    }
+    if (password.size() > MAX_LENGTH) {
+        return Problem::TooLong;
+    }
+
+    quint8 seen = 0;
+    for (QChar c : password) {
+        const char16_t code = c.unicode();
+        if (code < 128) {
+            seen |= CLASSES[code];
+        }
+    }
+    if (!(seen & UPPER)) {
+        return Problem::NoUppercase;
+    }
+    if (!(seen & DIGIT)) {
+        return Problem::NoDigit;
+    }
+    return Problem::None;
+}
+
+QString PasswordValidator::message(Problem problem) {
+    switch (problem) {
+    case Problem::None:
+        return QString();
+    case Problem::TooShort:
+        return QString("Password must be at least %1 characters long").arg(MIN_LENGTH);
+    case Problem::TooLong:
+        return QString("Password must not exceed %1 characters").arg(MAX_LENGTH);
+    case Problem::NoUppercase:
+        return "Password must contain at least one uppercase letter";
+    case Problem::NoDigit:
+        return "Password must contain at least one number";
+    }
+    return QString();
+}
+
+QVector<PasswordValidator::Problem> PasswordValidator::checkAll(const QStringList& passwords) {
+    QVector<Problem> problems(passwords.size());
+    Problem* out = problems.data();
+    parallelFor(int(passwords.size()), 4096, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            out[i] = check(passwords[i]);
+        }
+    });
+    return problems;
+}
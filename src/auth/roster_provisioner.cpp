@@ -0,0 +1,216 @@
+#include "auth/roster_provisioner.h"
+#include "auth/database_manager.h"
+#include "auth/email_validator.h"
+#include "auth/password_validator.h"
+#include "database/database_manager.h"
+#include "database/db_connector.h"
+#include "utils/config.h"
+#include <QIODevice>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QDebug>
+#include <utility>
+
+RosterProvisioner::RosterProvisioner(AuthDatabaseManager* credentials, DatabaseManager* db)
+    : credentials(credentials)
+    , dbManager(db)
+{}
+
+RosterProvisioner::Report RosterProvisioner::run(QIODevice* roster, QTextStream* passwords) {
+    QElapsedTimer timer;
+    timer.start();
+    Report report;
+    seen.clear();
+
+    QTextStream in(roster);
+    QVector<Row> batch;
+    batch.reserve(Config::PROVISION_BATCH_ROWS);
+    int line = 0;
+    while (!in.atEnd()) {
+        const QString text = in.readLine();
+        ++line;
+        if (text.trimmed().isEmpty()) {
+            continue;
+        }
+        const QStringList fields = splitCsvLine(text);
+        if (line == 1 && fields.first().compare("email", Qt::CaseInsensitive) == 0) {
+            continue;  // Header
+        }
+
+        ++report.rows;
+        if (fields.size() < 3 || fields.size() > 4) {
+            report.rejected.append({line, fields.first(), "Expected email,major,semester_level[,initial_password]"});
+            continue;
+        }
+        Row row{line, fields[0], fields[1], fields[2], fields.value(3), false};
+        if (row.major.isEmpty() || row.semesterLevel.isEmpty()) {
+            report.rejected.append({line, row.email, "Missing major or semester level"});
+            continue;
+        }
+        if (row.password.isEmpty()) {
+            if (!passwords) {
+                report.rejected.append({line, row.email, "No initial password and nowhere to write one"});
+                continue;
+            }
+            row.password = generatePassword();
+            row.generated = true;
+        }
+
+        batch.append(row);
+        if (batch.size() == Config::PROVISION_BATCH_ROWS) {
+            provisionBatch(batch, passwords, report);
+            batch.clear();
+        }
+    }
+    if (!batch.isEmpty()) {
+        provisionBatch(batch, passwords, report);
+    }
+
+    report.seconds = timer.nsecsElapsed() / 1e9;
+    return report;
+}
+
+void RosterProvisioner::provisionBatch(const QVector<Row>& batch, QTextStream* passwords, Report& report) {
+    QElapsedTimer timer;
+    timer.start();
+    const int rejectedBefore = report.rejected.size();
+
+    QStringList emails;
+    QStringList initialPasswords;
+    for (const Row& row : std::as_const(batch)) {
+        emails.append(row.email);
+        initialPasswords.append(row.password);
+    }
+    const QVector<bool> validEmails = EmailValidator().validateAll(emails);
+    const QVector<PasswordValidator::Problem> problems = PasswordValidator::checkAll(initialPasswords);
+
+    QVector<const Row*> accepted;
+    QVector<AuthDatabaseManager::NewUser> users;
+    QSet<QString> inBatch;  // Joins seen only once the batch has committed
+    for (int i = 0; i < batch.size(); ++i) {
+        const Row& row = batch[i];
+        if (!validEmails[i]) {
+            report.rejected.append({row.line, row.email, "Invalid email. Must be a @stu.bmcc.cuny.edu address"});
+        } else if (problems[i] != PasswordValidator::Problem::None) {
+            report.rejected.append({row.line, row.email, PasswordValidator::message(problems[i])});
+        } else if (seen.contains(row.email) || inBatch.contains(row.email)) {
+            report.rejected.append({row.line, row.email, "Listed earlier in the roster"});
+        } else {
+            inBatch.insert(row.email);
+            accepted.append(&row);
+            users.append({row.email, row.password});
+        }
+    }
+
+    // Credentials and profiles of the batch land together or not at all
+    auto rejectAccepted = [&](const QString& reason) {
+        for (const Row* row : std::as_const(accepted)) {
+            report.rejected.append({row->line, row->email, reason});
+        }
+        ++report.batches;
+    };
+    QSqlDatabase db = DbConnector::database();
+    if (!db.transaction()) {
+        qDebug() << "Could not start batch transaction:" << db.lastError().text();
+        rejectAccepted("Database error, batch skipped");
+        return;
+    }
+    QVector<bool> added;
+    if (!credentials->insertUsers(users, added)) {
+        db.rollback();
+        rejectAccepted("Database error, batch rolled back");
+        return;
+    }
+    QStringList createdEmails;
+    QStringList majors;
+    QStringList semesterLevels;
+    for (int i = 0; i < accepted.size(); ++i) {
+        if (!added[i]) {
+            report.rejected.append({accepted[i]->line, accepted[i]->email, "Email already registered"});
+            continue;
+        }
+        createdEmails.append(accepted[i]->email);
+        majors.append(accepted[i]->major);
+        semesterLevels.append(accepted[i]->semesterLevel);
+    }
+    if (!dbManager->updateStudentProfiles(createdEmails, majors, semesterLevels) || !db.commit()) {
+        qDebug() << "Batch rolled back:" << db.lastError().text();
+        db.rollback();
+        for (int i = 0; i < accepted.size(); ++i) {
+            if (added[i]) {
+                report.rejected.append({accepted[i]->line, accepted[i]->email, "Database error, batch rolled back"});
+            }
+        }
+        ++report.batches;
+        return;
+    }
+    seen.unite(inBatch);
+
+    if (passwords) {
+        for (int i = 0; i < accepted.size(); ++i) {
+            if (added[i] && accepted[i]->generated) {
+                *passwords << accepted[i]->email << ',' << accepted[i]->password << '\n';
+            }
+        }
+        passwords->flush();
+    }
+
+    report.created += createdEmails.size();
+    ++report.batches;
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    qInfo().noquote() << QString("Batch %1: %2 created, %3 rejected, %4 rows/s")
+        .arg(report.batches).arg(createdEmails.size()).arg(report.rejected.size() - rejectedBefore)
+        .arg(seconds > 0 ? batch.size() / seconds : 0.0, 0, 'f', 0);
+}
+
+// Splits one CSV line, allowing "quoted, fields" with "" for a quote
+QStringList RosterProvisioner::splitCsvLine(const QString& line) {
+    QStringList fields;
+    QString field;
+    bool quoted = false;
+    for (int i = 0; i < line.size(); ++i) {
+        const QChar c = line[i];
+        if (quoted) {
+            if (c != '"') {
+                field += c;
+            } else if (i + 1 < line.size() && line[i + 1] == '"') {
+                field += c;
+                ++i;
+            } else {
+                quoted = false;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.append(field.trimmed());
+            field.clear();
+        } else {
+            field += c;
+        }
+    }
+    fields.append(field.trimmed());
+    return fields;
+}
+
+// Twelve characters that pass the password rules, without look-alikes like O and 0
+QString RosterProvisioner::generatePassword() {
+    static const QString upper = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+    static const QString digits = "23456789";
+    static const QString any = upper + digits + "abcdefghijkmnpqrstuvwxyz";
+    QRandomGenerator* random = QRandomGenerator::system();
+
+    QString password;
+    password += upper[random->bounded(int(upper.size()))];
+    password += digits[random->bounded(int(digits.size()))];
+    while (password.size() < 12) {
+        password += any[random->bounded(int(any.size()))];
+    }
+    // Move the guaranteed characters away from the front
+    for (int i = password.size() - 1; i > 0; --i) {
+        std::swap(password[i], password[random->bounded(i + 1)]);
+    }
+    return password;
+}
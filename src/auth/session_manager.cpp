@@ -0,0 +1,182 @@
+#include "auth/session_manager.h"
+
+SessionManager::SessionManager(qint64 lifetimeSecs, Clock clock)
+    : lifetimeMs(lifetimeSecs * 1000)
+    , clock(std::move(clock))
+{
+    monotonic.start();
+    buckets.fill(NONE);
+    currentTick = nowMs() / 1000;
+}
+
+qint64 SessionManager::nowMs() const {
+    return clock ? clock() : monotonic.elapsed();
+}
+
+QUuid SessionManager::create(const QString& userId) {
+    advance();
+    removeUser(userId);
+
+    qint32 index = freeList;
+    if (index != NONE) {
+        freeList = sessions[index].next;
+    } else {
+        index = sessions.size();
+        sessions.append(Session());
+    }
+
+    Session& session = sessions[index];
+    session.token = QUuid::createUuid();
+    session.userId = userId;
+    session.expiresMs = nowMs() + lifetimeMs;
+    session.prev = session.next = NONE;
+    byToken.insert(session.token, index);
+    byUser.insert(userId, index);
+    schedule(index);
+    return session.token;
+}
+
+bool SessionManager::isValid(const QUuid& token) const {
+    auto found = byToken.constFind(token);
+    return found != byToken.constEnd() && sessions[*found].expiresMs > nowMs();
+}
+
+QUuid SessionManager::tokenFor(const QString& userId) const {
+    auto found = byUser.constFind(userId);
+    return found == byUser.constEnd() ? QUuid() : sessions[*found].token;
+}
+
+bool SessionManager::refresh(const QUuid& token) {
+    advance();
+    auto found = byToken.constFind(token);
+    if (found == byToken.constEnd() || sessions[*found].expiresMs <= nowMs()) {
+        return false;  // Gone, or expired and waiting for its tick
+    }
+    const qint32 index = *found;
+    unlink(index);
+    sessions[index].expiresMs = nowMs() + lifetimeMs;
+    schedule(index);
+    return true;
+}
+
+void SessionManager::remove(const QUuid& token) {
+    advance();
+    auto found = byToken.constFind(token);
+    if (found != byToken.constEnd()) {
+        release(*found);
+    }
+}
+
+void SessionManager::removeUser(const QString& userId) {
+    auto found = byUser.constFind(userId);
+    if (found != byUser.constEnd()) {
+        release(*found);
+    }
+}
+
+void SessionManager::advance() {
+    const qint64 targetTick = nowMs() / 1000;
+    if (byToken.isEmpty()) {
+        currentTick = qMax(currentTick, targetTick);  // Every slot is empty, nothing to run
+        return;
+    }
+
+    while (currentTick < targetTick) {
+        ++currentTick;
+        const int index = int(currentTick & (SLOTS - 1));
+        if (index == 0) {
+            // Level 0 wrapped, bring down the next slot of each level that wrapped with it
+            for (int level = 1; level < LEVELS; ++level) {
+                cascade(level);
+                if (((currentTick >> (SLOT_BITS * level)) & (SLOTS - 1)) != 0) {
+                    break;
+                }
+            }
+        }
+
+        qint32 entry = buckets[index];
+        buckets[index] = NONE;
+        while (entry != NONE) {
+            Session& session = sessions[entry];
+            const qint32 next = session.next;
+            session.bucket = NONE;
+            session.prev = session.next = NONE;
+            if (session.expiresMs <= currentTick * 1000) {
+                release(entry);
+                ++evicted;
+            } else {
+                schedule(entry);  // Clamped into the top level when it was added
+            }
+            entry = next;
+        }
+    }
+}
+
+void SessionManager::cascade(int level) {
+    const int slot = int((currentTick >> (SLOT_BITS * level)) & (SLOTS - 1));
+    const int bucket = level * SLOTS + slot;
+    qint32 entry = buckets[bucket];
+    buckets[bucket] = NONE;
+    while (entry != NONE) {
+        Session& session = sessions[entry];
+        const qint32 next = session.next;
+        session.bucket = NONE;
+        session.prev = session.next = NONE;
+        schedule(entry);  // Now due within this level's span, so it lands lower
+        entry = next;
+    }
+}
+
+void SessionManager::schedule(qint32 index) {
+    Session& session = sessions[index];
+    // Rounded up, so a session is never reclaimed before it expires
+    qint64 expireTick = qMax(currentTick, (session.expiresMs + 999) / 1000);
+    const qint64 span = qint64(1) << (SLOT_BITS * LEVELS);
+    if (expireTick - currentTick >= span) {
+        expireTick = currentTick + span - 1;  // Rescheduled from level 0 when it gets there
+    }
+
+    const qint64 delta = expireTick - currentTick;
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (qint64(1) << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    const int bucket = level * SLOTS + int((expireTick >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+    session.bucket = qint16(bucket);
+    session.prev = NONE;
+    session.next = buckets[bucket];
+    if (session.next != NONE) {
+        sessions[session.next].prev = index;
+    }
+    buckets[bucket] = index;
+}
+
+void SessionManager::unlink(qint32 index) {
+    Session& session = sessions[index];
+    if (session.bucket == NONE) {
+        return;
+    }
+    if (session.prev != NONE) {
+        sessions[session.prev].next = session.next;
+    } else {
+        buckets[session.bucket] = session.next;
+    }
+    if (session.next != NONE) {
+        sessions[session.next].prev = session.prev;
+    }
+    session.bucket = NONE;
+    session.prev = session.next = NONE;
+}
+
+void SessionManager::release(qint32 index) {
+    unlink(index);
+    Session& session = sessions[index];
+    byToken.remove(session.token);
+    byUser.remove(session.userId);
+    session.token = QUuid();
+    session.userId.clear();
+    session.expiresMs = 0;
+    session.next = freeList;
+    freeList = index;
+}
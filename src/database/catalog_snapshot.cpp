@@ -0,0 +1,393 @@
+#include "database/catalog_snapshot.h"
+#include <QtAlgorithms>
+#include <algorithm>
+#include <iterator>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Runs a predicate over the rows and ANDs the result into the selection.
+// block16 answers sixteen rows at once as a 16-bit mask when SIMD is
+// available; single answers one row and covers the tail of each word.
+template <typename Block16, typename Single>
+void scan(int rows, quint64* selection, Block16 block16, Single single) {
+    for (int base = 0; base < rows; base += 64) {
+        const int n = std::min(64, rows - base);
+        quint64 bits = 0;
+        int i = 0;
+#if defined(__SSE2__)
+        for (; i + 16 <= n; i += 16) {
+            bits |= quint64(block16(base + i)) << i;
+        }
+#else
+        Q_UNUSED(block16);
+#endif
+        for (; i < n; ++i) {
+            bits |= quint64(single(base + i) ? 1 : 0) << i;
+        }
+        selection[base / 64] &= bits;
+    }
+}
+
+#if defined(__SSE2__)
+// Packs four 4-lane comparison results into one bit per row
+inline int movemask16(__m128i a, __m128i b, __m128i c, __m128i d) {
+    const __m128i ab = _mm_packs_epi32(a, b);
+    const __m128i cd = _mm_packs_epi32(c, d);
+    return _mm_movemask_epi8(_mm_packs_epi16(ab, cd));
+}
+
+inline __m128i load(const quint32* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+#endif
+
+void selectEquals(const QVector<quint32>& column, quint32 id, quint64* selection) {
+    const quint32* values = column.constData();
+#if defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi32(int(id));
+    auto block16 = [values, needle](int row) {
+        return movemask16(_mm_cmpeq_epi32(load(values + row), needle),
+                          _mm_cmpeq_epi32(load(values + row + 4), needle),
+                          _mm_cmpeq_epi32(load(values + row + 8), needle),
+                          _mm_cmpeq_epi32(load(values + row + 12), needle));
+    };
+#else
+    auto block16 = [](int) { return 0; };
+#endif
+    scan(column.size(), selection, block16, [values, id](int row) { return values[row] == id; });
+}
+
+void selectRange(const QVector<qint32>& column, qint32 low, qint32 high, quint64* selection) {
+    const qint32* values = column.constData();
+#if defined(__SSE2__)
+    const __m128i lo = _mm_set1_epi32(low);
+    const __m128i hi = _mm_set1_epi32(high);
+    auto inside = [lo, hi](const qint32* p) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i outside = _mm_or_si128(_mm_cmplt_epi32(v, lo), _mm_cmpgt_epi32(v, hi));
+        return _mm_cmpeq_epi32(outside, _mm_setzero_si128());
+    };
+    auto block16 = [values, inside](int row) {
+        return movemask16(inside(values + row), inside(values + row + 4),
+                          inside(values + row + 8), inside(values + row + 12));
+    };
+#else
+    auto block16 = [](int) { return 0; };
+#endif
+    scan(column.size(), selection, block16,
+         [values, low, high](int row) { return values[row] >= low && values[row] <= high; });
+}
+
+// Upper bound of each price bucket in cents, the last one is open ended
+constexpr int PRICE_BUCKET_LIMITS[] = {2499, 4999, 9999, 19999, INT_MAX};
+
+// Sorts rows appended since the order was last extended and merges them in
+template <typename Less>
+void extendOrder(QVector<quint32>& order, int rowCount, Less less) {
+    const int sorted = order.size();
+    if (sorted == rowCount) {
+        return;
+    }
+    order.reserve(rowCount);
+    for (int row = sorted; row < rowCount; ++row) {
+        order.append(quint32(row));
+    }
+    std::sort(order.begin() + sorted, order.end(), less);
+    std::inplace_merge(order.begin(), order.begin() + sorted, order.end(), less);
+}
+
+int priceBucketOf(int cents) {
+    int bucket = 0;
+    while (cents > PRICE_BUCKET_LIMITS[bucket]) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+}
+
+int CatalogSnapshot::priceBucketCount() {
+    return int(std::size(PRICE_BUCKET_LIMITS));
+}
+
+QString CatalogSnapshot::priceBucketLabel(int bucket) {
+    const QPair<int, int> range = priceBucketRange(bucket);
+    if (bucket == 0) {
+        return QString("Under $%1").arg((range.second + 1) / 100);
+    }
+    if (bucket == priceBucketCount() - 1) {
+        return QString("$%1 and up").arg(range.first / 100);
+    }
+    return QString("$%1 - $%2").arg(range.first / 100).arg((range.second + 1) / 100);
+}
+
+QPair<int, int> CatalogSnapshot::priceBucketRange(int bucket) {
+    const int low = bucket == 0 ? 0 : PRICE_BUCKET_LIMITS[bucket - 1] + 1;
+    return qMakePair(low, PRICE_BUCKET_LIMITS[bucket]);
+}
+
+quint32 CatalogSnapshot::Dictionary::intern(const QString& value) {
+    auto it = ids.constFind(value);
+    if (it != ids.constEnd()) {
+        return *it;
+    }
+    const quint32 id = values.size();
+    values.append(value);
+    ids.insert(value, id);
+    return id;
+}
+
+CatalogSnapshot::CatalogSnapshot() : rowCount(0) {
+    priceRows.resize(priceBucketCount());
+}
+
+void CatalogSnapshot::clear() {
+    *this = CatalogSnapshot();
+}
+
+void CatalogSnapshot::reserve(int rows) {
+    for (QVector<quint32>* column : {&departmentIds, &lecIds, &categoryIds, &codeIds}) {
+        column->reserve(rows);
+    }
+    priceCents.reserve(rows);
+    for (QVector<QString>* column : {&productIds, &titles, &authors, &imagePaths}) {
+        column->reserve(rows);
+    }
+}
+
+void CatalogSnapshot::append(const Textbook& book) {
+    const quint32 row = rowCount;
+    auto addToFacet = [row](QVector<CompressedBitmap>& facet, quint32 id) {
+        if (facet.size() <= int(id)) {
+            facet.resize(id + 1);
+        }
+        facet[id].add(row);
+    };
+
+    departmentIds.append(departments.intern(book.department));
+    lecIds.append(lecs.intern(book.lec));
+    categoryIds.append(categories.intern(book.courseCategory));
+    codeIds.append(codes.intern(book.courseCode));
+    priceCents.append(qRound(book.price * 100));
+    addToFacet(departmentRows, departmentIds.last());
+    addToFacet(categoryRows, categoryIds.last());
+    addToFacet(codeRows, codeIds.last());
+    priceRows[priceBucketOf(priceCents.last())].add(row);
+    productIds.append(book.productId);
+    titles.append(book.title);
+    authors.append(book.author);
+    imagePaths.append(book.imagePath);
+    ++rowCount;
+}
+
+Textbook CatalogSnapshot::book(int row) const {
+    return Textbook(
+        departments.values[departmentIds[row]],
+        lecs.values[lecIds[row]],
+        categories.values[categoryIds[row]],
+        codes.values[codeIds[row]],
+        titles[row],
+        authors[row],
+        productIds[row],
+        priceCents[row] / 100.0,
+        imagePaths[row]
+    );
+}
+
+CatalogSnapshot::Selection CatalogSnapshot::select(const Filter& filter) const {
+    Selection selection((rowCount + 63) / 64, ~quint64(0));
+    if (rowCount % 64) {
+        selection.last() = (quint64(1) << (rowCount % 64)) - 1;  // No rows past the end
+    }
+
+    // An exact filter on a value no row has matches nothing
+    auto equals = [&](const Dictionary& dictionary, const QVector<quint32>& column, const QString& value) {
+        const int id = dictionary.find(value);
+        if (id < 0) {
+            selection.fill(0);
+        } else {
+            selectEquals(column, quint32(id), selection.data());
+        }
+    };
+
+    if (!filter.department.isEmpty()) {
+        equals(departments, departmentIds, filter.department);
+    }
+    if (!filter.lec.isEmpty()) {
+        equals(lecs, lecIds, filter.lec);
+    }
+    if (!filter.category.isEmpty()) {
+        equals(categories, categoryIds, filter.category);
+    }
+    if (!filter.code.isEmpty()) {
+        equals(codes, codeIds, filter.code);
+    }
+    if (filter.minPriceCents > 0 || filter.maxPriceCents < INT_MAX) {
+        selectRange(priceCents, filter.minPriceCents, filter.maxPriceCents, selection.data());
+    }
+    return selection;
+}
+
+bool CatalogSnapshot::matchesText(int row, const QString& text) const {
+    return titles[row].contains(text, Qt::CaseInsensitive)
+        || authors[row].contains(text, Qt::CaseInsensitive)
+        || (categories.values[categoryIds[row]] + ' ' + codes.values[codeIds[row]])
+               .contains(text, Qt::CaseInsensitive);
+}
+
+// Same keys as the SQLite ORDER BY clauses. QString compares UTF-16 units
+// where SQLite compares UTF-8 bytes, which only differs past U+FFFF.
+bool CatalogSnapshot::priceBefore(quint32 a, quint32 b) const {
+    if (priceCents[a] != priceCents[b]) {
+        return priceCents[a] < priceCents[b];
+    }
+    return productIds[a] < productIds[b];
+}
+
+bool CatalogSnapshot::titleBefore(quint32 a, quint32 b) const {
+    const int order = titles[a].compare(titles[b]);
+    if (order != 0) {
+        return order < 0;
+    }
+    return productIds[a] < productIds[b];
+}
+
+void CatalogSnapshot::buildSortOrders() {
+    extendOrder(priceOrder, rowCount, [this](quint32 a, quint32 b) { return priceBefore(a, b); });
+    extendOrder(titleOrder, rowCount, [this](quint32 a, quint32 b) { return titleBefore(a, b); });
+}
+
+QVector<quint32> CatalogSnapshot::sortedRows(CatalogSort sort) const {
+    QVector<quint32> rows = sort == CatalogSort::Title ? titleOrder : priceOrder;
+    if (sort == CatalogSort::Title) {
+        extendOrder(rows, rowCount, [this](quint32 a, quint32 b) { return titleBefore(a, b); });
+    } else {
+        extendOrder(rows, rowCount, [this](quint32 a, quint32 b) { return priceBefore(a, b); });
+    }
+    return rows;
+}
+
+QVector<Textbook> CatalogSnapshot::search(const Filter& filter, int page, int pageSize) const {
+    QVector<Textbook> results;
+    if (pageSize <= 0) {
+        return results;
+    }
+    const Selection selection = select(filter);
+    int skip = std::max(0, (page - 1) * pageSize);
+
+    // Takes one selected row in result order, true once the page is full
+    auto take = [&](int row) {
+        if (!filter.text.isEmpty() && !matchesText(row, filter.text)) {
+            return false;
+        }
+        if (skip > 0) {
+            --skip;
+            return false;
+        }
+        results.append(book(row));
+        return results.size() == pageSize;
+    };
+
+    if (filter.sort == CatalogSort::Newest) {
+        // Newest first is the table read backwards, highest bit of the last word first
+        for (int word = selection.size() - 1; word >= 0; --word) {
+            quint64 bits = selection[word];
+            if (filter.text.isEmpty()) {
+                // Whole words of earlier pages are skipped by their popcount
+                const int count = qPopulationCount(bits);
+                if (count <= skip) {
+                    skip -= count;
+                    continue;
+                }
+            }
+            while (bits) {
+                const int bit = 63 - qCountLeadingZeroBits(bits);
+                bits &= ~(quint64(1) << bit);
+                if (take(word * 64 + bit)) {
+                    return results;
+                }
+            }
+        }
+        return results;
+    }
+
+    const QVector<quint32> order = sortedRows(filter.sort);
+    auto selected = [&selection](quint32 row) { return (selection[row / 64] >> (row % 64)) & 1; };
+    if (filter.sort == CatalogSort::PriceHighToLow) {
+        for (auto row = order.crbegin(); row != order.crend(); ++row) {
+            if (selected(*row) && take(*row)) {
+                return results;
+            }
+        }
+    } else {
+        for (quint32 row : order) {
+            if (selected(row) && take(row)) {
+                return results;
+            }
+        }
+    }
+    return results;
+}
+
+CatalogSnapshot::Selection CatalogSnapshot::selectMatching(const Filter& filter) const {
+    Selection selection = select(filter);
+    if (filter.text.isEmpty()) {
+        return selection;
+    }
+    for (int word = 0; word < selection.size(); ++word) {
+        quint64 bits = selection[word];
+        while (bits) {
+            const int bit = qCountTrailingZeroBits(bits);
+            bits &= bits - 1;
+            if (!matchesText(word * 64 + bit, filter.text)) {
+                selection[word] &= ~(quint64(1) << bit);
+            }
+        }
+    }
+    return selection;
+}
+
+QVector<CatalogSnapshot::FacetCount> CatalogSnapshot::countFacet(
+    const Dictionary& dictionary, const QVector<CompressedBitmap>& rows, const Selection& selection) {
+    QVector<FacetCount> counts;
+    for (int id = 1; id < rows.size(); ++id) {  // Id 0 is the empty value
+        counts.append({dictionary.values[id], rows[id].intersectionCount(selection)});
+    }
+    std::sort(counts.begin(), counts.end(),
+              [](const FacetCount& a, const FacetCount& b) { return a.value < b.value; });
+    return counts;
+}
+
+CatalogSnapshot::Facets CatalogSnapshot::facets(const Filter& filter) const {
+    const Selection all = selectMatching(filter);
+    // A facet with a choice made is counted as if that choice were cleared
+    auto without = [&](QString Filter::*field) {
+        if ((filter.*field).isEmpty()) {
+            return all;
+        }
+        Filter others = filter;
+        (others.*field).clear();
+        return selectMatching(others);
+    };
+
+    Facets result;
+    result.departments = countFacet(departments, departmentRows, without(&Filter::department));
+    result.categories = countFacet(categories, categoryRows, without(&Filter::category));
+    result.codes = countFacet(codes, codeRows, without(&Filter::code));
+
+    Selection anyPrice = all;
+    if (filter.minPriceCents > 0 || filter.maxPriceCents < INT_MAX) {
+        Filter others = filter;
+        others.minPriceCents = 0;
+        others.maxPriceCents = INT_MAX;
+        anyPrice = selectMatching(others);
+    }
+    for (int bucket = 0; bucket < priceBucketCount(); ++bucket) {
+        result.prices.append({priceBucketLabel(bucket), priceRows[bucket].intersectionCount(anyPrice)});
+    }
+    return result;
+}
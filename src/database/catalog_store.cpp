@@ -0,0 +1,92 @@
+#include "database/catalog_store.h"
+#include <QThread>
+#include <functional>
+#include <limits>
+#include <thread>
+
+CatalogStore::CatalogStore()
+    : current(nullptr)
+    , epoch(1)
+    , nextNumber(1)
+{}
+
+CatalogStore::~CatalogStore() {
+    delete current.load();
+    for (const auto& entry : std::as_const(retired)) {
+        delete entry.first;
+    }
+}
+
+CatalogStore::Pin::Pin(Pin&& other) noexcept : version(other.version), slot(other.slot) {
+    other.version = nullptr;
+    other.slot = nullptr;
+}
+
+CatalogStore::Pin::~Pin() {
+    if (slot) {
+        slot->store(0);
+    }
+}
+
+CatalogStore::Pin CatalogStore::pin() const {
+    // Claiming a free slot and announcing the epoch is one compare-and-swap.
+    // An epoch read a moment too early is only more conservative.
+    const quint64 announced = epoch.load();
+    const size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_READERS;
+    while (true) {
+        for (int i = 0; i < MAX_READERS; ++i) {
+            std::atomic<quint64>& slot = slots[(start + i) % MAX_READERS].epoch;
+            quint64 expected = 0;
+            if (slot.load(std::memory_order_relaxed) == 0 && slot.compare_exchange_strong(expected, announced)) {
+                // Loaded after the announcement, so a writer that missed it already swapped this in
+                return Pin(current.load(), &slot);
+            }
+        }
+        QThread::yieldCurrentThread();
+    }
+}
+
+quint64 CatalogStore::version() const {
+    const Version* latest = current.load();
+    return latest ? latest->number : 0;
+}
+
+void CatalogStore::publish(CatalogSnapshot snapshot) {
+    QMutexLocker lock(&writeLock);
+    publishLocked(std::move(snapshot));
+}
+
+void CatalogStore::publishLocked(CatalogSnapshot&& snapshot) {
+    const Version* previous = current.exchange(new Version{std::move(snapshot), nextNumber++});
+    if (previous) {
+        // Pins announced after this epoch can only have loaded the new version
+        retired.append(qMakePair(previous, epoch.fetch_add(1)));
+    }
+    reclaimLocked();
+}
+
+int CatalogStore::reclaim() {
+    QMutexLocker lock(&writeLock);
+    return reclaimLocked();
+}
+
+int CatalogStore::reclaimLocked() {
+    quint64 oldestPin = std::numeric_limits<quint64>::max();
+    for (const Slot& slot : slots) {
+        const quint64 announced = slot.epoch.load();
+        if (announced != 0 && announced < oldestPin) {
+            oldestPin = announced;
+        }
+    }
+
+    QVector<QPair<const Version*, quint64>> stillVisible;
+    for (const auto& entry : std::as_const(retired)) {
+        if (entry.second < oldestPin) {
+            delete entry.first;
+        } else {
+            stillVisible.append(entry);
+        }
+    }
+    retired.swap(stillVisible);
+    return retired.size();
+}
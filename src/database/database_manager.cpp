@@ -1,35 +1,119 @@
 #include "database/database_manager.h"
+#include "database/db_connector.h"
+#include "utils/config.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QSql>
 #include <QDebug>
+#include <QHash>
+#include <climits>
 
-DatabaseManager::DatabaseManager() {
-    initializeDatabase();
+namespace {
+
+// Prices are REAL in the table; filters and sorts compare this integer cents
+// expression instead, so a bound like $9.00 never misses a stored 8.999999.
+// The indexes are built on the same expression, so it must match exactly.
+const QString PRICE_CENTS = "CAST(ROUND(price * 100) AS INTEGER)";
+
+// Inserts one of the product unless the user's cart already has it
+const QString ADD_TO_CART_IF_ABSENT =
+    "INSERT INTO cart (user_email, product_id, quantity) "
+    "SELECT ?, ?, 1 WHERE NOT EXISTS "
+    "(SELECT 1 FROM cart WHERE user_email = ? AND product_id = ?)";
+
+Textbook textbookFromRow(const QSqlQuery& query) {
+    return Textbook(
+        query.value("department").toString(),
+        query.value("lec").toString(),
+        query.value("course_category").toString(),
+        query.value("course_code").toString(),
+        query.value("title").toString(),
+        query.value("author").toString(),
+        query.value("product_id").toString(),
+        query.value("price").toDouble(),
+        query.value("image_path").toString()
+    );
+}
+
+}
+
+DatabaseManager::DatabaseManager(QObject* parent, bool initializeNow) : QObject(parent) {
+    if (initializeNow) {
+        initializeDatabase();
+    }
 }
 
 DatabaseManager::~DatabaseManager() {
-    if (db.isOpen()) {
-        db.close();
+    // Worker connections are closed by DbConnector when their threads exit
+    const QString name = QLatin1String(QSqlDatabase::defaultConnection);
+    if (QSqlDatabase::contains(name)) {
+        QSqlDatabase::database(name, false).close();
     }
 }
 
+// Safe to call from a worker thread, which then migrates on its own connection
 bool DatabaseManager::initializeDatabase() {
-    db = QSqlDatabase::addDatabase("QSQLITE");
-    db.setDatabaseName("bmcc_store.db");
-    
-    if (!db.open()) {
-        qDebug() << "Error opening database:" << db.lastError().text();
-        return false;
+    QSqlDatabase db = DbConnector::database();
+    if (!db.isOpen()) {
+        return false;  // DbConnector already logged the error
     }
     
     createTables();
     populateInitialData();
+    reloadCatalog();
     return true;
 }
 
+void DatabaseManager::reloadCatalog() {
+    if (!Config::IN_MEMORY_CATALOG) {
+        return;
+    }
+    {
+        QMutexLocker lock(&pendingLock);
+        pendingBooks.clear();  // The reload reads them from the table anyway
+    }
+    const QVector<Textbook> books = getAllTextbooks();
+    CatalogSnapshot snapshot;
+    snapshot.reserve(books.size());
+    for (const Textbook& book : books) {
+        snapshot.append(book);
+    }
+    snapshot.buildSortOrders();
+    catalogStore.publish(std::move(snapshot));
+}
+
+// Inserts are batched into one new catalog version per event loop pass, so a
+// bulk import publishes once instead of copying the catalog for every row
+void DatabaseManager::queueCatalogAppend(const Textbook& book) {
+    if (!Config::IN_MEMORY_CATALOG || catalogStore.version() == 0) {
+        return;  // Nothing published yet, the first load will include the book
+    }
+    QMutexLocker lock(&pendingLock);
+    pendingBooks.append(book);
+    if (pendingBooks.size() == 1) {
+        QMetaObject::invokeMethod(this, &DatabaseManager::flushCatalogAppends, Qt::QueuedConnection);
+    }
+}
+
+void DatabaseManager::flushCatalogAppends() {
+    QVector<Textbook> books;
+    {
+        QMutexLocker lock(&pendingLock);
+        books.swap(pendingBooks);
+    }
+    if (books.isEmpty()) {
+        return;
+    }
+    catalogStore.update([&books](CatalogSnapshot& snapshot) {
+        for (const Textbook& book : std::as_const(books)) {
+            snapshot.append(book);
+        }
+        snapshot.buildSortOrders();
+    });
+}
+
 void DatabaseManager::createTables() {
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     
     // Create textbooks table
     query.exec(
@@ -45,6 +129,36 @@ void DatabaseManager::createTables() {
         "image_path TEXT)"
     );
 
+    // Covering indexes for the catalog sorts. Product id follows the sort key
+    // so key plus tiebreak is an index prefix, and the filter columns after it
+    // let a filtered, sorted page be read from the index alone. The price
+    // indexes key on integer cents and carry price itself for the expression.
+    // Category plus a price range is an equality and a range on one index.
+    query.exec("DROP INDEX IF EXISTS idx_textbooks_price");  // Keyed on the REAL price
+    query.exec(
+        "CREATE INDEX IF NOT EXISTS idx_textbooks_price_cents ON textbooks "
+        "(" + PRICE_CENTS + ", product_id, department, lec, course_category, course_code, title, author, price)"
+    );
+    query.exec(
+        "CREATE INDEX IF NOT EXISTS idx_textbooks_category_price ON textbooks "
+        "(course_category, " + PRICE_CENTS + ", product_id, department, lec, course_code, title, author, price)"
+    );
+    query.exec(
+        "CREATE INDEX IF NOT EXISTS idx_textbooks_title ON textbooks "
+        "(title, product_id, author, department, lec, course_category, course_code, price)"
+    );
+
+    // Listings posted in the app record who posted them; seeded books have none
+    query.exec("PRAGMA table_info(textbooks)");
+    bool hasSeller = false;
+    while (query.next()) {
+        hasSeller = hasSeller || query.value("name").toString() == "seller_email";
+    }
+    if (!hasSeller) {
+        query.exec("ALTER TABLE textbooks ADD COLUMN seller_email TEXT");
+    }
+    query.exec("CREATE INDEX IF NOT EXISTS idx_textbooks_seller ON textbooks (seller_email)");
+
     // Create wishlist table
     query.exec(
         "CREATE TABLE IF NOT EXISTS wishlist ("
@@ -64,6 +178,7 @@ void DatabaseManager::createTables() {
         "quantity INTEGER,"
         "FOREIGN KEY(product_id) REFERENCES textbooks(product_id))"
     );
+    query.exec("CREATE INDEX IF NOT EXISTS idx_cart_user ON cart (user_email, product_id)");
 
     // Create student profiles table
     query.exec(
@@ -87,20 +202,22 @@ void DatabaseManager::createTables() {
 
 // Adds item into cart database after add to cart is clciked
 bool DatabaseManager::addToCart(const QString& userEmail, const QString& productId, int quantity) {
+    QSqlDatabase db = DbConnector::database();
     try {
-        // Create a QSqlQuery object to use SQL queries
-        QSqlQuery query;
-
-        // Prepares my SQL query object to add data in cart table
+        // A product already in the cart gets its quantity raised instead of a
+        // second row, so the cart holds one row per product like addManyToCart keeps it
+        if (!db.transaction()) {
+            // Without one a failed insert would leave the update committed
+            throw std::runtime_error("Error starting cart transaction: " + db.lastError().text().toStdString());
+        }
+        QSqlQuery query(db);
         query.prepare(
-            "INSERT INTO cart (user_email, product_id, quantity) "
-            "VALUES (?, ?, ?)"
+            "UPDATE cart SET quantity = quantity + ? "
+            "WHERE user_email = ? AND product_id = ?"
         );
-
-        // Adds input paramters to queries
+        query.addBindValue(quantity);   // Quantity of the product being added.
         query.addBindValue(userEmail);  // User's email address.
         query.addBindValue(productId);  // Product ID being added to the cart.
-        query.addBindValue(quantity);   // Quantity of the product being added.
 
         // Execute the query, if fails, throw an exception
         if (!query.exec()) {
@@ -108,40 +225,70 @@ bool DatabaseManager::addToCart(const QString& userEmail, const QString& product
             throw std::runtime_error("Error executing query: " + query.lastError().text().toStdString());
         }
 
+        if (query.numRowsAffected() == 0) {
+            query.prepare(
+                "INSERT INTO cart (user_email, product_id, quantity) "
+                "VALUES (?, ?, ?)"
+            );
+            query.addBindValue(userEmail);
+            query.addBindValue(productId);
+            query.addBindValue(quantity);
+            if (!query.exec()) {
+                throw std::runtime_error("Error executing query: " + query.lastError().text().toStdString());
+            }
+        }
+        if (!db.commit()) {
+            throw std::runtime_error("Error committing cart: " + db.lastError().text().toStdString());
+        }
+
         // If no errors, return true indicating success
         qDebug() << "Succesfully added to cart";
+        emit cartChanged(userEmail, {productId}, true);
         return true;
     } catch (const std::exception& e) {
         // Catch any exceptions and log the error message
         qDebug() << "Exception in addToCart:" << e.what();
+        db.rollback();
         return false;  // Return false to show failure
     }
 }
 
 bool DatabaseManager::addToWishlist(const QString& userEmail, const QString& productId) {
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.prepare(
         "INSERT OR IGNORE INTO wishlist (user_email, product_id) "
         "VALUES (?, ?)"
     );
     query.addBindValue(userEmail);
     query.addBindValue(productId);
-    return query.exec();
+    if (!query.exec()) {
+        return false;
+    }
+    if (query.numRowsAffected() > 0) {
+        emit wishlistChanged(userEmail, {productId}, true);
+    }
+    return true;
 }
 
 bool DatabaseManager::removeFromWishlist(const QString& userEmail, const QString& productId) {
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.prepare(
         "DELETE FROM wishlist WHERE user_email = ? AND product_id = ?"
     );
     query.addBindValue(userEmail);
     query.addBindValue(productId);
-    return query.exec();
+    if (!query.exec()) {
+        return false;
+    }
+    if (query.numRowsAffected() > 0) {
+        emit wishlistChanged(userEmail, {productId}, false);
+    }
+    return true;
 }
 
 QVector<Textbook> DatabaseManager::getWishlist(const QString& userEmail) {
     QVector<Textbook> wishlistItems;
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.prepare(
         "SELECT t.* FROM wishlist w "
         "JOIN textbooks t ON w.product_id = t.product_id "
@@ -178,16 +325,17 @@ bool DatabaseManager::createTextbookListing(
     const QString& title,
     const QString& author,
     double price,
-    const QString& imagePath
+    const QString& imagePath,
+    const QString& sellerEmail
 ) {
     // Generate unique product ID using timestamp
     QString productId = QString::number(QDateTime::currentSecsSinceEpoch());
     
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.prepare(
         "INSERT INTO textbooks "
-        "(product_id, department, lec, course_category, course_code, title, author, price, image_path) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)"
+        "(product_id, department, lec, course_category, course_code, title, author, price, image_path, seller_email) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"
     );
     
     query.addBindValue(productId);
@@ -199,10 +347,19 @@ bool DatabaseManager::createTextbookListing(
     query.addBindValue(author);
     query.addBindValue(price);
     query.addBindValue(imagePath);
+    query.addBindValue(sellerEmail.isEmpty() ? QVariant() : QVariant(sellerEmail));
     
     bool success = query.exec();
     if (!success) {
         qDebug() << "Failed to create listing:" << query.lastError().text();
+    } else {
+        Textbook book(department, lec, courseCategory, courseCodes.join(","),
+                      title, author, productId, price, imagePath);
+        queueCatalogAppend(book);
+        emit textbookAdded(book);
+        if (!sellerEmail.isEmpty()) {
+            emit listingPosted(sellerEmail, productId);
+        }
     }
     
     return success;
@@ -211,7 +368,7 @@ bool DatabaseManager::createTextbookListing(
 
 // Change number of items of a particular item
 bool DatabaseManager::updateCartQuantity(const QString& userEmail, const QString& productId, int quantity) {
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.prepare(
         "UPDATE cart SET quantity = ? "
         "WHERE user_email = ? AND product_id = ?"
@@ -219,24 +376,32 @@ bool DatabaseManager::updateCartQuantity(const QString& userEmail, const QString
     query.addBindValue(quantity);
     query.addBindValue(userEmail);
     query.addBindValue(productId);
-    return query.exec();
+    if (!query.exec()) {
+        return false;
+    }
+    emit cartChanged(userEmail, {productId}, quantity > 0);
+    return true;
 }
 
 // Removes item from cart database
 bool DatabaseManager::removeFromCart(const QString& userEmail, const QString& productId) {
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.prepare(
         "DELETE FROM cart WHERE user_email = ? AND product_id = ?"
     );
     query.addBindValue(userEmail);
     query.addBindValue(productId);
-    return query.exec();
+    if (!query.exec()) {
+        return false;
+    }
+    emit cartChanged(userEmail, {productId}, false);
+    return true;
 }
 
 // Gets cart to display it in cart listing
 QVector<QPair<Textbook, int>> DatabaseManager::getCart(const QString& userEmail) {
     QVector<QPair<Textbook, int>> cartItems;
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.prepare(
         "SELECT t.*, c.quantity FROM cart c "
         "JOIN textbooks t ON c.product_id = t.product_id "
@@ -264,6 +429,119 @@ QVector<QPair<Textbook, int>> DatabaseManager::getCart(const QString& userEmail)
     return cartItems;
 }
 
+int DatabaseManager::addManyToCart(const QString& userEmail, const QStringList& productIds) {
+    QSqlDatabase db = DbConnector::database();
+    if (!db.transaction()) {
+        qDebug() << "Could not start cart transaction:" << db.lastError().text();
+        return -1;  // Without one every row would commit on its own
+    }
+    QSqlQuery insert(db);
+    insert.prepare(ADD_TO_CART_IF_ABSENT);
+    QStringList added;
+    for (const QString& productId : productIds) {
+        insert.addBindValue(userEmail);
+        insert.addBindValue(productId);
+        insert.addBindValue(userEmail);
+        insert.addBindValue(productId);
+        if (!insert.exec()) {
+            qDebug() << "Batch add to cart failed:" << insert.lastError().text();
+            db.rollback();
+            return -1;
+        }
+        if (insert.numRowsAffected() > 0) {
+            added.append(productId);
+        }
+    }
+    if (!db.commit()) {
+        db.rollback();
+        return -1;
+    }
+    if (!added.isEmpty()) {
+        emit cartChanged(userEmail, added, true);
+    }
+    return added.size();
+}
+
+int DatabaseManager::moveWishlistToCart(const QString& userEmail, const QStringList& productIds) {
+    QSqlDatabase db = DbConnector::database();
+    if (!db.transaction()) {
+        qDebug() << "Could not start cart transaction:" << db.lastError().text();
+        return -1;  // Without one every row would commit on its own
+    }
+    QSqlQuery remove(db);
+    remove.prepare("DELETE FROM wishlist WHERE user_email = ? AND product_id = ?");
+    QSqlQuery insert(db);
+    insert.prepare(ADD_TO_CART_IF_ABSENT);
+    QStringList moved;
+    for (const QString& productId : productIds) {
+        remove.addBindValue(userEmail);
+        remove.addBindValue(productId);
+        if (!remove.exec()) {
+            qDebug() << "Batch move to cart failed:" << remove.lastError().text();
+            db.rollback();
+            return -1;
+        }
+        if (remove.numRowsAffected() == 0) {
+            continue;  // Not on the wishlist
+        }
+        insert.addBindValue(userEmail);
+        insert.addBindValue(productId);
+        insert.addBindValue(userEmail);
+        insert.addBindValue(productId);
+        if (!insert.exec()) {
+            qDebug() << "Batch move to cart failed:" << insert.lastError().text();
+            db.rollback();
+            return -1;
+        }
+        moved.append(productId);
+    }
+    if (!db.commit()) {
+        db.rollback();
+        return -1;
+    }
+    if (!moved.isEmpty()) {
+        emit wishlistChanged(userEmail, moved, false);
+        emit cartChanged(userEmail, moved, true);
+    }
+    return moved.size();
+}
+
+int DatabaseManager::removeMany(const QString& userEmail, const QStringList& productIds, ItemList list) {
+    QSqlDatabase db = DbConnector::database();
+    if (!db.transaction()) {
+        qDebug() << "Could not start cart transaction:" << db.lastError().text();
+        return -1;  // Without one every row would commit on its own
+    }
+    QSqlQuery remove(db);
+    remove.prepare(list == ItemList::Cart
+        ? "DELETE FROM cart WHERE user_email = ? AND product_id = ?"
+        : "DELETE FROM wishlist WHERE user_email = ? AND product_id = ?");
+    QStringList removed;
+    for (const QString& productId : productIds) {
+        remove.addBindValue(userEmail);
+        remove.addBindValue(productId);
+        if (!remove.exec()) {
+            qDebug() << "Batch remove failed:" << remove.lastError().text();
+            db.rollback();
+            return -1;
+        }
+        if (remove.numRowsAffected() > 0) {
+            removed.append(productId);
+        }
+    }
+    if (!db.commit()) {
+        db.rollback();
+        return -1;
+    }
+    if (!removed.isEmpty()) {
+        if (list == ItemList::Cart) {
+            emit cartChanged(userEmail, removed, false);
+        } else {
+            emit wishlistChanged(userEmail, removed, false);
+        }
+    }
+    return removed.size();
+}
 
 
 
@@ -271,7 +549,7 @@ QVector<QPair<Textbook, int>> DatabaseManager::getCart(const QString& userEmail)
 
 
 void DatabaseManager::createRecommendationTables() {
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     
     // Create semester requirements table
     query.exec(
@@ -293,7 +571,7 @@ void DatabaseManager::createRecommendationTables() {
 }
 
 void DatabaseManager::populateRecommendationData() {
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.exec("SELECT COUNT(*) FROM semester_requirements");
     query.next();
     
@@ -315,7 +593,7 @@ void DatabaseManager::populateRecommendationData() {
 
     // Add requirements
     for (const auto& course : csLowerFreshmanCourses) {
-        QSqlQuery insertQuery;
+        QSqlQuery insertQuery(DbConnector::database());
         insertQuery.prepare(
             "INSERT INTO semester_requirements (major, semester_level, course_category, course_code) "
             "VALUES (?, ?, ?, ?)"
@@ -339,7 +617,7 @@ bool DatabaseManager::updateStudentProfile(const QString& email, const QString&
              << "Major:" << major 
              << "Semester:" << semesterLevel;
              
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.prepare(
         "INSERT OR REPLACE INTO student_profiles (email, major, semester_level) "
         "VALUES (?, ?, ?)"
@@ -353,47 +631,87 @@ bool DatabaseManager::updateStudentProfile(const QString& email, const QString&
         qDebug() << "Profile update failed:" << query.lastError().text();
     } else {
         qDebug() << "Profile updated successfully";
+        emit studentProfileChanged(email, major, semesterLevel);
     }
     
     return success;
 }
 
-QString DatabaseManager::getStudentMajor(const QString& email) {
-    QSqlQuery query;
-    query.prepare("SELECT major FROM student_profiles WHERE email = ?");
-    query.addBindValue(email);
-    
-    if (query.exec() && query.next()) {
-        return query.value(0).toString();
+bool DatabaseManager::updateStudentProfiles(const QStringList& emails, const QStringList& majors,
+                                            const QStringList& semesterLevels) {
+    if (emails.isEmpty()) {
+        return true;
     }
-    
-    return QString();
+    QSqlQuery query(DbConnector::database());
+    query.prepare(
+        "INSERT OR REPLACE INTO student_profiles (email, major, semester_level) "
+        "VALUES (?, ?, ?)"
+    );
+    query.addBindValue(QVariantList(emails.begin(), emails.end()));
+    query.addBindValue(QVariantList(majors.begin(), majors.end()));
+    query.addBindValue(QVariantList(semesterLevels.begin(), semesterLevels.end()));
+    if (!query.execBatch()) {
+        qDebug() << "Profile batch failed:" << query.lastError().text();
+        return false;
+    }
+    return true;
 }
 
-QString DatabaseManager::getStudentSemesterLevel(const QString& email) {
-    QSqlQuery query;
-    query.prepare("SELECT semester_level FROM student_profiles WHERE email = ?");
+// Every per-user figure the shop shows, as subqueries of one statement so
+// login costs one round trip. The email is bound once through the CTE.
+UserProfile::Data DatabaseManager::getUserProfile(const QString& email) {
+    UserProfile::Data data;
+    data.email = email;
+    QSqlQuery query(DbConnector::database());
+    query.prepare(
+        "WITH me(email) AS (SELECT ?) SELECT "
+        "(SELECT major FROM student_profiles p WHERE p.email = me.email) AS major, "
+        "(SELECT semester_level FROM student_profiles p WHERE p.email = me.email) AS semester_level, "
+        "(SELECT COALESCE(SUM(c.quantity), 0) FROM cart c JOIN textbooks t ON c.product_id = t.product_id "
+        " WHERE c.user_email = me.email) AS cart_count, "
+        "(SELECT COALESCE(SUM(c.quantity * t.price), 0) FROM cart c JOIN textbooks t ON c.product_id = t.product_id "
+        " WHERE c.user_email = me.email) AS cart_total, "
+        "(SELECT group_concat(c.product_id, char(31)) FROM cart c WHERE c.user_email = me.email) AS cart, "
+        "(SELECT group_concat(w.product_id, char(31)) FROM wishlist w WHERE w.user_email = me.email) AS wishlist, "
+        "(SELECT COUNT(*) FROM textbooks t WHERE t.seller_email = me.email) AS listing_count "
+        "FROM me"
+    );
     query.addBindValue(email);
-    
-    if (query.exec() && query.next()) {
-        return query.value(0).toString();
+    if (!query.exec() || !query.next()) {
+        qDebug() << "Profile load failed:" << query.lastError().text();
+        return data;
     }
-    
-    return QString();
+    data.major = query.value("major").toString();
+    data.semesterLevel = query.value("semester_level").toString();
+    data.cartCount = query.value("cart_count").toInt();
+    data.cartTotal = query.value("cart_total").toDouble();
+    // Ids come back joined by the unit separator, which no product id contains
+    data.cart = SortedIdSet(query.value("cart").toString().split(QChar(31), Qt::SkipEmptyParts));
+    data.wishlist = SortedIdSet(query.value("wishlist").toString().split(QChar(31), Qt::SkipEmptyParts));
+    data.listingCount = query.value("listing_count").toInt();
+    return data;
 }
 
-QVector<Textbook> DatabaseManager::getRecommendedBooks(const QString& email) {
+QPair<int, double> DatabaseManager::getCartSummary(const QString& userEmail) {
+    QSqlQuery query(DbConnector::database());
+    query.prepare(
+        "SELECT COALESCE(SUM(c.quantity), 0), COALESCE(SUM(c.quantity * t.price), 0) FROM cart c "
+        "JOIN textbooks t ON c.product_id = t.product_id "
+        "WHERE c.user_email = ?"
+    );
+    query.addBindValue(userEmail);
+    if (!query.exec() || !query.next()) {
+        return {0, 0.0};
+    }
+    return {query.value(0).toInt(), query.value(1).toDouble()};
+}
+
+QVector<Textbook> DatabaseManager::getRecommendedBooks(const QString& major, const QString& semester) {
     QVector<Textbook> recommendations;
     
-    qDebug() << "Getting recommendations for:" << email;
-    
     // Define the asset path (adjust as needed)
     QString assetPath = QCoreApplication::applicationDirPath() + "/../assets/images/textbooks/";
 
-    // Get student's major and semester level
-    QString major = getStudentMajor(email);
-    QString semester = getStudentSemesterLevel(email);
-    
     qDebug() << "Student profile - Major:" << major << "Semester:" << semester;
     
     if (major.isEmpty() || semester.isEmpty()) {
@@ -401,7 +719,7 @@ QVector<Textbook> DatabaseManager::getRecommendedBooks(const QString& email) {
         return recommendations;
     }
 
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.prepare(
         "SELECT DISTINCT t.* FROM textbooks t "
         "JOIN semester_requirements r ON "
@@ -499,7 +817,7 @@ QVector<Textbook> DatabaseManager::getRecommendedBooks(const QString& email) {
 
 
 void DatabaseManager::populateInitialData() {
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.exec("SELECT COUNT(*) FROM textbooks");
     query.next();
     if (query.value(0).toInt() > 0) return;
@@ -558,7 +876,7 @@ void DatabaseManager::populateInitialData() {
 }
 
 bool DatabaseManager::addTextbook(const Textbook& textbook) {
-    QSqlQuery query;
+    QSqlQuery query(DbConnector::database());
     query.prepare(
         "INSERT INTO textbooks VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)"
     );
@@ -572,7 +890,169 @@ bool DatabaseManager::addTextbook(const Textbook& textbook) {
     query.addBindValue(textbook.price);
     query.addBindValue(textbook.getImagePath());
     
-    return query.exec();
+    if (!query.exec()) {
+        return false;
+    }
+    queueCatalogAppend(textbook);
+    emit textbookAdded(textbook);
+    return true;
+}
+
+QVector<Textbook> DatabaseManager::getAllTextbooks() {
+    QVector<Textbook> books;
+    QSqlQuery query(DbConnector::database());
+    // Insertion order, so the in-memory catalog's row numbers follow rowid
+    if (!query.exec("SELECT * FROM textbooks ORDER BY rowid")) {
+        qDebug() << "Failed to load textbooks:" << query.lastError().text();
+        return books;
+    }
+    while (query.next()) {
+        books.append(textbookFromRow(query));
+    }
+    return books;
+}
+
+QVector<Textbook> DatabaseManager::getListingsBySeller(const QString& sellerEmail) {
+    QVector<Textbook> books;
+    QSqlQuery query(DbConnector::database());
+    // The same rows getUserProfile counts, found through idx_textbooks_seller
+    query.prepare("SELECT * FROM textbooks WHERE seller_email = ? ORDER BY rowid DESC");
+    query.addBindValue(sellerEmail);
+    if (!query.exec()) {
+        qDebug() << "Failed to load listings:" << query.lastError().text();
+        return books;
+    }
+    while (query.next()) {
+        books.append(textbookFromRow(query));
+    }
+    return books;
+}
+
+QVector<QPair<Textbook, int>> DatabaseManager::getTextbookPopularity() {
+    QVector<QPair<Textbook, int>> books;
+    QSqlQuery query(DbConnector::database());
+    query.prepare(
+        "SELECT t.*, "
+        "(SELECT COALESCE(SUM(c.quantity), 0) FROM cart c WHERE c.product_id = t.product_id) + "
+        "(SELECT COUNT(*) FROM wishlist w WHERE w.product_id = t.product_id) AS popularity "
+        "FROM textbooks t"
+    );
+
+    if (query.exec()) {
+        while (query.next()) {
+            books.append(qMakePair(
+                Textbook(
+                    query.value("department").toString(),
+                    query.value("lec").toString(),
+                    query.value("course_category").toString(),
+                    query.value("course_code").toString(),
+                    query.value("title").toString(),
+                    query.value("author").toString(),
+                    query.value("product_id").toString(),
+                    query.value("price").toDouble(),
+                    query.value("image_path").toString()
+                ),
+                query.value("popularity").toInt()
+            ));
+        }
+    } else {
+        qDebug() << "Failed to load textbook popularity:" << query.lastError().text();
+    }
+    return books;
+}
+
+QString DatabaseManager::textbookSearchSql(const CatalogSnapshot::Filter& filter, QVariantList& values) const {
+    // A price range is always read as a range of one of the price indexes,
+    // whatever the sort; only the rows in range are sorted afterwards, and
+    // the price sorts need no sort at all. Without a range, Newest reads the
+    // table in rowid order and Title its own index; left to the planner, an
+    // equality would pick a narrower index and sort its rows afterwards.
+    const bool hasPriceRange = filter.minPriceCents > 0 || filter.maxPriceCents < INT_MAX;
+    QString queryStr = "SELECT rowid FROM textbooks";
+    if (hasPriceRange) {
+        queryStr += filter.category.isEmpty() ? " INDEXED BY idx_textbooks_price_cents"
+                                              : " INDEXED BY idx_textbooks_category_price";
+    } else if (filter.sort == CatalogSort::Newest) {
+        queryStr += " NOT INDEXED";
+    } else if (filter.sort == CatalogSort::Title) {
+        queryStr += " INDEXED BY idx_textbooks_title";
+    }
+    queryStr += " WHERE 1=1";
+
+    // Filters are bound, never pasted into the SQL, since they come straight from live search input
+    if (!filter.department.isEmpty()) {
+        queryStr += " AND department = ?";  // Picked from the department facet
+        values << filter.department;
+    }
+    if (!filter.lec.isEmpty()) {
+        queryStr += " AND lec = ?";
+        values << filter.lec;
+    }
+    if (!filter.category.isEmpty()) {
+        queryStr += " AND course_category = ?";
+        values << filter.category;
+    }
+    if (!filter.code.isEmpty()) {
+        queryStr += " AND course_code = ?";
+        values << filter.code;
+    }
+    if (!filter.text.isEmpty()) {
+        // The search bar also offers authors and "CSC 101" style codes as suggestions
+        queryStr += " AND (title LIKE ? OR author LIKE ? OR course_category || ' ' || course_code LIKE ?)";
+        values << "%" + filter.text + "%" << "%" + filter.text + "%" << "%" + filter.text + "%";
+    }
+    if (hasPriceRange) {
+        queryStr += " AND " + PRICE_CENTS + " BETWEEN ? AND ?";
+        values << filter.minPriceCents << filter.maxPriceCents;
+    }
+
+    // Product id breaks ties, so every order is total and, without a price
+    // range, comes straight from an index (or the table itself for Newest)
+    switch (filter.sort) {
+    case CatalogSort::Newest:
+        queryStr += " ORDER BY rowid DESC";
+        break;
+    case CatalogSort::PriceLowToHigh:
+        queryStr += " ORDER BY " + PRICE_CENTS + ", product_id";
+        break;
+    case CatalogSort::PriceHighToLow:
+        queryStr += " ORDER BY " + PRICE_CENTS + " DESC, product_id DESC";
+        break;
+    case CatalogSort::Title:
+        queryStr += " ORDER BY title, product_id";
+        break;
+    }
+    return queryStr;
+}
+
+QPair<int, int> DatabaseManager::getPriceBoundsCents() {
+    QSqlQuery query(DbConnector::database());
+    // One aggregate per subquery, so each is a single seek to an end of the cents index
+    if (!query.exec("SELECT (SELECT MIN(" + PRICE_CENTS + ") FROM textbooks), "
+                    "(SELECT MAX(" + PRICE_CENTS + ") FROM textbooks)") || !query.next()) {
+        qDebug() << "Failed to read price bounds:" << query.lastError().text();
+        return qMakePair(0, 0);
+    }
+    return qMakePair(query.value(0).toInt(), query.value(1).toInt());
+}
+
+QStringList DatabaseManager::explainTextbookSearch(const CatalogSnapshot::Filter& filter) {
+    QVariantList values;
+    QSqlQuery query(DbConnector::database());
+    query.prepare("EXPLAIN QUERY PLAN " + textbookSearchSql(filter, values) + " LIMIT 9 OFFSET 0");
+    for (const QVariant& value : std::as_const(values)) {
+        query.addBindValue(value);
+    }
+
+    QStringList plan;
+    if (!query.exec()) {
+        qDebug() << "Explaining textbook search failed:" << query.lastError().text();
+        return plan;
+    }
+    while (query.next()) {
+        plan << query.value("detail").toString();
+    }
+    return plan;
 }
 
 QVector<Textbook> DatabaseManager::getTextbooks(
@@ -582,41 +1062,56 @@ QVector<Textbook> DatabaseManager::getTextbooks(
     const QString& code,
     const QString& title,
     int page,
-    int itemsPerPage
+    int itemsPerPage,
+    int minPriceCents,
+    int maxPriceCents,
+    CatalogSort sort
 ) {
     QVector<Textbook> results;
-    QSqlQuery query;
-    QString queryStr = "SELECT * FROM textbooks WHERE 1=1";
-    
-    if (!department.isEmpty())
-        queryStr += " AND department LIKE '%" + department + "%'";
-    if (!lec.isEmpty())
-        queryStr += " AND lec = '" + lec + "'";
-    if (!category.isEmpty())
-        queryStr += " AND course_category = '" + category + "'";
-    if (!code.isEmpty())
-        queryStr += " AND course_code = '" + code + "'";
-    if (!title.isEmpty())
-        queryStr += " AND title LIKE '%" + title + "%'";
-        
-    queryStr += " LIMIT " + QString::number(itemsPerPage);
-    queryStr += " OFFSET " + QString::number((page - 1) * itemsPerPage);
-    
-    query.exec(queryStr);
-    
+    CatalogSnapshot::Filter filter{department, lec, category, code, title, minPriceCents, maxPriceCents, sort};
+
+    // The page is found on the covering indexes alone, then only its rows
+    // are read from the table for the image path
+    QVariantList values;
+    QSqlQuery query(DbConnector::database());
+    query.prepare(textbookSearchSql(filter, values) + " LIMIT ? OFFSET ?");
+    values << itemsPerPage << (page - 1) * itemsPerPage;
+    for (const QVariant& value : std::as_const(values)) {
+        query.addBindValue(value);
+    }
+
+    if (!query.exec()) {
+        qDebug() << "Textbook search failed:" << query.lastError().text();
+        return results;
+    }
+
+    QVector<qint64> rowIds;
     while (query.next()) {
-        results.append(Textbook(
-            query.value("department").toString(),
-            query.value("lec").toString(),
-            query.value("course_category").toString(),
-            query.value("course_code").toString(),
-            query.value("title").toString(),
-            query.value("author").toString(),
-            query.value("product_id").toString(),
-            query.value("price").toDouble(),
-            query.value("image_path").toString()  // Add this line
-        ));
+        rowIds.append(query.value(0).toLongLong());
+    }
+    if (rowIds.isEmpty()) {
+        return results;
+    }
+
+    // Row ids are integers from SQLite itself, safe to inline
+    QStringList idList;
+    for (qint64 rowId : std::as_const(rowIds)) {
+        idList << QString::number(rowId);
+    }
+    if (!query.exec("SELECT rowid, * FROM textbooks WHERE rowid IN (" + idList.join(',') + ")")) {
+        qDebug() << "Textbook page fetch failed:" << query.lastError().text();
+        return results;
+    }
+
+    QHash<qint64, Textbook> books;
+    while (query.next()) {
+        books.insert(query.value(0).toLongLong(), textbookFromRow(query));
+    }
+    for (qint64 rowId : std::as_const(rowIds)) {
+        auto book = books.constFind(rowId);
+        if (book != books.constEnd()) {
+            results.append(*book);
+        }
     }
-    
     return results;
-}
\ No newline at end of file
+}
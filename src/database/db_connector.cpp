@@ -0,0 +1,65 @@
+#include "database/db_connector.h"
+#include "utils/config.h"
+#include <QCoreApplication>
+#include <QThread>
+#include <QThreadStorage>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+namespace {
+
+// Owns a worker thread's connection name; QThreadStorage deletes it when the thread ends
+struct ThreadConnection {
+    QString name;
+
+    ~ThreadConnection() {
+        {
+            QSqlDatabase db = QSqlDatabase::database(name, false);
+            db.close();
+        }
+        QSqlDatabase::removeDatabase(name);
+    }
+};
+
+QThreadStorage<ThreadConnection*> threadConnections;
+
+}
+
+QSqlDatabase DbConnector::database() {
+    QCoreApplication* app = QCoreApplication::instance();
+    if (!app || QThread::currentThread() == app->thread()) {
+        return open(QLatin1String(QSqlDatabase::defaultConnection));
+    }
+
+    if (!threadConnections.hasLocalData()) {
+        ThreadConnection* connection = new ThreadConnection;
+        connection->name = QString("bmcc_worker_%1").arg(quintptr(QThread::currentThreadId()));
+        threadConnections.setLocalData(connection);
+    }
+    return open(threadConnections.localData()->name);
+}
+
+QSqlDatabase DbConnector::open(const QString& connectionName) {
+    if (QSqlDatabase::contains(connectionName)) {
+        QSqlDatabase db = QSqlDatabase::database(connectionName, false);
+        if (db.isOpen() || db.open()) {
+            return db;
+        }
+        qDebug() << "Error reopening database:" << db.lastError().text();
+        return db;
+    }
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    db.setDatabaseName(Config::DATABASE_FILE);
+    if (!db.open()) {
+        qDebug() << "Error opening database:" << db.lastError().text();
+        return db;
+    }
+
+    // WAL lets worker threads read while the GUI thread writes
+    QSqlQuery pragma(db);
+    pragma.exec("PRAGMA journal_mode=WAL");
+    pragma.exec("PRAGMA busy_timeout=2000");
+    return db;
+}
@@ -0,0 +1,30 @@
+#include "database/mutation_queue.h"
+#include "database/database_manager.h"
+
+MutationQueue::MutationQueue(DatabaseManager* db, QObject* parent)
+    : QObject(parent)
+    , dbManager(db)
+    , nextTicket(0)
+    , queued(0)
+{
+    // A single long lived thread keeps the writes in click order
+    worker.setMaxThreadCount(1);
+    worker.setExpiryTimeout(-1);
+}
+
+MutationQueue::~MutationQueue() {
+    worker.waitForDone();  // Every accepted write is committed before shutdown
+}
+
+quint64 MutationQueue::submit(Write write) {
+    const quint64 ticket = ++nextTicket;
+    ++queued;
+    worker.start([this, ticket, write = std::move(write)]() {
+        const bool ok = write(*dbManager);
+        QMetaObject::invokeMethod(this, [this, ticket, ok]() {
+            --queued;
+            emit finished(ticket, ok);
+        }, Qt::QueuedConnection);
+    });
+    return ticket;
+}
@@ -0,0 +1,244 @@
+#include "database/query_handler.h"
+#include <QElapsedTimer>
+#include <QDebug>
+#include "utils/thumbnail_cache.h"
+#include <algorithm>
+
+QueryHandler::QueryHandler(DatabaseManager* db, QObject* parent)
+    : QObject(parent)
+    , dbManager(db)
+    , generation(std::make_shared<std::atomic<quint64>>(0))
+    , spellingStale(true)
+    , prefetchEpoch(std::make_shared<std::atomic<quint64>>(0))
+    , lastResultCount(0)
+    , pageTurnHits(0)
+    , pageTurnMisses(0)
+    , nextLatency(0)
+    , skipped(0)
+{
+    // One long lived worker keeps a single warm SQLite connection and runs
+    // searches in order, so a superseded query never competes with the newest
+    workers.setMaxThreadCount(1);
+    workers.setExpiryTimeout(-1);
+    latencies.reserve(Config::SEARCH_LATENCY_WINDOW);
+
+    // The spelling index is rebuilt on the worker the next time it is needed
+    connect(dbManager, &DatabaseManager::textbookAdded, this, [this]() { spellingStale = true; });
+
+    // A new listing can shift every page, so prefetched ones are thrown away
+    connect(dbManager, &DatabaseManager::textbookAdded, this, [this]() {
+        cancelPrefetch();
+        prefetched.clear();
+    });
+
+    prefetchIdle.setSingleShot(true);
+    prefetchIdle.setInterval(Config::PREFETCH_IDLE_MS);
+    connect(&prefetchIdle, &QTimer::timeout, this, &QueryHandler::startPrefetch);
+}
+
+QueryHandler::~QueryHandler() {
+    ++*generation;  // Anything still running is now stale
+    ++*prefetchEpoch;
+    workers.clear();
+    workers.waitForDone();
+}
+
+quint64 QueryHandler::search(const SearchRequest& request) {
+    const quint64 searchGeneration = ++*generation;
+    std::shared_ptr<std::atomic<quint64>> latest = generation;
+    cancelPrefetch();
+
+    QElapsedTimer submitted;
+    submitted.start();
+
+    const QString filter = filterKey(request);
+    const bool pageTurn = filter == prefetchedFilter && request.page != lastRequest.page;
+    if (filter != prefetchedFilter) {
+        prefetched.clear();
+        prefetchedFilter = filter;
+    }
+    lastRequest = request;
+
+    auto ready = prefetched.constFind(request.page);
+    if (pageTurn) {
+        ready != prefetched.constEnd() ? ++pageTurnHits : ++pageTurnMisses;
+    }
+    if (ready != prefetched.constEnd()) {
+        // Still delivered from the event loop, as a worker result would be
+        const Answer answer = *ready;
+        QMetaObject::invokeMethod(this, [this, searchGeneration, answer, submitted]() {
+            deliver(searchGeneration, answer, 0.0, submitted.nsecsElapsed() / 1e6);
+        }, Qt::QueuedConnection);
+        return searchGeneration;
+    }
+
+    workers.start([this, latest, request, searchGeneration, submitted]() {
+        if (latest->load() != searchGeneration) {
+            // A newer search was queued while this one waited
+            QMetaObject::invokeMethod(this, [this]() { ++skipped; }, Qt::QueuedConnection);
+            return;
+        }
+
+        QElapsedTimer queryTimer;
+        queryTimer.start();
+        Answer answer = searchCatalog(request);
+        if (answer.results.isEmpty() && !request.title.trimmed().isEmpty()) {
+            answer.correction = correctSpelling(request.title);
+        }
+        const double queryMs = queryTimer.nsecsElapsed() / 1e6;
+
+        if (latest->load() != searchGeneration) {
+            return;  // Superseded while running, nobody wants these rows
+        }
+
+        QMetaObject::invokeMethod(this, [this, searchGeneration, answer, queryMs, submitted]() {
+            deliver(searchGeneration, answer, queryMs, submitted.nsecsElapsed() / 1e6);
+        }, Qt::QueuedConnection);
+    });
+
+    return searchGeneration;
+}
+
+// Reads the pinned in-memory catalog, or SQLite (without facets) when there is none
+QueryHandler::Answer QueryHandler::searchCatalog(const SearchRequest& request) {
+    Answer answer;
+    const CatalogStore::Pin catalog = dbManager->catalog().pin();
+    if (catalog.isNull()) {
+        answer.results = dbManager->getTextbooks(request.department, request.lec, request.category,
+                                                 request.code, request.title, request.page, request.pageSize,
+                                                 request.minPriceCents, request.maxPriceCents, request.sort);
+        return answer;
+    }
+
+    CatalogSnapshot::Filter filter;
+    filter.department = request.department;
+    filter.lec = request.lec;
+    filter.category = request.category;
+    filter.code = request.code;
+    filter.text = request.title;
+    filter.minPriceCents = request.minPriceCents;
+    filter.maxPriceCents = request.maxPriceCents;
+    filter.sort = request.sort;
+    answer.results = catalog->search(filter, request.page, request.pageSize);
+    answer.facets = catalog->facets(filter);
+    answer.hasFacets = true;
+    return answer;
+}
+
+QString QueryHandler::correctSpelling(const QString& text) {
+    if (spellingStale.exchange(false)) {
+        QElapsedTimer timer;
+        timer.start();
+        spelling.clear();
+        const QVector<Textbook> books = dbManager->getAllTextbooks();
+        for (const Textbook& book : books) {
+            spelling.insertText(book.title);
+            spelling.insertText(book.author);
+        }
+        qDebug() << "Spelling index:" << spelling.size() << "terms in" << timer.elapsed() << "ms";
+    }
+    return spelling.correct(text);
+}
+
+void QueryHandler::deliver(quint64 searchGeneration, const Answer& answer, double queryMs, double totalMs) {
+    if (searchGeneration != generation->load()) {
+        return;  // A newer search started after the worker finished
+    }
+
+    if (latencies.size() < Config::SEARCH_LATENCY_WINDOW) {
+        latencies.append(totalMs);
+    } else {
+        latencies[nextLatency] = totalMs;
+    }
+    nextLatency = (nextLatency + 1) % Config::SEARCH_LATENCY_WINDOW;
+
+    qDebug() << "Search" << searchGeneration << "returned" << answer.results.size() << "books,"
+             << "query" << QString::number(queryMs, 'f', 2) << "ms,"
+             << "total" << QString::number(totalMs, 'f', 2) << "ms,"
+             << "p95" << QString::number(latencyPercentile(95), 'f', 2) << "ms,"
+             << skipped << "superseded searches skipped";
+
+    if (pageTurnHits + pageTurnMisses > 0) {
+        qDebug() << pageTurnHits << "of" << pageTurnHits + pageTurnMisses << "page turns served from prefetch";
+    }
+
+    // The shown page is kept as well, so turning back to it is instant
+    lastResultCount = answer.results.size();
+    prefetched.insert(lastRequest.page, answer);
+    prefetchIdle.start();  // Neighbouring pages are fetched if the user lingers here
+
+    emit searchFinished(searchGeneration, answer.results);
+    if (answer.hasFacets) {
+        emit facetsUpdated(searchGeneration, answer.facets);
+    }
+    if (!answer.correction.isEmpty()) {
+        emit didYouMean(searchGeneration, answer.correction);
+    }
+}
+
+void QueryHandler::cancelPrefetch() {
+    prefetchIdle.stop();
+    ++*prefetchEpoch;
+}
+
+QString QueryHandler::filterKey(const SearchRequest& request) {
+    return QStringList{request.department, request.lec, request.category, request.code, request.title,
+                       QString::number(request.minPriceCents), QString::number(request.maxPriceCents),
+                       QString::number(int(request.sort)), QString::number(request.pageSize)}
+        .join(QChar(0x1F));  // Unit separator, never typed into a filter
+}
+
+// Queues the pages either side of the one on screen behind any real search,
+// then decodes their covers. Checks for cancellation before every step.
+void QueryHandler::startPrefetch() {
+    QVector<int> pages;
+    if (lastResultCount == lastRequest.pageSize) {
+        pages.append(lastRequest.page + 1);  // Only a full page can have a next one
+    }
+    if (lastRequest.page > 1) {
+        pages.append(lastRequest.page - 1);
+    }
+    pages.removeIf([this](int page) { return prefetched.contains(page); });
+    if (pages.isEmpty()) {
+        return;
+    }
+
+    std::shared_ptr<std::atomic<quint64>> epoch = prefetchEpoch;
+    const quint64 startedAt = epoch->load();
+    const SearchRequest base = lastRequest;
+    const QString filter = prefetchedFilter;
+
+    workers.start([this, epoch, startedAt, base, filter, pages]() {
+        const QSize coverSize(Config::CARD_COVER_WIDTH, Config::CARD_COVER_HEIGHT);
+        for (int page : pages) {
+            if (epoch->load() != startedAt) {
+                return;
+            }
+            SearchRequest request = base;
+            request.page = page;
+            const Answer answer = searchCatalog(request);
+            QMetaObject::invokeMethod(this, [this, epoch, startedAt, filter, page, answer]() {
+                if (epoch->load() == startedAt && filter == prefetchedFilter) {
+                    prefetched.insert(page, answer);
+                }
+            }, Qt::QueuedConnection);
+
+            for (const Textbook& book : answer.results) {
+                if (epoch->load() != startedAt) {
+                    return;
+                }
+                ThumbnailCache::shared().load(book.getImagePath(), coverSize);
+            }
+        }
+    }, -1);  // Below any search queued after it
+}
+
+double QueryHandler::latencyPercentile(double percentile) const {
+    if (latencies.isEmpty()) {
+        return 0.0;
+    }
+    QVector<double> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end());
+    int index = qBound(0, int(percentile / 100.0 * (sorted.size() - 1) + 0.5), int(sorted.size() - 1));
+    return sorted[index];
+}
@@ -20,3 +20,19 @@ Textbook::Textbook(
     price(bookPrice),
     imagePath(image)
 {}
+
+QStringList Textbook::searchTerms() const {
+    QStringList terms;
+    if (!title.isEmpty()) {
+        terms.append(title);
+    }
+    if (!author.isEmpty()) {
+        terms.append(author);
+    }
+    // Listings made from the profile page store several codes as "101,102"
+    const QStringList codes = courseCode.split(',', Qt::SkipEmptyParts);
+    for (const QString& code : codes) {
+        terms.append(courseCategory + " " + code.trimmed());
+    }
+    return terms;
+}
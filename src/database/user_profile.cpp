@@ -0,0 +1,61 @@
+#include "database/user_profile.h"
+#include "database/database_manager.h"
+
+UserProfile::UserProfile(DatabaseManager* db, QObject* parent)
+    : QObject(parent)
+    , dbManager(db)
+{
+    // Changes for other users are ignored; only one user is signed in at a time
+    connect(dbManager, &DatabaseManager::cartChanged, this,
+            [this](const QString& userEmail, const QStringList& productIds, bool inCart) {
+        if (data.email.isEmpty() || userEmail != data.email) {
+            return;
+        }
+        for (const QString& productId : productIds) {
+            if (inCart) {
+                data.cart.insert(productId);
+            } else {
+                data.cart.remove(productId);
+            }
+        }
+        const QPair<int, double> cart = dbManager->getCartSummary(userEmail);
+        data.cartCount = cart.first;
+        data.cartTotal = cart.second;
+        emit changed();
+    });
+    connect(dbManager, &DatabaseManager::wishlistChanged, this,
+            [this](const QString& userEmail, const QStringList& productIds, bool added) {
+        if (data.email.isEmpty() || userEmail != data.email) {
+            return;
+        }
+        for (const QString& productId : productIds) {
+            if (added) {
+                data.wishlist.insert(productId);
+            } else {
+                data.wishlist.remove(productId);
+            }
+        }
+        emit changed();
+    });
+    connect(dbManager, &DatabaseManager::studentProfileChanged, this,
+            [this](const QString& email, const QString& major, const QString& semesterLevel) {
+        if (data.email.isEmpty() || email != data.email) {
+            return;
+        }
+        data.major = major;
+        data.semesterLevel = semesterLevel;
+        emit changed();
+    });
+    connect(dbManager, &DatabaseManager::listingPosted, this, [this](const QString& sellerEmail) {
+        if (data.email.isEmpty() || sellerEmail != data.email) {
+            return;
+        }
+        ++data.listingCount;
+        emit changed();
+    });
+}
+
+void UserProfile::load(const QString& email) {
+    data = email.isEmpty() ? Data() : dbManager->getUserProfile(email);
+    emit changed();
+}
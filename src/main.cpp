@@ -3,58 +3,82 @@
 #include <QGraphicsEffect>  // For modifying my widgets appearence like CSS
 #include <QPropertyAnimation>  // Smooth time based transtions for objects
 #include <QEasingCurve>  // Controls the rate of change of animations
+#include <QCommandLineParser>  // Reads the --startup-timeline switch
+#include <QThreadPool>  // Runs the database setup and image decoding beside the login window
+#include <QTimer>
+#include <QDir>
+#include <QDebug>
+#include <functional>
+#include <utility>
 #include "ui/login_window.h"         
 #include "ui/registration_window.h"  
 #include "auth/authenticator.h"
 #include "ui/mainshop_window.h"
+#include "ui/theme.h"
+#include "utils/config.h"
+#include "utils/startup_timeline.h"
+#include "utils/thumbnail_cache.h"
+
+namespace {
+
+// Decodes the hero banner and the bundled covers at the size they are shown,
+// so the first shop page paints from ThumbnailCache instead of the disk
+void preloadImages() {
+   StartupTimeline::Phase phase("preload images");
+   const QString assets = QCoreApplication::applicationDirPath() + "/../assets/images/";
+   ThumbnailCache::shared().load(assets + "home/school.jpg", QSize(1400, 400));
+
+   const QSize coverSize(Config::CARD_COVER_WIDTH, Config::CARD_COVER_HEIGHT);
+   const QString covers = assets + "textbooks/";  // Same prefix as the seeded image paths
+   const QStringList files = QDir(covers).entryList({"*.jpg", "*.jpeg", "*.png"}, QDir::Files);
+   for (const QString& file : files) {
+       ThumbnailCache::shared().load(covers + file, coverSize);
+   }
+}
+
+}
 
 int main(int argc, char *argv[]) {
+   StartupTimeline::instance().mark("main");  // Starts the startup clock
    QApplication app(argc, argv);    // Initializing QT App
 
+   QCommandLineParser parser;
+   parser.addHelpOption();
+   QCommandLineOption timelineOption("startup-timeline", "Print how long each startup phase took.");
+   parser.addOption(timelineOption);
+   parser.process(app);
+   const bool dumpTimeline = parser.isSet(timelineOption);
 
-   // Add my global styles
-   app.setStyleSheet(R"(
-       * {
-           outline: none;  /* Removes ugly focused rectangles from ALL objects */
-       }
-       QWidget {
-           outline: none;
-       }
-       QPushButton {
-           outline: none;
-       }
-       QLabel {
-           outline: none;
-           background: none;  /* Removes any background or focused rectangle */
-       }
-       QLineEdit {
-           outline: none;
-       }
-   )");
+   // Install my application theme (colors, fonts and widget roles)
+   {
+       StartupTimeline::Phase phase("theme");
+       Theme::apply(app);
+   }
   
    // Create main container
    QStackedWidget mainWindow;  // Manages stacked multiple windows
    mainWindow.setWindowTitle("BMCC E-Store");  // Title of my main window
-   mainWindow.setStyleSheet(  // Style of my main window
-       "QStackedWidget {"
-       "   background-color: white;"
-       "   outline: none;"
-       "}"
-   );
   
    // Create authenticator object to handle my login&registration
    Authenticator* authenticator = new Authenticator();
-   DatabaseManager* dbManager = new DatabaseManager();
+   // Opened and migrated on a worker thread below, not here
+   DatabaseManager* dbManager = new DatabaseManager(nullptr, false);
   
    // Create login and registration windows
-   LoginWindow* loginWindow = new LoginWindow(authenticator);  // My Login INterface
-   RegistrationWindow* registrationWindow = new RegistrationWindow(authenticator); // My registration interface
-   MainShopWindow* shopWindow = new MainShopWindow(authenticator, dbManager, "");  // My main shop interface
+   LoginWindow* loginWindow = nullptr;
+   RegistrationWindow* registrationWindow = nullptr;
+   {
+       StartupTimeline::Phase phase("login window");
+       loginWindow = new LoginWindow(authenticator);  // My Login INterface
+       registrationWindow = new RegistrationWindow(authenticator); // My registration interface
+   }
+   // My main shop interface, built once the database is ready
+   MainShopWindow* shopWindow = nullptr;
+   QString pendingEmail;  // Set if the user logs in before the shop window exists
   
    // Add windows to stack -> the mainWindow container
    mainWindow.addWidget(loginWindow);   // Adds login window to the stack
    mainWindow.addWidget(registrationWindow);    // Adds registration window to the stack
-   mainWindow.addWidget(shopWindow);    // Adds main shop window to the stack
   
    // Connect signals for switching between windows
    // This connection hands transition from login to register
@@ -131,9 +155,8 @@ int main(int argc, char *argv[]) {
        mainWindow.setCurrentWidget(loginWindow);
    });
 
-   // Add connection for successful login
-    QObject::connect(loginWindow, &LoginWindow::loginSuccessful, 
-        [&](const QString& email) {
+   // Fades from the login window into the shop
+    std::function<void(const QString&)> enterShop = [&](const QString& email) {
             // Disable windows during transition
             loginWindow->setEnabled(false);
             shopWindow->setEnabled(false);
@@ -163,45 +186,127 @@ int main(int argc, char *argv[]) {
             });
             // Start my fade out
             fadeOut->start(QAbstractAnimation::DeleteWhenStopped);
-        });
+        };
 
-    // Add connection for logout with same animation style, switches from shop window to login
-    QObject::connect(shopWindow, &MainShopWindow::logoutRequested, [&]() {
-        // Disable both windows user interactions during transition
-        // Makes it not look like a chunky animation
-        shopWindow->setEnabled(false);
-        loginWindow->setEnabled(false);
-        // Fade out animation for shop window
-        QPropertyAnimation *fadeOut = new QPropertyAnimation(shopWindow, "windowOpacity");
-        fadeOut->setDuration(200);
-        fadeOut->setStartValue(1.0);
-        fadeOut->setEndValue(0.0);
+   // Add connection for successful login
+    QObject::connect(loginWindow, &LoginWindow::loginSuccessful, [&](const QString& email) {
+        if (!shopWindow) {
+            // Still loading; keep the login window disabled and enter once it is built
+            pendingEmail = email;
+            loginWindow->setEnabled(false);
+            return;
+        }
+        enterShop(email);
+    });
+
+   // Startup work that has to finish before the timeline is printed:
+   // the first login paint, the shop window and the image preload
+   int startupTasks = 3;
+   auto startupTaskDone = [&]() {
+       if (--startupTasks == 0 && dumpTimeline) {
+           qInfo().noquote() << "Startup timeline:\n" + StartupTimeline::instance().report();
+       }
+   };
+
+   // Widgets can only be built on the GUI thread, so the shop window is
+   // built here once the worker has the database ready
+   auto buildShop = [&](bool databaseReady) {
+       if (!databaseReady) {
+           qDebug() << "Database setup failed, the shop will show an empty catalog";
+       }
+       {
+           StartupTimeline::Phase phase("shop window");
+           shopWindow = new MainShopWindow(authenticator, dbManager, "");
+       }
+       mainWindow.addWidget(shopWindow);    // Adds main shop window to the stack
+
+        // Add connection for logout with same animation style, switches from shop window to login
+        QObject::connect(shopWindow, &MainShopWindow::logoutRequested, [&]() {
+            // Disable both windows user interactions during transition
+            // Makes it not look like a chunky animation
+            shopWindow->setEnabled(false);
+            loginWindow->setEnabled(false);
+            // Fade out animation for shop window
+            QPropertyAnimation *fadeOut = new QPropertyAnimation(shopWindow, "windowOpacity");
+            fadeOut->setDuration(200);
+            fadeOut->setStartValue(1.0);
+            fadeOut->setEndValue(0.0);
         
-        // Switch to login window with animation
-        QObject::connect(fadeOut, &QPropertyAnimation::finished, [&]() {
-            mainWindow.setCurrentWidget(loginWindow);
-            loginWindow->setWindowOpacity(0.0);
-            // Fade in animation for login window
-            QPropertyAnimation *fadeIn = new QPropertyAnimation(loginWindow, "windowOpacity");
-            fadeIn->setDuration(200);
-            fadeIn->setStartValue(0.0);
-            fadeIn->setEndValue(1.0);
-            // Allows interaction again after animation is completed
-            QObject::connect(fadeIn, &QPropertyAnimation::finished, [&]() {
-                shopWindow->setEnabled(true);
-                loginWindow->setEnabled(true);
+            // Switch to login window with animation
+            QObject::connect(fadeOut, &QPropertyAnimation::finished, [&]() {
+                mainWindow.setCurrentWidget(loginWindow);
+                loginWindow->setWindowOpacity(0.0);
+                // Fade in animation for login window
+                QPropertyAnimation *fadeIn = new QPropertyAnimation(loginWindow, "windowOpacity");
+                fadeIn->setDuration(200);
+                fadeIn->setStartValue(0.0);
+                fadeIn->setEndValue(1.0);
+                // Allows interaction again after animation is completed
+                QObject::connect(fadeIn, &QPropertyAnimation::finished, [&]() {
+                    shopWindow->setEnabled(true);
+                    loginWindow->setEnabled(true);
+                });
+                // Start my fade in
+                fadeIn->start(QAbstractAnimation::DeleteWhenStopped);
             });
-            // Start my fade in
-            fadeIn->start(QAbstractAnimation::DeleteWhenStopped);
+            // Start my fade out
+            fadeOut->start(QAbstractAnimation::DeleteWhenStopped);
         });
-        // Start my fade out
-        fadeOut->start(QAbstractAnimation::DeleteWhenStopped);
-    });
+
+       StartupTimeline::instance().mark("shop ready");
+       startupTaskDone();
+       if (!pendingEmail.isEmpty()) {
+           loginWindow->setEnabled(true);  // enterShop disables it again for the fade
+           enterShop(std::exchange(pendingEmail, QString()));
+       }
+   };
+
+   // Database open, migrations and catalog load run beside the image decoding,
+   // both while the login window is already up
+   QThreadPool::globalInstance()->start([&]() {
+       bool ready = false;
+       {
+           StartupTimeline::Phase phase("database");
+           ready = dbManager->initializeDatabase();
+       }
+       QMetaObject::invokeMethod(&mainWindow, [&buildShop, ready]() { buildShop(ready); }, Qt::QueuedConnection);
+   });
+   QThreadPool::globalInstance()->start([&]() {
+       preloadImages();
+       QMetaObject::invokeMethod(&mainWindow, startupTaskDone, Qt::QueuedConnection);
+   });
+
+   // A remembered user goes straight to the shop; the token is checked while
+   // the database and images above are still loading
+   if (authenticator->hasRememberedUser()) {
+       loginWindow->setResuming(true);
+       const int resumePhase = StartupTimeline::instance().begin("resume session");
+       authenticator->resumeRememberedSession(loginWindow, [&, resumePhase](const QString& email) {
+           StartupTimeline::instance().end(resumePhase);
+           loginWindow->setResuming(false);
+           if (email.isEmpty()) {
+               return;  // Expired or revoked, log in as usual
+           }
+           if (!shopWindow) {
+               pendingEmail = email;  // Entered as soon as the shop window is built
+               loginWindow->setEnabled(false);
+               return;
+           }
+           enterShop(email);
+       });
+   }
   
    mainWindow.setMinimumSize(1400, 800);  // Minimum size of main window
    mainWindow.resize(1400, 900);          // Initial size of mainwindow
    mainWindow.show(); // Display main window
+   // Interactive once the first event loop pass has painted the login window
+   QTimer::singleShot(0, [&]() {
+       StartupTimeline::instance().mark("login interactive");
+       startupTaskDone();
+   });
   
-   return app.exec(); // Entering my main event loop
+   const int result = app.exec(); // Entering my main event loop
+   QThreadPool::globalInstance()->waitForDone();
+   return result;
 }
 
@@ -0,0 +1,60 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include "auth/database_manager.h"
+#include "auth/roster_provisioner.h"
+#include "database/database_manager.h"
+
+// Creates the accounts of a semester's student roster in one run, e.g.
+//   provision_roster fall_roster.csv --passwords-out fall_passwords.csv
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Create student accounts from a roster CSV "
+                                     "(email,major,semester_level[,initial_password]).");
+    parser.addHelpOption();
+    parser.addPositionalArgument("roster", "Roster CSV file.");
+    QCommandLineOption passwordsOption("passwords-out",
+        "Where to write email,password for rows without an initial password "
+        "(default: <roster>.passwords.csv).", "file");
+    parser.addOption(passwordsOption);
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 1) {
+        parser.showHelp(1);
+    }
+
+    QFile roster(args.first());
+    if (!roster.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qCritical().noquote() << "Cannot read" << roster.fileName() << ":" << roster.errorString();
+        return 1;
+    }
+    QFile passwordsFile(parser.isSet(passwordsOption) ? parser.value(passwordsOption)
+                                                      : roster.fileName() + ".passwords.csv");
+    if (!passwordsFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qCritical().noquote() << "Cannot write" << passwordsFile.fileName() << ":" << passwordsFile.errorString();
+        return 1;
+    }
+    QTextStream passwords(&passwordsFile);
+
+    DatabaseManager dbManager;  // Creates the student_profiles table if needed
+    AuthDatabaseManager credentials;
+    RosterProvisioner provisioner(&credentials, &dbManager);
+    const RosterProvisioner::Report report = provisioner.run(&roster, &passwords);
+
+    QTextStream out(stdout);
+    for (const RosterProvisioner::Rejected& rejected : report.rejected) {
+        out << "line " << rejected.line << ": " << rejected.email << ": " << rejected.reason << '\n';
+    }
+    out << report.rows << " rows, " << report.created << " accounts created, "
+        << report.rejected.size() << " rejected in " << report.batches << " batches\n";
+    out << QString("%1 s, %2 rows/s\n").arg(report.seconds, 0, 'f', 2).arg(report.rowsPerSecond(), 0, 'f', 0);
+    if (passwordsFile.size() > 0) {
+        out << "Generated passwords: " << passwordsFile.fileName() << '\n';
+    }
+    return report.rejected.isEmpty() ? 0 : 2;
+}
@@ -0,0 +1,174 @@
+#include "ui/card_frame.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QPixmapCache>
+#include <QEnterEvent>
+#include <QVector>
+#include <qdrawutil.h>
+
+CardFrame::CardFrame(Shadow shadow, int cornerRadius, QWidget* parent)
+    : QWidget(parent)
+    , shadowStyle(shadow)
+    , radius(cornerRadius)
+    , background(Qt::white)
+    , border(0xE0, 0xE0, 0xE0)
+    , hovered(false)
+{
+    // Reserve room around the card so the shadow is painted inside our own rect
+    ShadowSpec spec = specFor(shadowStyle);
+    setContentsMargins(spec.blurRadius,
+                       qMax(0, spec.blurRadius - spec.offsetY),
+                       spec.blurRadius,
+                       spec.blurRadius + spec.offsetY);
+}
+
+void CardFrame::setCornerRadius(int cornerRadius) {
+    radius = cornerRadius;
+    update();
+}
+
+void CardFrame::setBackgroundColor(const QColor& color) {
+    background = color;
+    update();
+}
+
+void CardFrame::setBorderColor(const QColor& color) {
+    border = color;
+    update();
+}
+
+void CardFrame::setHoverColor(const QColor& color) {
+    hover = color;
+    setAttribute(Qt::WA_Hover, color.isValid());
+    update();
+}
+
+void CardFrame::setFixedCardSize(int width, int height) {
+    QMargins m = contentsMargins();
+    setFixedSize(width + m.left() + m.right(), height + m.top() + m.bottom());
+}
+
+QRect CardFrame::cardRect() const {
+    return contentsRect();
+}
+
+CardFrame::ShadowSpec CardFrame::specFor(Shadow shadow) {
+    switch (shadow) {
+    case Shadow::Medium: return {15, 50, 2};
+    case Shadow::Large:  return {20, 50, 5};
+    case Shadow::Small:
+    default:             return {10, 30, 2};
+    }
+}
+
+// Renders a small rounded rectangle and blurs its alpha with three box blur
+// passes, which is close enough to the gaussian QGraphicsDropShadowEffect uses
+QImage CardFrame::blurredRoundedRect(const ShadowSpec& spec, int cornerRadius) {
+    const int margin = spec.blurRadius;
+    const int corner = margin + cornerRadius;
+    const int side = corner * 2 + 1;
+
+    QVector<float> alpha(side * side, 0.0f);
+    {
+        QImage mask(side, side, QImage::Format_Alpha8);
+        mask.fill(0);
+        QPainter painter(&mask);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::black);
+        painter.drawRoundedRect(QRectF(margin, margin, cornerRadius * 2 + 1, cornerRadius * 2 + 1),
+                                cornerRadius, cornerRadius);
+        painter.end();
+        for (int y = 0; y < side; ++y) {
+            const uchar* line = mask.constScanLine(y);
+            for (int x = 0; x < side; ++x) {
+                alpha[y * side + x] = line[x] / 255.0f;
+            }
+        }
+    }
+
+    const int boxRadius = qMax(1, spec.blurRadius / 3);
+    QVector<float> scratch(side * side);
+    for (int pass = 0; pass < 3; ++pass) {
+        // Horizontal pass
+        for (int y = 0; y < side; ++y) {
+            for (int x = 0; x < side; ++x) {
+                float sum = 0.0f;
+                for (int k = -boxRadius; k <= boxRadius; ++k) {
+                    int sx = x + k;
+                    if (sx >= 0 && sx < side) sum += alpha[y * side + sx];
+                }
+                scratch[y * side + x] = sum / (boxRadius * 2 + 1);
+            }
+        }
+        // Vertical pass
+        for (int y = 0; y < side; ++y) {
+            for (int x = 0; x < side; ++x) {
+                float sum = 0.0f;
+                for (int k = -boxRadius; k <= boxRadius; ++k) {
+                    int sy = y + k;
+                    if (sy >= 0 && sy < side) sum += scratch[sy * side + x];
+                }
+                alpha[y * side + x] = sum / (boxRadius * 2 + 1);
+            }
+        }
+    }
+
+    QImage image(side, side, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < side; ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < side; ++x) {
+            int a = qBound(0, int(alpha[y * side + x] * spec.alpha + 0.5f), 255);
+            line[x] = qPremultiply(qRgba(0, 0, 0, a));
+        }
+    }
+    return image;
+}
+
+QPixmap CardFrame::shadowPixmap(Shadow shadow, int cornerRadius) {
+    const QString key = QString("card_shadow_%1_%2").arg(int(shadow)).arg(cornerRadius);
+    QPixmap pixmap;
+    if (!QPixmapCache::find(key, &pixmap)) {
+        pixmap = QPixmap::fromImage(blurredRoundedRect(specFor(shadow), cornerRadius));
+        QPixmapCache::insert(key, pixmap);
+    }
+    return pixmap;
+}
+
+void CardFrame::paintShadow(QPainter& painter, const QRect& cardRect, Shadow shadow, int cornerRadius) {
+    ShadowSpec spec = specFor(shadow);
+    const int corner = spec.blurRadius + cornerRadius;
+    QRect target = cardRect.adjusted(-spec.blurRadius, -spec.blurRadius, spec.blurRadius, spec.blurRadius)
+                           .translated(0, spec.offsetY);
+    // Corners are drawn 1:1, edges and center are stretched from single pixel strips
+    qDrawBorderPixmap(&painter, target, QMargins(corner, corner, corner, corner),
+                      shadowPixmap(shadow, cornerRadius));
+}
+
+void CardFrame::paintEvent(QPaintEvent*) {
+    QPainter painter(this);
+    QRect card = cardRect();
+
+    paintShadow(painter, card, shadowStyle, radius);
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setBrush(hovered && hover.isValid() ? hover : background);
+    if (border.alpha() > 0) {
+        painter.setPen(QPen(border, 1));
+    } else {
+        painter.setPen(Qt::NoPen);
+    }
+    painter.drawRoundedRect(QRectF(card).adjusted(0.5, 0.5, -0.5, -0.5), radius, radius);
+}
+
+void CardFrame::enterEvent(QEnterEvent* event) {
+    hovered = true;
+    if (hover.isValid()) update();
+    QWidget::enterEvent(event);
+}
+
+void CardFrame::leaveEvent(QEvent* event) {
+    hovered = false;
+    if (hover.isValid()) update();
+    QWidget::leaveEvent(event);
+}
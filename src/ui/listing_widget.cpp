@@ -0,0 +1,429 @@
+#include "ui/listing_widget.h"
+#include "ui/theme.h"
+#include "utils/config.h"
+#include "utils/thumbnail_cache.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QCoreApplication>
+#include <QSignalBlocker>
+#include <QPixmap>
+#include <QDebug>
+
+// Skips the relayout QLabel::setText triggers when the text is unchanged
+static void setTextIfChanged(QLabel* label, const QString& text) {
+    if (label->text() != text) {
+        label->setText(text);
+    }
+}
+
+static QString priceText(double price) {
+    return QString("$%1").arg(price, 0, 'f', 2);
+}
+
+static QString detailsText(const Textbook& book) {
+    return QString("%1 - %2 %3 (LEC: %4)")
+        .arg(book.department)
+        .arg(book.courseCategory)
+        .arg(book.courseCode)
+        .arg(book.lec);
+}
+
+static QString courseText(const Textbook& book) {
+    return QString("%1 %2 (LEC: %3)")
+        .arg(book.courseCategory)
+        .arg(book.courseCode)
+        .arg(book.lec);
+}
+
+// Cover decoding is the expensive part of a row, so it only happens when the path changes
+static bool imageChanged(bool& loaded, QString& shownPath, const QString& path) {
+    if (loaded && shownPath == path) {
+        return false;
+    }
+    loaded = true;
+    shownPath = path;
+    return true;
+}
+
+CartRow::CartRow(const QPair<Textbook, int>& item, QWidget* parent)
+    : CardFrame(CardFrame::Shadow::Small, 15, parent)
+    , imageLoaded(false)
+{
+    QHBoxLayout* layout = new QHBoxLayout(this);
+    layout->setSpacing(20);
+    layout->setContentsMargins(20, 20, 20, 20);
+
+    // Image
+    imageLabel = new QLabel;
+    imageLabel->setFixedSize(100, 120);
+    Theme::setRole(imageLabel, Theme::Role::ImageFrame);
+    imageLabel->setAlignment(Qt::AlignCenter);
+
+    // Info section
+    QVBoxLayout* infoLayout = new QVBoxLayout;
+
+    titleLabel = new QLabel;
+    Theme::setRole(titleLabel, Theme::Role::CardTitle);
+    titleLabel->setWordWrap(true);
+
+    detailsLabel = new QLabel;
+    Theme::setRole(detailsLabel, Theme::Role::Muted);
+
+    infoLayout->addWidget(titleLabel);
+    infoLayout->addWidget(detailsLabel);
+    infoLayout->addStretch();
+
+    // Price and controls section
+    QVBoxLayout* controlsLayout = new QVBoxLayout;
+    controlsLayout->setAlignment(Qt::AlignRight);
+
+    priceLabel = new QLabel;
+    Theme::setRole(priceLabel, Theme::Role::Price);
+
+    QHBoxLayout* quantityLayout = new QHBoxLayout;
+    QLabel* quantityLabel = new QLabel("Quantity:");
+    Theme::setRole(quantityLabel, Theme::Role::Muted);
+
+    quantityBox = new QSpinBox;
+    quantityBox->setRange(1, 99);
+
+    quantityLayout->addWidget(quantityLabel);
+    quantityLayout->addWidget(quantityBox);
+
+    QPushButton* removeButton = new QPushButton("Remove");
+    Theme::setRole(removeButton, Theme::Role::DangerLink);
+
+    controlsLayout->addWidget(priceLabel);
+    controlsLayout->addLayout(quantityLayout);
+    controlsLayout->addWidget(removeButton);
+    controlsLayout->addStretch();
+
+    layout->addWidget(imageLabel);
+    layout->addLayout(infoLayout, 1);
+    layout->addLayout(controlsLayout);
+
+    connect(quantityBox, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, [this](int value) { emit quantityChanged(id, value); });
+    connect(removeButton, &QPushButton::clicked,
+            this, [this]() { emit removeRequested(id); });
+
+    setItem(item);
+}
+
+void CartRow::setItem(const QPair<Textbook, int>& item) {
+    const Textbook& book = item.first;
+    id = book.productId;
+
+    if (imageChanged(imageLoaded, imagePath, book.getImagePath())) {
+        QPixmap image(imagePath);
+        imageLabel->setPixmap(image.isNull() ? QPixmap()
+            : image.scaled(100, 120, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    }
+    setTextIfChanged(titleLabel, book.title);
+    setTextIfChanged(detailsLabel, detailsText(book));
+    setTextIfChanged(priceLabel, priceText(book.price * item.second));
+
+    if (quantityBox->value() != item.second) {
+        QSignalBlocker blocker(quantityBox);  // Not a user edit
+        quantityBox->setValue(item.second);
+    }
+}
+
+WishlistRow::WishlistRow(const Textbook& book, QWidget* parent)
+    : CardFrame(CardFrame::Shadow::Small, 15, parent)
+    , imageLoaded(false)
+{
+    QHBoxLayout* layout = new QHBoxLayout(this);
+    layout->setSpacing(20);
+    layout->setContentsMargins(20, 20, 20, 20);
+
+    // Image
+    imageLabel = new QLabel;
+    imageLabel->setFixedSize(100, 120);
+    Theme::setRole(imageLabel, Theme::Role::ImageFrame);
+    imageLabel->setAlignment(Qt::AlignCenter);
+
+    // Info section
+    QVBoxLayout* infoLayout = new QVBoxLayout;
+
+    titleLabel = new QLabel;
+    Theme::setRole(titleLabel, Theme::Role::CardTitle);
+    titleLabel->setWordWrap(true);
+
+    detailsLabel = new QLabel;
+    Theme::setRole(detailsLabel, Theme::Role::Muted);
+
+    priceLabel = new QLabel;
+    Theme::setRole(priceLabel, Theme::Role::Price);
+
+    infoLayout->addWidget(titleLabel);
+    infoLayout->addWidget(detailsLabel);
+    infoLayout->addWidget(priceLabel);
+    infoLayout->addStretch();
+
+    // Buttons section
+    QVBoxLayout* buttonsLayout = new QVBoxLayout;
+    buttonsLayout->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+    QPushButton* moveToCartButton = new QPushButton("Move to Cart");
+    Theme::setRole(moveToCartButton, Theme::Role::PrimaryButton);
+
+    QPushButton* removeButton = new QPushButton("Remove");
+    Theme::setRole(removeButton, Theme::Role::DangerLink);
+
+    buttonsLayout->addWidget(moveToCartButton);
+    buttonsLayout->addWidget(removeButton);
+    buttonsLayout->addStretch();
+
+    layout->addWidget(imageLabel);
+    layout->addLayout(infoLayout, 1);
+    layout->addLayout(buttonsLayout);
+
+    connect(moveToCartButton, &QPushButton::clicked,
+            this, [this]() { emit moveToCartRequested(id); });
+    connect(removeButton, &QPushButton::clicked,
+            this, [this]() { emit removeRequested(id); });
+
+    setItem(book);
+}
+
+void WishlistRow::setItem(const Textbook& book) {
+    id = book.productId;
+
+    if (imageChanged(imageLoaded, imagePath, book.getImagePath())) {
+        QPixmap image(imagePath);
+        imageLabel->setPixmap(image.isNull() ? QPixmap()
+            : image.scaled(100, 120, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    }
+    setTextIfChanged(titleLabel, book.title);
+    setTextIfChanged(detailsLabel, detailsText(book));
+    setTextIfChanged(priceLabel, priceText(book.price));
+}
+
+BookCard::BookCard(const Textbook& book, QWidget* parent)
+    : CardFrame(CardFrame::Shadow::Medium, 8, parent)
+    , imageLoaded(false)
+    , inWishlist(false)
+{
+    setFixedCardSize(400, 400);
+
+    QVBoxLayout* cardLayout = new QVBoxLayout(this);
+    cardLayout->setSpacing(10);
+    cardLayout->setContentsMargins(15, 15, 15, 15);
+
+    imageLabel = new QLabel(this);
+    imageLabel->setAlignment(Qt::AlignCenter);
+
+    // Title
+    titleLabel = new QLabel;
+    titleLabel->setWordWrap(true);
+    Theme::setRole(titleLabel, Theme::Role::CardTitle);
+    titleLabel->setAlignment(Qt::AlignCenter);
+
+    // Course info
+    courseLabel = new QLabel;
+    Theme::setRole(courseLabel, Theme::Role::Muted);
+    courseLabel->setAlignment(Qt::AlignCenter);
+
+    // Price
+    priceLabel = new QLabel;
+    Theme::setRole(priceLabel, Theme::Role::Price);
+    priceLabel->setAlignment(Qt::AlignCenter);
+
+    QHBoxLayout* buttonLayout = new QHBoxLayout;
+
+    cartButton = new QPushButton;
+    cartButton->setIcon(QIcon(QCoreApplication::applicationDirPath() + "/../assets/images/nav/cartIcon.png"));
+    cartButton->setIconSize(QSize(24, 24));
+    cartButton->setToolTip("Add to cart");
+    Theme::setRole(cartButton, Theme::Role::RoundIconButton);
+
+    wishlistButton = new QPushButton;
+    wishlistButton->setIcon(QIcon(QCoreApplication::applicationDirPath() + "/../assets/images/nav/wishlistIcon.png"));
+    wishlistButton->setIconSize(QSize(24, 24));
+    wishlistButton->setToolTip("Add to wishlist");
+    Theme::setRole(wishlistButton, Theme::Role::RoundIconButton);
+
+    buttonLayout->addWidget(cartButton);
+    buttonLayout->addWidget(wishlistButton);
+    buttonLayout->setAlignment(Qt::AlignRight);
+
+    connect(cartButton, &QPushButton::clicked,
+            this, [this]() { emit addToCartRequested(id); });
+    connect(wishlistButton, &QPushButton::clicked, this, [this]() {
+        if (inWishlist) {
+            emit removeFromWishlistRequested(id);
+        } else {
+            emit addToWishlistRequested(id);
+        }
+    });
+
+    cardLayout->addWidget(imageLabel);
+    cardLayout->addWidget(titleLabel);
+    cardLayout->addWidget(courseLabel);
+    cardLayout->addWidget(priceLabel);
+    cardLayout->addLayout(buttonLayout);
+    cardLayout->addStretch();
+
+    setItem(book);
+}
+
+void BookCard::setItem(const Textbook& book) {
+    id = book.productId;
+
+    if (imageChanged(imageLoaded, imagePath, book.getImagePath())) {
+        // Book image with fallback to default, already decoded if the page was prefetched
+        const QSize coverSize(Config::CARD_COVER_WIDTH, Config::CARD_COVER_HEIGHT);
+        QImage bookImage = ThumbnailCache::shared().load(imagePath, coverSize);
+        if (bookImage.isNull()) {
+            QString defaultPath = QCoreApplication::applicationDirPath() + "/../assets/images/textbooks/default_book.jpg";
+            bookImage = ThumbnailCache::shared().load(defaultPath, coverSize);
+            if (bookImage.isNull()) {
+                qDebug() << "Failed to load image from:" << imagePath;
+                qDebug() << "And failed to load default image from:" << defaultPath;
+            }
+        }
+        imageLabel->setPixmap(QPixmap::fromImage(bookImage));
+    }
+    setTextIfChanged(titleLabel, book.title);
+    setTextIfChanged(courseLabel, courseText(book));
+    setTextIfChanged(priceLabel, priceText(book.price));
+}
+
+void BookCard::setMembership(bool inCart, bool inWishlist) {
+    if (Theme::isSelected(cartButton) != inCart) {
+        Theme::setSelected(cartButton, inCart);
+        cartButton->setToolTip(inCart ? "In your cart, click to raise the quantity" : "Add to cart");
+    }
+    if (this->inWishlist != inWishlist) {
+        this->inWishlist = inWishlist;
+        Theme::setSelected(wishlistButton, inWishlist);
+        wishlistButton->setToolTip(inWishlist ? "Remove from wishlist" : "Add to wishlist");
+    }
+}
+
+RecommendedRow::RecommendedRow(const Textbook& book, QWidget* parent)
+    : CardFrame(CardFrame::Shadow::Small, 10, parent)
+    , imageLoaded(false)
+{
+    setHoverColor(Theme::lightSage);
+
+    QHBoxLayout* layout = new QHBoxLayout(this);
+    layout->setSpacing(20);
+    layout->setContentsMargins(15, 15, 15, 15);
+
+    // Book image
+    imageLabel = new QLabel;
+    imageLabel->setFixedSize(80, 100);
+    imageLabel->setAlignment(Qt::AlignCenter);
+
+    // Book information
+    QWidget* infoWidget = new QWidget;
+    QVBoxLayout* infoLayout = new QVBoxLayout(infoWidget);
+    infoLayout->setSpacing(5);
+
+    titleLabel = new QLabel;
+    Theme::setRole(titleLabel, Theme::Role::CardTitle);
+    titleLabel->setWordWrap(true);
+
+    courseLabel = new QLabel;
+    Theme::setRole(courseLabel, Theme::Role::Muted);
+
+    priceLabel = new QLabel;
+    Theme::setRole(priceLabel, Theme::Role::Price);
+
+    infoLayout->addWidget(titleLabel);
+    infoLayout->addWidget(courseLabel);
+    infoLayout->addWidget(priceLabel);
+    infoLayout->addStretch();
+
+    // Add to cart button
+    cartButton = new QPushButton("Add to Cart");
+    Theme::setRole(cartButton, Theme::Role::PrimaryButton);
+    cartButton->setFixedWidth(120);
+
+    connect(cartButton, &QPushButton::clicked,
+            this, [this]() { emit addToCartRequested(id); });
+
+    layout->addWidget(imageLabel);
+    layout->addWidget(infoWidget, 1);
+    layout->addWidget(cartButton);
+
+    setItem(book);
+}
+
+void RecommendedRow::setItem(const Textbook& book) {
+    id = book.productId;
+
+    if (imageChanged(imageLoaded, imagePath, book.getImagePath())) {
+        QPixmap image(imagePath);
+        if (!image.isNull()) {
+            imageLabel->setPixmap(image.scaled(80, 100, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+            Theme::setRole(imageLabel, Theme::Role::None);
+        } else {
+            imageLabel->setText("No Image");
+            Theme::setRole(imageLabel, Theme::Role::ImageFrame);
+        }
+    }
+    setTextIfChanged(titleLabel, book.title);
+    setTextIfChanged(courseLabel, courseText(book));
+    setTextIfChanged(priceLabel, priceText(book.price));
+}
+
+void RecommendedRow::setInCart(bool inCart) {
+    const QString text = inCart ? "In Cart" : "Add to Cart";
+    if (cartButton->text() != text) {
+        cartButton->setText(text);
+    }
+}
+
+ListingCard::ListingCard(const Textbook& book, QWidget* parent)
+    : CardFrame(CardFrame::Shadow::Medium, 15, parent)
+    , imageLoaded(false)
+{
+    setFixedCardSize(300, 350);
+
+    QVBoxLayout* cardLayout = new QVBoxLayout(this);
+    cardLayout->setSpacing(10);
+    cardLayout->setContentsMargins(15, 15, 15, 15);
+
+    // Image
+    imageLabel = new QLabel;
+    imageLabel->setFixedSize(250, 200);
+    imageLabel->setAlignment(Qt::AlignCenter);
+    Theme::setRole(imageLabel, Theme::Role::ImageFrame);
+
+    // Title
+    titleLabel = new QLabel;
+    Theme::setRole(titleLabel, Theme::Role::CardTitle);
+
+    // Price
+    priceLabel = new QLabel;
+    Theme::setRole(priceLabel, Theme::Role::Price);
+
+    // Status, listings have no status column yet
+    statusLabel = new QLabel("Active");
+    Theme::setRole(statusLabel, Theme::Role::Success);
+
+    cardLayout->addWidget(imageLabel);
+    cardLayout->addWidget(titleLabel);
+    cardLayout->addWidget(priceLabel);
+    cardLayout->addWidget(statusLabel);
+
+    setItem(book);
+}
+
+void ListingCard::setItem(const Textbook& book) {
+    id = book.productId;
+
+    if (imageChanged(imageLoaded, imagePath, book.getImagePath())) {
+        if (!imagePath.isEmpty()) {
+            QPixmap pixmap(imagePath);
+            imageLabel->setPixmap(pixmap.scaled(250, 200, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+        } else {
+            imageLabel->setText("No Image");
+        }
+    }
+    setTextIfChanged(titleLabel, book.title);
+    setTextIfChanged(priceLabel, priceText(book.price));
+}
@@ -1,9 +1,10 @@
 #include "ui/login_window.h"
+#include "ui/card_frame.h"  // Shadowed card container for the form
+#include "ui/theme.h"  // Widget roles for the application theme
 #include <QMessageBox>  // Creates simple dialog boxes for displaying messages
 #include <QVBoxLayout>  // Arranges widgets in a vertical column
-#include <QGraphicsEffect>  // For modifying my widgets appearence like CSS
+#include <QGraphicsEffect>  // For the fade in opacity effect
 #include <QPropertyAnimation>  // Smooth time based transtions for objects
-#include <QGraphicsDropShadowEffect>  // Enables drop shadow effects for widgets
 
 // Define functions from LoginWindow class
 
@@ -22,38 +23,12 @@ void LoginWindow::setupUI() {
     // Main layout for the my login window
     auto mainLayout = new QVBoxLayout(this);
 
-    // Define color scheme
-    QString sageGreen = "#9CAF88";  // Sage green
-    QString darkBlue = "#2C3E50";   // Dark blue
-    QString lightSage = "#E8F0E3";  // Light sage for hover effects
-
     // Creates a container widget for the login form
-    // Uses shadow effect
-    auto formContainer = new QWidget(this);
+    // Card with a drop shadow
+    auto formContainer = new CardFrame(CardFrame::Shadow::Large, 15, this);
     auto formLayout = new QVBoxLayout(formContainer);  // Layout for my widgets inside the container
-    formContainer->setFixedWidth(450); // Fixes width of container to 450 pixels
-    formContainer->setStyleSheet(
-    "QWidget {"
-        "   background-color: white;"  // Background is white
-        "   border-radius: 15px;"   // Rounded container corners
-        "   border: 1px solid #E0E0E0;"  // Solid gray border
-        "   outline: none;"  // Removes ugly outline
-        "}"
-        "QLabel {"
-        "   background: transparent;"  // Transparent background for my text
-        "   border: none;"  // removed borders
-        "}"
-        "QPushButton {"
-        "   outline: none;"  // Removes ugly outline from buttons
-    "}"
-   );
-  
-    // Adds a drop shadow effect to the form container
-    QGraphicsDropShadowEffect* shadowEffect = new QGraphicsDropShadowEffect;
-    shadowEffect->setBlurRadius(20);  // Makes shadow not harsh
-    shadowEffect->setColor(QColor(0, 0, 0, 50));  // Black Shadow color, 50% opacity
-    shadowEffect->setOffset(0, 5);  // Offset for shadow
-    formContainer->setGraphicsEffect(shadowEffect);  // Applies shadow to container
+    QMargins shadowMargins = formContainer->contentsMargins();
+    formContainer->setFixedWidth(450 + shadowMargins.left() + shadowMargins.right()); // Card itself is 450 pixels wide
 
     // Sets widget allignment and spacing
     formLayout->setAlignment(Qt::AlignCenter);  
@@ -62,106 +37,46 @@ void LoginWindow::setupUI() {
   
    // Title for form
    auto titleLabel = new QLabel("Welcome Back", this);
-   titleLabel->setStyleSheet(
-       "font-size: 32px;"
-       "font-weight: bold;"
-       "color: " + darkBlue + ";"
-       "margin: 20px;"
-       "font-family: -apple-system, BlinkMacSystemFont;"
-   );
+   Theme::setRole(titleLabel, Theme::Role::HeroTitle);
+   titleLabel->setContentsMargins(20, 20, 20, 20);
    titleLabel->setAlignment(Qt::AlignCenter);
   
    // Subtitle
    auto subtitleLabel = new QLabel("Sign in to BMCC E-Store", this);
-   subtitleLabel->setStyleSheet(
-       "font-size: 16px;"
-       "color: #666;"
-       "margin-bottom: 20px;"
-   );
+   Theme::setRole(subtitleLabel, Theme::Role::Subtitle);
+   subtitleLabel->setContentsMargins(0, 0, 0, 20);
    subtitleLabel->setAlignment(Qt::AlignCenter);  // Center aligned
   
-   // Input fields styling
-   QString inputStyle =
-       "QLineEdit {"
-       "   padding: 12px;"
-       "   font-size: 14px;"
-       "   border: 2px solid #E0E0E0;"
-       "   border-radius: 8px;"
-       "   background-color: white;"
-       "   outline: none;"
-       "}"
-       "QLineEdit:focus {"
-       "   border: 2px solid " + sageGreen + ";"
-       "   background-color: " + lightSage + ";"
-       "   outline: none;"
-       "}";
-  
    // Email input field
    auto emailLabel = new QLabel("Email Address", this);
-   emailLabel->setStyleSheet("font-weight: bold; color: " + darkBlue + ";");
+   Theme::setRole(emailLabel, Theme::Role::FieldLabel);
    emailInput = new QLineEdit(this);
    emailInput->setPlaceholderText("your.email@stu.bmcc.cuny.edu");
    emailInput->setMinimumWidth(350);
-   emailInput->setStyleSheet(inputStyle);  // Apply my defined input style
   
    // Password input field
    auto passwordLabel = new QLabel("Password", this);
-   passwordLabel->setStyleSheet("font-weight: bold; color: " + darkBlue + ";");
+   Theme::setRole(passwordLabel, Theme::Role::FieldLabel);
    passwordInput = new QLineEdit(this);
    passwordInput->setPlaceholderText("Enter your password");
    passwordInput->setEchoMode(QLineEdit::Password);
-   passwordInput->setStyleSheet(inputStyle);  // Apply my defined input style
   
-   // Login button with animation effect and hover
+   // Skips this window on the next launch
+   rememberCheck = new QCheckBox("Keep me signed in", this);
+
+   // Login button, sage with dark blue hover
    loginButton = new QPushButton("Sign In", this);
-   loginButton->setStyleSheet(
-       "QPushButton {"
-       "   background-color: " + sageGreen + ";"
-       "   color: white;"
-       "   padding: 12px;"
-       "   font-size: 16px;"
-       "   font-weight: bold;"
-       "   border-radius: 8px;"
-       "   min-width: 200px;"
-       "   border: none;"
-       "   transition: all 0.3s ease-in-out;"
-       "}"
-       "QPushButton:hover {"
-       "   background-color: " + darkBlue + ";"
-       "   transform: scale(1.05);"
-       "}"
-       "QPushButton:pressed {"
-       "   background-color: " + sageGreen + ";"
-       "   transform: scale(0.95);"
-       "}"
-   );
+   Theme::setRole(loginButton, Theme::Role::PrimaryButton);
+   loginButton->setMinimumWidth(200);
   
-   // Register button with animation effect and hover
+   // Register link, underlined on hover
    registerButton = new QPushButton("New to BMCC E-Store? Create an account", this);
-   registerButton->setStyleSheet(
-       "QPushButton {"
-       "   color: " + darkBlue + ";"
-       "   text-decoration: none;"
-       "   font-size: 14px;"
-       "   border: none;"
-       "   background: transparent;"
-       "   padding: 5px;"
-       "}"
-       "QPushButton:hover {"
-       "   color: " + sageGreen + ";"
-       "   text-decoration: underline;"
-       "}"
-   );
-   registerButton->setCursor(Qt::PointingHandCursor);  // Adds hand cursor onhover
+   Theme::setRole(registerButton, Theme::Role::LinkButton);
   
    // Status label for error messages
    statusLabel = new QLabel(this);
-   statusLabel->setStyleSheet(
-       "color: #FF5252;"
-       "font-size: 14px;"
-       "padding: 10px;"
-       "border-radius: 5px;"
-   );
+   Theme::setRole(statusLabel, Theme::Role::Error);
+   statusLabel->setContentsMargins(10, 10, 10, 10);
    statusLabel->setAlignment(Qt::AlignCenter);
   
    // Add widgets to form layout with proper spacing
@@ -175,7 +90,9 @@ void LoginWindow::setupUI() {
   
    formLayout->addWidget(passwordLabel);  // Adds my password text label
    formLayout->addWidget(passwordInput);  // Adds my password input
-   formLayout->addSpacing(20);   // Adds spacing
+   formLayout->addSpacing(10);   // Adds spacing
+   formLayout->addWidget(rememberCheck);  // Adds keep me signed in
+   formLayout->addSpacing(10);   // Adds spacing
   
    formLayout->addWidget(loginButton, 0, Qt::AlignCenter);  // Adds login button
    formLayout->addSpacing(10);  // Adds spacing
@@ -212,15 +129,32 @@ void LoginWindow::setupConnections() {
 void LoginWindow::handleLoginButton() {
    QString email = emailInput->text();     // User-inputted email
    QString password = passwordInput->text();     // User-inputted password
-   QString errorMsg;   // Error messages
   
-   if (authenticator->login(email, password, errorMsg)) {
-       statusLabel->clear();
-       emit loginSuccessful(email);    // Emits the loginSuccessful signal with the email.
-   } else {
-       statusLabel->setText(errorMsg);
-       statusLabel->setStyleSheet("color: red;");
-   }
+   // Password is checked on a worker thread, the window stays responsive meanwhile
+   loginButton->setEnabled(false);
+   statusLabel->setText("Signing in...");
+   authenticator->login(email, password, this, [this, email](bool ok, const QString& errorMsg) {
+       loginButton->setEnabled(true);
+       if (ok) {
+           statusLabel->clear();
+           if (rememberCheck->isChecked()) {
+               authenticator->rememberUser(email);
+           }
+           emit loginSuccessful(email);    // Emits the loginSuccessful signal with the email.
+       } else {
+           statusLabel->setText(errorMsg);
+       }
+   });
+}
+
+
+// Locks the form and says why while a saved session is being checked
+void LoginWindow::setResuming(bool resuming) {
+   emailInput->setEnabled(!resuming);
+   passwordInput->setEnabled(!resuming);
+   loginButton->setEnabled(!resuming);
+   rememberCheck->setEnabled(!resuming);
+   statusLabel->setText(resuming ? "Signing you back in..." : "");
 }
 
 
@@ -2,6 +2,11 @@
 #include "ui/wishlist_page.h"
 #include "ui/cart_page.h"
 #include "ui/textbook_page.h"
+#include "ui/card_frame.h"
+#include "ui/theme.h"
+#include "ui/page_manager.h"
+#include "utils/config.h"
+#include "utils/thumbnail_cache.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QDir>
@@ -11,50 +16,107 @@
 #include <QFrame>
 #include <QScrollArea>
 #include <QPropertyAnimation>
-#include <QGraphicsDropShadowEffect>
 #include <QGridLayout>
 #include <QCoreApplication>
 #include <QDebug>
 #include <QMouseEvent>
+#include <QCompleter>
+#include <QStringListModel>
+#include <QElapsedTimer>
 
 
 
 MainShopWindow::MainShopWindow(Authenticator* auth, DatabaseManager* db, const QString& userEmail, QWidget *parent)
     : QMainWindow(parent)
+    , pages(nullptr)
     , authenticator(auth)
-    , dbManager(db)
     , currentUserEmail(userEmail)
     , contentStack(nullptr)
+    , dbManager(db)
+    , profile(new UserProfile(db, this))
+    , profileMenu(nullptr)
     , navBar(nullptr)
     , searchBar(nullptr)
+    , searchCompleter(nullptr)
+    , suggestionModel(nullptr)
     , cartButton(nullptr)
     , wishlistButton(nullptr)
+    , cartBadge(nullptr)
+    , wishlistBadge(nullptr)
     , textbooksButton(nullptr)
     , furnitureButton(nullptr)
     , electronicsButton(nullptr)
     , suppliesButton(nullptr)
     , clothingButton(nullptr)
-    , profilePage(nullptr)
-    , profileMenu(nullptr)
-    , wishlistPage(nullptr)
 {
     setupUI();
     handleFeaturedTabChange(0);
+    buildSuggestionIndex();
+
+    connect(profile, &UserProfile::changed, this, &MainShopWindow::updateBadges);
+    profile->load(currentUserEmail);
+
+    // Keep suggestions current as listings are posted
+    connect(dbManager, &DatabaseManager::textbookAdded, this, [this](const Textbook& book) {
+        for (const QString& term : book.searchTerms()) {
+            suggestions.insert(term);
+        }
+    });
+}
+
+void MainShopWindow::buildSuggestionIndex() {
+    QElapsedTimer timer;
+    timer.start();
+    suggestions.clear();
+    const QVector<QPair<Textbook, int>> books = dbManager->getTextbookPopularity();
+    for (const auto& book : books) {
+        // Books in more carts and wishlists rank higher; every listing counts once
+        for (const QString& term : book.first.searchTerms()) {
+            suggestions.insert(term, 1 + book.second);
+        }
+    }
+    qDebug() << "Suggestion index:" << suggestions.size() << "entries,"
+             << suggestions.nodeCount() << "nodes in" << timer.elapsed() << "ms";
+}
+
+void MainShopWindow::updateSuggestions(const QString& text) {
+    // The line edit shows the popup right after textEdited, so the model only
+    // has to hold this prefix's suggestions by then
+    suggestionModel->setStringList(text.trimmed().isEmpty() ? QStringList() : suggestions.complete(text));
 }
 
 // Update UI elements that display the email
 void MainShopWindow::setUserEmail(const QString& email) {
     currentUserEmail = email;
-    if (profilePage) {
-        delete profilePage;
-        profilePage = nullptr;
+    profile->load(email);  // The one read behind the badges and the profile page
+    pages->evict("Profile");  // Rebuilt for the new user when next shown
+}
+
+QLabel* MainShopWindow::createBadge(QPushButton* button) {
+    QLabel* badge = new QLabel(button);
+    Theme::setRole(badge, Theme::Role::Badge);
+    badge->setAttribute(Qt::WA_TransparentForMouseEvents);
+    badge->hide();
+    return badge;
+}
+
+void MainShopWindow::updateBadges() {
+    const QPair<QLabel*, int> badges[] = {
+        {cartBadge, profile->cartCount()},
+        {wishlistBadge, profile->wishlist().size()},
+    };
+    for (const auto& badge : badges) {
+        QLabel* label = badge.first;
+        label->setText(badge.second > 99 ? "99+" : QString::number(badge.second));
+        label->adjustSize();
+        label->move(label->parentWidget()->width() - label->width(), 0);
+        label->setVisible(badge.second > 0);
     }
 }
 
 void MainShopWindow::setupUI() {
     // Set window properties
     setMinimumSize(1200, 800);
-    setStyleSheet("QMainWindow { background-color: " + white + "; }");
 
     // Create central widget with proper initialization
     QWidget* centralWidget = new QWidget(this);
@@ -70,7 +132,6 @@ void MainShopWindow::setupUI() {
 
     // Create stacked widgets for homepage and category content
     homepageStack = new QStackedWidget(this);
-    contentStack = new QStackedWidget(this);
 
     // Create and setup homepage
     QWidget* homePage = new QWidget;
@@ -91,23 +152,20 @@ void MainShopWindow::setupUI() {
     
     homepageStack->addWidget(homePage);
 
-    // Setup category pages
-    setupContentArea();
-
     // Add both stacks to main layout
     mainLayout->addWidget(homepageStack);
-    mainLayout->addWidget(contentStack);
+    setupContentArea();
 
     // Initially show homepage and hide category content
     homepageStack->show();
     contentStack->hide();
 }
 
-QPushButton* MainShopWindow::createPreNavButton(const QString& iconPath, const QString& style) {
+QPushButton* MainShopWindow::createPreNavButton(const QString& iconPath) {
    QPushButton* button = new QPushButton;
    button->setIcon(QIcon(iconPath));
    button->setIconSize(QSize(20, 20));
-   button->setStyleSheet(style);
+   Theme::setRole(button, Theme::Role::IconButton);
    return button;
 }
 
@@ -115,13 +173,7 @@ void MainShopWindow::setupNavBar() {
     // Create immovable toolbar for navigation
     navBar = new QToolBar(this);
     navBar->setMovable(false);
-    navBar->setStyleSheet(
-        "QToolBar {"
-        "    background-color: " + white + ";"
-        "    border-bottom: 1px solid #E0E0E0;"
-        "    padding: 5px 20px;"
-        "}"
-    );
+    navBar->setContentsMargins(20, 5, 20, 5);
 
     // Create container for logo and search
     QWidget* leftContainer = new QWidget;
@@ -131,12 +183,8 @@ void MainShopWindow::setupNavBar() {
 
     // Logo
     logoLabel = new QLabel("BMCC E-Store", this);
-    logoLabel->setStyleSheet(
-        "font-size: 22px;"
-        "font-weight: bold;"
-        "color: " + darkBlue + ";"
-        "padding: 0 20px;"
-    );
+    Theme::setRole(logoLabel, Theme::Role::Logo);
+    logoLabel->setContentsMargins(20, 0, 20, 0);
     logoLabel->setCursor(Qt::PointingHandCursor);
     logoLabel->installEventFilter(this);
     leftLayout->addWidget(logoLabel);
@@ -145,19 +193,19 @@ void MainShopWindow::setupNavBar() {
     searchBar = new QLineEdit(this);
     searchBar->setPlaceholderText("Search products...");
     searchBar->setFixedWidth(300);
-    searchBar->setStyleSheet(
-        "QLineEdit {"
-        "    padding: 8px 15px;"
-        "    border: 1px solid #E0E0E0;"
-        "    border-radius: 20px;"
-        "    font-size: 14px;"
-        "    background-color: " + white + ";"
-        "}"
-        "QLineEdit:focus {"
-        "    border-color: " + sageGreen + ";"
-        "}"
-    );
+    Theme::setRole(searchBar, Theme::Role::SearchField);
     leftLayout->addWidget(searchBar);
+    connect(searchBar, &QLineEdit::textChanged, this, &MainShopWindow::handleSearch);
+
+    // Typeahead suggestions come from the in-memory index, never from SQL;
+    // the model is already filtered so the completer shows it as is
+    suggestionModel = new QStringListModel(this);
+    searchCompleter = new QCompleter(suggestionModel, this);
+    searchCompleter->setCaseSensitivity(Qt::CaseInsensitive);
+    searchCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    searchCompleter->setMaxVisibleItems(SuggestionIndex::TOP_K);
+    searchBar->setCompleter(searchCompleter);
+    connect(searchBar, &QLineEdit::textEdited, this, &MainShopWindow::updateSuggestions);
 
     navBar->addWidget(leftContainer);
 
@@ -177,22 +225,7 @@ void MainShopWindow::setupNavBar() {
     wishlistButton = new QPushButton(this);
     profileButton = new QPushButton(this);
 
-    // Common button style
-    const QString buttonStyle = 
-        "QPushButton {"
-        "    border: none;"
-        "    padding: 8px;"
-        "    border-radius: 20px;"
-        "    background-color: transparent;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: " + lightSage + ";"
-        "}"
-        "QPushButton:pressed {"
-        "    background-color: " + sageGreen + ";"
-        "}";
-
-    // Set icons and styles
+    // Set icons
     cartButton->setIcon(QIcon(QCoreApplication::applicationDirPath() + "/../assets/images/nav/cartIcon.png"));
     wishlistButton->setIcon(QIcon(QCoreApplication::applicationDirPath() + "/../assets/images/nav/wishlistIcon.png"));
     profileButton->setIcon(QIcon(QCoreApplication::applicationDirPath() + "/../assets/images/nav/profileIcon.png"));
@@ -202,10 +235,10 @@ void MainShopWindow::setupNavBar() {
     wishlistButton->setIconSize(QSize(24, 24));
     profileButton->setIconSize(QSize(24, 24));
 
-    // Apply styles
-    cartButton->setStyleSheet(buttonStyle);
-    wishlistButton->setStyleSheet(buttonStyle);
-    profileButton->setStyleSheet(buttonStyle);
+    // Apply roles
+    Theme::setRole(cartButton, Theme::Role::IconButton);
+    Theme::setRole(wishlistButton, Theme::Role::IconButton);
+    Theme::setRole(profileButton, Theme::Role::IconButton);
 
     // Add hover effect animations
     for (QPushButton* button : {cartButton, wishlistButton, profileButton}) {
@@ -221,6 +254,9 @@ void MainShopWindow::setupNavBar() {
         button->installEventFilter(this);
     }
 
+    cartBadge = createBadge(cartButton);
+    wishlistBadge = createBadge(wishlistButton);
+
     // Add buttons to layout
     iconLayout->addWidget(cartButton);
     iconLayout->addWidget(wishlistButton);
@@ -348,15 +384,7 @@ void MainShopWindow::setupNavBar() {
 // Implement the showProfile method
 void MainShopWindow::showProfile() {
     qDebug() << "showProfile called in MainShopWindow";
-    if (!profilePage) {
-        qDebug() << "Creating new profile page";
-        profilePage = new ProfilePage(authenticator, dbManager, currentUserEmail, this);
-        contentStack->addWidget(profilePage);
-    }
-    
-    homepageStack->hide();
-    contentStack->show();
-    contentStack->setCurrentWidget(profilePage);
+    showPage("Profile");
     profileMenu->hide();
     qDebug() << "Profile page should be visible now";
 }
@@ -393,6 +421,9 @@ void MainShopWindow::toggleProfileMenu() {
 
 
 bool MainShopWindow::eventFilter(QObject* watched, QEvent* event) {
+    if (event->type() == QEvent::Resize && (watched == cartButton || watched == wishlistButton)) {
+        updateBadges();  // Keeps the badges in the corner as the buttons are laid out
+    }
     if (event->type() == QEvent::MouseButtonPress) {
         // Add this block to handle logo clicks
         if (watched == logoLabel) {
@@ -449,7 +480,7 @@ void MainShopWindow::setupCategoryBar() {
     for(int i = 0; i < buttons.size() - 1; i++) {
         QFrame* divider = new QFrame;
         divider->setFrameShape(QFrame::VLine);
-        divider->setStyleSheet("background-color: #E0E0E0;");
+        Theme::setRole(divider, Theme::Role::Divider);
         divider->setFixedWidth(1);
         categoryLayout->addWidget(divider);
     }
@@ -468,121 +499,90 @@ void MainShopWindow::setupCategoryBar() {
 
 void MainShopWindow::setupContentArea() {
     contentStack = new QStackedWidget(this);
-    
-    // Add category pages
-    contentStack->addWidget(createCategoryWidget("Textbooks"));
-    contentStack->addWidget(createCategoryWidget("Furniture"));
-    contentStack->addWidget(createCategoryWidget("Electronics"));
-    contentStack->addWidget(createCategoryWidget("School Supplies"));
-    contentStack->addWidget(createCategoryWidget("Clothing"));
+    pages = new PageManager(contentStack, Config::PAGE_CACHE_SIZE, this);
+
+    // Nothing is built until it is first shown. The catalog keeps its
+    // filters, search results and prefetched pages, so it is never evicted.
+    pages->registerPage("Textbooks", [this]() { return new TextbookPage(dbManager, profile, this); }, true);
+    for (const QString& category : {"Furniture", "Electronics", "School Supplies", "Clothing"}) {
+        pages->registerPage(category, [this, category]() { return createCategoryWidget(category); });
+    }
+    pages->registerPage("Cart", [this]() {
+        CartPage* cartPage = new CartPage(dbManager, currentUserEmail, this);
+        connect(cartPage, &CartPage::checkoutCompleted, this, [this, cartPage]() {
+            // Return to homepage after successful checkout
+            cartPage->refreshCart();
+            showHomepage();
+        });
+        return cartPage;
+    });
+    pages->registerPage("Wishlist", [this]() {
+        WishlistPage* wishlistPage = new WishlistPage(dbManager, currentUserEmail, this);
+        connect(wishlistPage, &WishlistPage::continueShoppingClicked, this, &MainShopWindow::showHomepage);
+        return wishlistPage;
+    });
+    pages->registerPage("Profile", [this]() {
+        return new ProfilePage(authenticator, dbManager, profile, currentUserEmail, this);
+    });
 
     // Add to central widget's layout
     centralWidget()->layout()->addWidget(contentStack);
 }
 
+QWidget* MainShopWindow::showPage(const QString& name) {
+    homepageStack->hide();
+    contentStack->show();
+    return pages->show(name);
+}
+
 void MainShopWindow::setupStyles() {
     // Additional styles can be added here
 }
 
 void MainShopWindow::applyButtonStyle(QPushButton* button, bool isCategory) {
     // Apply consistent styling to buttons with size variation based on type
-    button->setStyleSheet(
-        "QPushButton {"
-        "    color: " + darkBlue + ";"
-        "    background: none;"
-        "    border: none;"
-        "    padding: " + (isCategory ? "8px 15px" : "10px 20px") + ";"  // Different padding for categories
-        "    font-size: 14px;"
-        "    font-weight: " + (isCategory ? "normal" : "bold") + ";"  // Bold for non-category buttons
-        "    min-width: " + (isCategory ? "80px" : "100px") + ";"  // Smaller width for category buttons
-        "    transition: all 0.3s;"  // Smooth transition for all changes
-        "}"
-        "QPushButton:hover {"
-        "    color: " + sageGreen + ";"  // Change text color on hover
-        "    background-color: " + lightSage + ";"  // Subtle background on hover
-        "}"
-    );
+    Theme::setRole(button, Theme::Role::NavButton);
+    if (!isCategory) {
+        button->setMinimumWidth(100);
+    }
 }
 
 
 QPushButton* MainShopWindow::createNavButton(const QString& iconPath, const QString& text) {
     QPushButton* button = new QPushButton(text);
-    button->setStyleSheet(
-        "QPushButton {"
-        "   color: " + darkBlue + ";"
-        "   border: none;"
-        "   padding: 8px 15px;"
-        "   font-size: 14px;"
-        "   border-radius: 15px;"
-        "   background-image: " + iconPath + ";"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: " + lightSage + ";"
-        "}"
-    );
+    Theme::setRole(button, Theme::Role::NavButton);
+    if (!iconPath.isEmpty()) {
+        button->setIcon(QIcon(iconPath));
+    }
     return button;
 }
 
 QPushButton* MainShopWindow::createCategoryButton(const QString& text) {
     QPushButton* button = new QPushButton(text);
-    button->setStyleSheet(
-        "QPushButton {"
-        "    color: " + darkBlue + ";"
-        "    background-color: white;"
-        "    border: 2px solid " + sageGreen + ";"
-        "    padding: 10px 20px;"
-        "    font-size: 14px;"
-        "    border-radius: 20px;"
-        "    min-width: 120px;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: " + sageGreen + ";"
-        "    color: white;"
-        "}"
-        "QPushButton:pressed {"
-        "    background-color: " + darkBlue + ";"
-        "    border-color: " + darkBlue + ";"
-        "}"
-    );
+    Theme::setRole(button, Theme::Role::SecondaryButton);
+    button->setMinimumWidth(120);
     return button;
 }
 
 QWidget* MainShopWindow::createCategoryWidget(const QString& category) {
     if (category == "Textbooks") {
-        return new TextbookPage(dbManager, this);
+        return new TextbookPage(dbManager, profile, this);
     }
     QWidget* widget = new QWidget;
     QVBoxLayout* layout = new QVBoxLayout(widget);
     
     QLabel* title = new QLabel(category);
-    title->setStyleSheet(
-        "font-size: 24px;"
-        "font-weight: bold;"
-        "color: " + darkBlue + ";"
-        "margin-bottom: 20px;"
-    );
+    Theme::setRole(title, Theme::Role::SectionTitle);
     layout->addWidget(title);
+    layout->addSpacing(20);
 
     QGridLayout* grid = new QGridLayout;
     grid->setSpacing(20);
 
     // Add sample product cards
     for (int i = 0; i < 12; i++) {
-        QWidget* card = new QWidget;
+        CardFrame* card = new CardFrame(CardFrame::Shadow::Small, 10);
         card->setMinimumSize(250, 300);
-        card->setStyleSheet(
-            "QWidget {"
-            "    background-color: white;"
-            "    border: 1px solid #E0E0E0;"
-            "    border-radius: 10px;"
-            "}"
-        );
-        
-        QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect;
-        shadow->setBlurRadius(10);
-        shadow->setColor(QColor(0, 0, 0, 30));
-        shadow->setOffset(0, 2);
-        card->setGraphicsEffect(shadow);
 
         grid->addWidget(card, i / 4, i % 4);
     }
@@ -600,13 +600,9 @@ QWidget* MainShopWindow::createCategoryWidget(const QString& category) {
 }
 
 void MainShopWindow::refreshTextbookPage() {
-    // Find and refresh the TextbookPage
-    for (int i = 0; i < contentStack->count(); ++i) {
-        TextbookPage* textbookPage = qobject_cast<TextbookPage*>(contentStack->widget(i));
-        if (textbookPage) {
-            textbookPage->refreshRecommendations();
-            break;
-        }
+    // Not built yet means it will load fresh recommendations anyway
+    if (TextbookPage* textbookPage = pages->page<TextbookPage>("Textbooks")) {
+        textbookPage->refreshRecommendations();
     }
 }
 
@@ -619,11 +615,12 @@ void MainShopWindow::setupHeroSection(QVBoxLayout* parentLayout) {
 
     QLabel* heroImage = new QLabel;
     QString imagePath = QCoreApplication::applicationDirPath() + "/../assets/images/home/school.jpg";
-    QPixmap image(imagePath);
+    // Usually decoded already by the startup preload
+    QImage image = ThumbnailCache::shared().load(imagePath, QSize(1400, 400));
     
     if (!image.isNull()) {
         // Fill the entire width while maintaining aspect ratio
-        heroImage->setPixmap(image.scaled(1400, 400, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+        heroImage->setPixmap(QPixmap::fromImage(image));
         heroImage->setAlignment(Qt::AlignCenter);
     } else {
         qDebug() << "Image not found at:" << imagePath;
@@ -642,14 +639,10 @@ void MainShopWindow::setupFeaturedSection(QVBoxLayout* parentLayout) {
 
     // Title
     QLabel* title = new QLabel("Featured Products");
-    title->setStyleSheet(
-        "font-size: 32px;"
-        "font-weight: bold;"
-        "color: " + darkBlue + ";"
-        "margin-bottom: 30px;"
-    );
+    Theme::setRole(title, Theme::Role::HeroTitle);
     title->setAlignment(Qt::AlignCenter);
     featuredLayout->addWidget(title);
+    featuredLayout->addSpacing(30);
 
     // Tabs container
     QWidget* tabsWidget = new QWidget;
@@ -662,19 +655,7 @@ void MainShopWindow::setupFeaturedSection(QVBoxLayout* parentLayout) {
     for (int i = 0; i < categories.size(); ++i) {
         QPushButton* tab = new QPushButton(categories[i]);
         tab->setFixedWidth(500);  // Fixed width for each tab
-        tab->setStyleSheet(
-            "QPushButton {"
-            "    border: none;"
-            "    padding: 15px;"
-            "    font-size: 16px;"
-            "    color: " + darkBlue + ";"
-            "    background: none;"
-            "    text-align: center;"
-            "}"
-            "QPushButton:hover {"
-            "    color: " + sageGreen + ";"
-            "}"
-        );
+        Theme::setRole(tab, Theme::Role::TabButton);
         connect(tab, &QPushButton::clicked, this, [this, i]() { handleFeaturedTabChange(i); });
         featureTabButtons.append(tab);
         tabsLayout->addWidget(tab);
@@ -698,7 +679,7 @@ void MainShopWindow::setupFeaturedSection(QVBoxLayout* parentLayout) {
         QFrame* line = new QFrame;
         line->setFixedHeight(3);
         line->setFixedWidth(500);  // Match tab width
-        line->setStyleSheet("background-color: " + lightGrey + ";");
+        Theme::setRole(line, Theme::Role::Indicator);
         featureIndicators.append(line);
         indicatorLayout->addWidget(line);
     }
@@ -714,26 +695,12 @@ void MainShopWindow::setupFeaturedSection(QVBoxLayout* parentLayout) {
 }
 
 void MainShopWindow::handleFeaturedTabChange(int index) {
-    // Change the tab line color
+    // Highlight the selected tab and its indicator line
     for (int i = 0; i < featureIndicators.size(); ++i) {
-        featureIndicators[i]->setStyleSheet(
-            "background-color: " + (i == index ? darkGrey : lightGrey) + ";"
-        );
+        Theme::setSelected(featureIndicators[i], i == index);
     }
-
-    // Update tab text label color
     for (int i = 0; i < featureTabButtons.size(); ++i) {
-        featureTabButtons[i]->setStyleSheet(
-            "QPushButton {"
-            "    border: none;"
-            "    padding: 15px;"
-            "    font-size: 16px;"
-            "    color: " + (i == index ? sageGreen : darkBlue) + ";"
-            "}"
-            "QPushButton:hover {"
-            "    color: " + sageGreen + ";"
-            "}"
-        );
+        Theme::setSelected(featureTabButtons[i], i == index);
     }
 }
 
@@ -742,119 +709,67 @@ void MainShopWindow::handleFeaturedTabChange(int index) {
 
 // Implement slot methods
 void MainShopWindow::handleSearch() {
-    // Implement search functionality
+    // Live search runs on the Textbooks page, which debounces the keystrokes
+    if (!searchBar->text().isEmpty() && (!contentStack->isVisible() || pages->current() != "Textbooks")) {
+        showTextbooks();
+    }
+    if (TextbookPage* textbookPage = pages->page<TextbookPage>("Textbooks")) {
+        textbookPage->setSearchText(searchBar->text());
+    }
 }
 
 void MainShopWindow::showTextbooks() {
-    homepageStack->hide();
-    contentStack->show();
-    TextbookPage* textbookPage = qobject_cast<TextbookPage*>(contentStack->widget(0));
-    if (textbookPage) {
-        textbookPage->setUserEmail(currentUserEmail);
-    }
-    contentStack->setCurrentIndex(0);
+    TextbookPage* textbookPage = qobject_cast<TextbookPage*>(showPage("Textbooks"));
+    textbookPage->setUserEmail(currentUserEmail);
 }
 
 void MainShopWindow::showFurniture() {
-    homepageStack->hide();
-    contentStack->show();
-    contentStack->setCurrentIndex(1);
+    showPage("Furniture");
 }
 
 void MainShopWindow::showElectronics() {
-    homepageStack->hide();
-    contentStack->show();
-    contentStack->setCurrentIndex(2);
+    showPage("Electronics");
 }
 
 void MainShopWindow::showSchoolSupplies() {
-    homepageStack->hide();
-    contentStack->show();
-    contentStack->setCurrentIndex(3);
+    showPage("School Supplies");
 }
 
 void MainShopWindow::showClothing() {
-    homepageStack->hide();
-    contentStack->show();
-    contentStack->setCurrentIndex(4);
+    showPage("Clothing");
 }
 
-void MainShopWindow::showCart() {
-    if (!cartPage) {
-        cartPage = new CartPage(dbManager, currentUserEmail, this);
-        contentStack->addWidget(cartPage);
+// Fades from the page that was on screen to the one just shown
+static void fadeBetween(QWidget* from, QWidget* to) {
+    if (from && from != to) {
+        QPropertyAnimation* fadeOut = new QPropertyAnimation(from, "windowOpacity");
+        fadeOut->setDuration(200);
+        fadeOut->setStartValue(1.0);
+        fadeOut->setEndValue(0.0);
+        fadeOut->start(QAbstractAnimation::DeleteWhenStopped);
     }
-    
-    cartPage->setUserEmail(currentUserEmail);
-    cartPage->refreshCart();
-    
-    homepageStack->hide();
-    contentStack->show();
-
-    // Fade transition to cart page
-    QWidget* currentWidget = contentStack->currentWidget();
-    cartPage->setWindowOpacity(0.0);
-    contentStack->setCurrentWidget(cartPage);
 
-    // Fade out current widget
-    QPropertyAnimation* fadeOut = new QPropertyAnimation(currentWidget, "windowOpacity");
-    fadeOut->setDuration(200);
-    fadeOut->setStartValue(1.0);
-    fadeOut->setEndValue(0.0);
-    
-    // Fade in cart page
-    QPropertyAnimation* fadeIn = new QPropertyAnimation(cartPage, "windowOpacity");
+    QPropertyAnimation* fadeIn = new QPropertyAnimation(to, "windowOpacity");
     fadeIn->setDuration(200);
     fadeIn->setStartValue(0.0);
     fadeIn->setEndValue(1.0);
-
-    // Connect cart signals
-    connect(cartPage, &CartPage::checkoutCompleted, [this]() {
-        // Return to homepage after successful checkout
-        cartPage->refreshCart();
-        showHomepage();
-    });
-
-    fadeOut->start(QAbstractAnimation::DeleteWhenStopped);
     fadeIn->start(QAbstractAnimation::DeleteWhenStopped);
 }
 
+void MainShopWindow::showCart() {
+    QWidget* previous = contentStack->currentWidget();
+    CartPage* cartPage = qobject_cast<CartPage*>(showPage("Cart"));
+    cartPage->setUserEmail(currentUserEmail);
+    cartPage->refreshCart();
+    fadeBetween(previous, cartPage);
+}
+
 void MainShopWindow::showWishlist() {
-    if (!wishlistPage) {
-        wishlistPage = new WishlistPage(dbManager, currentUserEmail, this);
-        contentStack->addWidget(wishlistPage);
-        
-        // Connect continue shopping signal
-        connect(wishlistPage, &WishlistPage::continueShoppingClicked, [this]() {
-            showHomepage();
-        });
-    }
-    
+    QWidget* previous = contentStack->currentWidget();
+    WishlistPage* wishlistPage = qobject_cast<WishlistPage*>(showPage("Wishlist"));
     wishlistPage->setUserEmail(currentUserEmail);
     wishlistPage->refreshWishlist();
-    
-    homepageStack->hide();
-    contentStack->show();
-
-    // Fade transition to wishlist page
-    QWidget* currentWidget = contentStack->currentWidget();
-    wishlistPage->setWindowOpacity(0.0);
-    contentStack->setCurrentWidget(wishlistPage);
-
-    // Fade out current widget
-    QPropertyAnimation* fadeOut = new QPropertyAnimation(currentWidget, "windowOpacity");
-    fadeOut->setDuration(200);
-    fadeOut->setStartValue(1.0);
-    fadeOut->setEndValue(0.0);
-    
-    // Fade in wishlist page
-    QPropertyAnimation* fadeIn = new QPropertyAnimation(wishlistPage, "windowOpacity");
-    fadeIn->setDuration(200);
-    fadeIn->setStartValue(0.0);
-    fadeIn->setEndValue(1.0);
-
-    fadeOut->start(QAbstractAnimation::DeleteWhenStopped);
-    fadeIn->start(QAbstractAnimation::DeleteWhenStopped);
+    fadeBetween(previous, wishlistPage);
 }
 
 void MainShopWindow::handleLogout() {
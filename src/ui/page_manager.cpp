@@ -0,0 +1,70 @@
+#include "ui/page_manager.h"
+#include <QStackedWidget>
+#include <QElapsedTimer>
+#include <QDebug>
+
+PageManager::PageManager(QStackedWidget* stack, int capacity, QObject* parent)
+    : QObject(parent)
+    , stack(stack)
+    , capacity(capacity)
+{}
+
+void PageManager::registerPage(const QString& name, Factory factory, bool pinned) {
+    entries.insert(name, Entry{std::move(factory), pinned});
+}
+
+QWidget* PageManager::show(const QString& name) {
+    auto entry = entries.constFind(name);
+    if (entry == entries.constEnd()) {
+        qDebug() << "No page registered as" << name;
+        return nullptr;
+    }
+
+    QWidget* widget = built.value(name);
+    if (!widget) {
+        QElapsedTimer timer;
+        timer.start();
+        widget = entry->factory();
+        stack->addWidget(widget);
+        const double ms = timer.nsecsElapsed() / 1e6;
+
+        BuildStats& stats = buildStats[name];
+        ++stats.builds;
+        stats.lastMs = ms;
+        stats.totalMs += ms;
+        built.insert(name, widget);
+        qDebug() << "Built page" << name << "in" << QString::number(ms, 'f', 1) << "ms"
+                 << "(build" << stats.builds << ")";
+        emit pageBuilt(name, widget, ms);
+    }
+
+    stack->setCurrentWidget(widget);
+    if (!entry->pinned) {
+        recent.removeOne(name);
+        recent.append(name);
+        evictOverCapacity();
+    }
+    return widget;
+}
+
+QString PageManager::current() const {
+    return built.key(stack->currentWidget());
+}
+
+void PageManager::evict(const QString& name) {
+    QWidget* widget = built.take(name);
+    recent.removeOne(name);
+    if (widget) {
+        stack->removeWidget(widget);
+        widget->deleteLater();  // May be evicted from one of its own handlers
+    }
+}
+
+void PageManager::evictOverCapacity() {
+    // The page just shown is last, so it is never the one evicted
+    while (recent.size() > capacity) {
+        const QString oldest = recent.first();
+        qDebug() << "Evicting page" << oldest;
+        evict(oldest);
+    }
+}
@@ -1,43 +1,35 @@
 #include "ui/profile_menu.h"
+#include "ui/theme.h"
 #include <QVBoxLayout>
+#include <QPainter>
 #include <QDebug>
 
 ProfileMenu::ProfileMenu(QWidget *parent) : QWidget(parent) {
     setFixedWidth(200);
-    
-    setStyleSheet(
-        "QWidget {"
-        "    background-color: white;"
-        "    border: 1px solid #E0E0E0;"
-        "    border-radius: 8px;"
-        "}"
-    );
 
     QVBoxLayout* layout = new QVBoxLayout(this);
     layout->setSpacing(0);
-    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setContentsMargins(1, 1, 1, 1);  // Keep the items inside the border
 
     profileButton = new QPushButton("Profile", this);
     logoutButton = new QPushButton("Logout", this);
 
-    QString buttonStyle = 
-        "QPushButton {"
-        "    border: none;"
-        "    padding: 15px 20px;"
-        "    text-align: left;"
-        "    font-size: 14px;"
-        "    color: #2C3E50;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: #E8F0E3;"
-        "}";
-
-    profileButton->setStyleSheet(buttonStyle);
-    logoutButton->setStyleSheet(buttonStyle);
+    Theme::setRole(profileButton, Theme::Role::MenuItem);
+    Theme::setRole(logoutButton, Theme::Role::MenuItem);
 
     layout->addWidget(profileButton);
     layout->addWidget(logoutButton);
 
     connect(profileButton, &QPushButton::clicked, this, &ProfileMenu::profileRequested);
     connect(logoutButton, &QPushButton::clicked, this, &ProfileMenu::logoutRequested);
-}
\ No newline at end of file
+}
+
+void ProfileMenu::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    // White rounded card with a light border behind the menu items
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(Theme::borderGrey, 1));
+    painter.setBrush(Theme::white);
+    painter.drawRoundedRect(QRectF(rect()).adjusted(0.5, 0.5, -0.5, -0.5), 8, 8);
+}
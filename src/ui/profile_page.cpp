@@ -1,21 +1,25 @@
 #include "ui/profile_page.h"
+#include "ui/theme.h"
 #include "ui/mainshop_window.h"
+#include "utils/image_transcoder.h"
 #include <QScrollArea>
 #include <QGridLayout>
 #include <QFrame>
-#include <QGraphicsDropShadowEffect>
+#include "ui/card_frame.h"
 #include <QFileDialog>
 #include <QRegularExpression>
 #include <QRegularExpressionValidator>
 #include <QAbstractItemView>
 #include <QListWidget>
 
-ProfilePage::ProfilePage(Authenticator* auth, DatabaseManager* db, const QString& email, QWidget* parent)
-    : QWidget(parent), authenticator(auth), dbManager(db), userEmail(email)
+ProfilePage::ProfilePage(Authenticator* auth, DatabaseManager* db, UserProfile* profile,
+                         const QString& email, QWidget* parent)
+    : QWidget(parent), authenticator(auth), dbManager(db), profile(profile), userEmail(email)
 {
     extractNameFromEmail();
     setupUI();
     loadUserProfile();
+    refreshListings();
 }
 
 void ProfilePage::setupUI() {
@@ -24,22 +28,9 @@ void ProfilePage::setupUI() {
     mainLayout->setAlignment(Qt::AlignCenter);
     
     // Create central card widget
-    QWidget* cardWidget = new QWidget;
+    CardFrame* cardWidget = new CardFrame(CardFrame::Shadow::Large, 20);
+    cardWidget->setBorderColor(Qt::transparent);
     cardWidget->setFixedWidth(1000);
-    cardWidget->setStyleSheet(
-        "QWidget {"
-        "    background-color: white;"
-        "    border-radius: 20px;"
-        "    padding: 20px;"
-        "}"
-    );
-    
-    // Add shadow effect
-    QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect;
-    shadow->setBlurRadius(20);
-    shadow->setColor(QColor(0, 0, 0, 50));
-    shadow->setOffset(0, 5);
-    cardWidget->setGraphicsEffect(shadow);
     
     // Card layout
     QVBoxLayout* cardLayout = new QVBoxLayout(cardWidget);
@@ -52,17 +43,10 @@ void ProfilePage::setupUI() {
     headerLayout->setSpacing(10);
 
     nameLabel = new QLabel(firstName + " " + lastName);
-    nameLabel->setStyleSheet(
-        "font-size: 32px;"
-        "font-weight: bold;"
-        "color: " + darkBlue + ";"
-    );
+    Theme::setRole(nameLabel, Theme::Role::HeroTitle);
 
     emailLabel = new QLabel(userEmail);
-    emailLabel->setStyleSheet(
-        "font-size: 16px;"
-        "color: #666;"
-    );
+    Theme::setRole(emailLabel, Theme::Role::Subtitle);
 
     headerLayout->addWidget(nameLabel, 0, Qt::AlignCenter);
     headerLayout->addWidget(emailLabel, 0, Qt::AlignCenter);
@@ -77,22 +61,8 @@ void ProfilePage::setupUI() {
     QStringList sections = {"Edit Profile", "Your Listings", "Order History"};
     for (int i = 0; i < sections.size(); ++i) {
         QPushButton* btn = new QPushButton(sections[i]);
-        btn->setStyleSheet(
-            "QPushButton {"
-            "    background-color: white;"
-            "    color: " + darkBlue + ";"
-            "    border: 2px solid " + sageGreen + ";"
-            "    padding: 12px 30px;"
-            "    border-radius: 25px;"
-            "    font-size: 14px;"
-            "    min-width: 150px;"
-            "    font-weight: bold;"
-            "}"
-            "QPushButton:hover {"
-            "    background-color: " + sageGreen + ";"
-            "    color: white;"
-            "}"
-        );
+        Theme::setRole(btn, Theme::Role::SecondaryButton);
+        btn->setMinimumWidth(150);
         connect(btn, &QPushButton::clicked, this, [this, i]() { switchSection(i); });
         navLayout->addWidget(btn);
     }
@@ -114,26 +84,6 @@ QScrollArea* ProfilePage::createStyledScrollArea() {
     scrollArea->setFrameShape(QFrame::NoFrame);
     scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
-    scrollArea->setStyleSheet(
-        "QScrollArea {"
-        "    border: none;"
-        "}"
-        "QScrollBar:vertical {"
-        "    border: none;"
-        "    background: #F0F0F0;"
-        "    width: 8px;"
-        "    margin: 0px;"
-        "}"
-        "QScrollBar::handle:vertical {"
-        "    background: " + sageGreen + ";"
-        "    border-radius: 4px;"
-        "    min-height: 20px;"
-        "}"
-        "QScrollBar::add-line:vertical, QScrollBar::sub-line:vertical {"
-        "    border: none;"
-        "    background: none;"
-        "}"
-    );
     return scrollArea;
 }
 
@@ -145,17 +95,12 @@ QWidget* ProfilePage::createProfileSection() {
     layout->setContentsMargins(0, 0, 20, 0);
 
     QLabel* title = new QLabel("Edit Profile Information");
-    title->setStyleSheet(
-        "font-size: 24px;"
-        "font-weight: bold;"
-        "color: " + darkBlue + ";"
-        "margin-bottom: 20px;"
-    );
+    Theme::setRole(title, Theme::Role::SectionTitle);
     layout->addWidget(title);
 
     // Major selection
     QLabel* majorLabel = new QLabel("Major:");
-    majorLabel->setStyleSheet("font-weight: bold; color: " + darkBlue + ";");
+    Theme::setRole(majorLabel, Theme::Role::FieldLabel);
     majorCombo = new QComboBox;
     majorCombo->addItems({
         "Computer Science", 
@@ -163,23 +108,12 @@ QWidget* ProfilePage::createProfileSection() {
         "Liberal Arts", 
         "Business Administration"
     });
-    majorCombo->setStyleSheet(
-        "QComboBox {"
-        "    padding: 8px;"
-        "    border: 2px solid #E0E0E0;"
-        "    border-radius: 8px;"
-        "    background: white;"
-        "}"
-        "QComboBox:hover {"
-        "    border-color: " + sageGreen + ";"
-        "}"
-    );
     layout->addWidget(majorLabel);
     layout->addWidget(majorCombo);
 
     // Semester selection
     QLabel* semesterLabel = new QLabel("Semester Status:");
-    semesterLabel->setStyleSheet("font-weight: bold; color: " + darkBlue + ";");
+    Theme::setRole(semesterLabel, Theme::Role::FieldLabel);
     semesterCombo = new QComboBox;
     semesterCombo->addItems({
         "Lower Freshman", 
@@ -187,7 +121,6 @@ QWidget* ProfilePage::createProfileSection() {
         "Lower Sophomore", 
         "Upper Sophomore"
     });
-    semesterCombo->setStyleSheet(majorCombo->styleSheet());
     layout->addWidget(semesterLabel);
     layout->addWidget(semesterCombo);
 
@@ -212,11 +145,7 @@ QWidget* ProfilePage::createListingsSection() {
     QHBoxLayout* headerLayout = new QHBoxLayout(headerWidget);
     
     QLabel* title = new QLabel("Your Listings");
-    title->setStyleSheet(
-        "font-size: 24px;"
-        "font-weight: bold;"
-        "color: " + darkBlue + ";"
-    );
+    Theme::setRole(title, Theme::Role::SectionTitle);
     
     QPushButton* createButton = createStyledButton("+ Create New Listing", true);
     connect(createButton, &QPushButton::clicked, this, &ProfilePage::handleCreateListing);
@@ -233,13 +162,12 @@ QWidget* ProfilePage::createListingsSection() {
     listingsGrid->setSpacing(20);
     listingsGrid->setContentsMargins(0, 0, 0, 0);
 
-    // Sample listing cards
-    for (int i = 0; i < 6; i++) {
-        QWidget* card = createListingCard();
-        listingsGrid->addWidget(card, i / 2, i % 2);  // Use the member variable
-    }
-
+    listingCards = std::make_unique<RowPool<ListingCard>>(listingsGrid, 2);  // 2 cards per row
 
+    QLabel* noListingsLabel = new QLabel("You have no listings yet.", gridContainer);
+    Theme::setRole(noListingsLabel, Theme::Role::Placeholder);
+    noListingsLabel->setAlignment(Qt::AlignCenter);
+    listingCards->setPlaceholder(noListingsLabel);
 
     layout->addWidget(gridContainer);
     layout->addStretch();
@@ -252,131 +180,14 @@ QWidget* ProfilePage::createListingsSection() {
 
 QPushButton* ProfilePage::createStyledButton(const QString& text, bool isPrimary) {
     QPushButton* button = new QPushButton(text);
-    button->setStyleSheet(
-        QString("QPushButton {"
-        "    background-color: %1;"
-        "    color: %2;"
-        "    padding: 12px 25px;"
-        "    border-radius: 20px;"
-        "    font-size: 14px;"
-        "    font-weight: bold;"
-        "    border: none;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: %3;"
-        "    color: white;"
-        "}").arg(
-            isPrimary ? sageGreen : "white",
-            isPrimary ? "white" : darkBlue,
-            darkBlue
-        )
-    );
+    Theme::setRole(button, isPrimary ? Theme::Role::PrimaryButton : Theme::Role::SecondaryButton);
     return button;
 }
 
-QWidget* ProfilePage::createListingCard(const QString& title, double price, 
-                                      const QString& status, const QString& imagePath) {
-    QWidget* card = new QWidget;
-    card->setFixedSize(300, 350);
-    card->setStyleSheet(
-        "QWidget {"
-        "    background-color: white;"
-        "    border: 1px solid #E0E0E0;"
-        "    border-radius: 15px;"
-        "}"
-    );
-
-    QVBoxLayout* cardLayout = new QVBoxLayout(card);
-    cardLayout->setSpacing(10);
-    cardLayout->setContentsMargins(15, 15, 15, 15);
-
-    // Image
-    QLabel* imageLabel = new QLabel;
-    imageLabel->setFixedSize(250, 200);
-    imageLabel->setStyleSheet(
-        "background-color: " + lightSage + ";"
-        "border-radius: 10px;"
-    );
-    
-    if (!imagePath.isEmpty()) {
-        QPixmap pixmap(imagePath);
-        imageLabel->setPixmap(pixmap.scaled(250, 200, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    } else {
-        imageLabel->setAlignment(Qt::AlignCenter);
-        imageLabel->setText("No Image");
-    }
-
-    // Title
-    QLabel* titleLabel = new QLabel(title);
-    titleLabel->setStyleSheet(
-        "font-weight: bold;"
-        "font-size: 16px;"
-        "color: " + darkBlue + ";"
-    );
-
-    // Price
-    QLabel* priceLabel = new QLabel(QString("$%1").arg(price, 0, 'f', 2));
-    priceLabel->setStyleSheet(
-        "color: " + sageGreen + ";"
-        "font-size: 18px;"
-        "font-weight: bold;"
-    );
-
-    // Status
-    QLabel* statusLabel = new QLabel(status);
-    statusLabel->setStyleSheet(
-        "color: #4CAF50;"
-        "font-size: 14px;"
-    );
-
-    cardLayout->addWidget(imageLabel);
-    cardLayout->addWidget(titleLabel);
-    cardLayout->addWidget(priceLabel);
-    cardLayout->addWidget(statusLabel);
-
-    // Add shadow effect
-    QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect;
-    shadow->setBlurRadius(15);
-    shadow->setColor(QColor(0, 0, 0, 30));
-    shadow->setOffset(0, 2);
-    card->setGraphicsEffect(shadow);
-
-    return card;
-}
-
 void ProfilePage::showCreateListingDialog() {
     QDialog* dialog = new QDialog(this);
     dialog->setWindowTitle("Create New Listing");
     dialog->setFixedSize(600, 750);  // Set a fixed size that fits the screen
-    dialog->setStyleSheet(
-        "QDialog {"
-        "    background-color: white;"
-        "    border-radius: 15px;"
-        "}"
-        "QLabel {"
-        "    color: " + darkBlue + ";"
-        "    font-weight: bold;"
-        "    margin-top: 5px;"  // Reduced from 10px
-        "}"
-        "QLineEdit, QComboBox {"
-        "    padding: 8px;"     // Reduced from 10px
-        "    border: 2px solid #E0E0E0;"
-        "    border-radius: 8px;"
-        "    font-size: 14px;"
-        "    background: white;"
-        "    min-width: 200px;"
-        "}"
-        "QLineEdit:focus, QComboBox:focus {"
-        "    border-color: " + sageGreen + ";"
-        "}"
-        "QPushButton {"
-        "    padding: 8px 20px;"  // Reduced padding
-        "    border-radius: 20px;"
-        "    font-size: 14px;"
-        "    font-weight: bold;"
-        "    min-width: 120px;"
-        "}"
-    );
 
     // Make layout more compact
     QVBoxLayout* layout = new QVBoxLayout(dialog);
@@ -385,6 +196,7 @@ void ProfilePage::showCreateListingDialog() {
 
     // Department Selection
     QLabel* deptLabel = new QLabel("Department:", dialog);
+    Theme::setRole(deptLabel, Theme::Role::FieldLabel);
     QComboBox* deptCombo = new QComboBox(dialog);
     deptCombo->addItems({
         "Academic Literacy and Linguistics",
@@ -411,6 +223,7 @@ void ProfilePage::showCreateListingDialog() {
 
     // Course Section
     QLabel* sectionLabel = new QLabel("Course Section:", dialog);
+    Theme::setRole(sectionLabel, Theme::Role::FieldLabel);
     QComboBox* sectionCombo = new QComboBox;
     sectionCombo->addItems({
         "ACC", "AFL", "AFN", "ANT", "ARC", "ART", "ASL", "ASN", "BIO", 
@@ -422,21 +235,25 @@ void ProfilePage::showCreateListingDialog() {
 
     // Book Title
     QLabel* titleLabel = new QLabel("Book Title:", dialog);
+    Theme::setRole(titleLabel, Theme::Role::FieldLabel);
     QLineEdit* titleInput = new QLineEdit(dialog);
     titleInput->setPlaceholderText("Enter book title");
 
     // Course Number
     QLabel* courseLabel = new QLabel("Course Number:", dialog);
+    Theme::setRole(courseLabel, Theme::Role::FieldLabel);
     QLineEdit* courseInput = new QLineEdit(dialog);
     courseInput->setPlaceholderText("e.g., 101, 201, etc.");
 
     // LEC Code
     QLabel* lecLabel = new QLabel("LEC Code:", dialog);
+    Theme::setRole(lecLabel, Theme::Role::FieldLabel);
     QLineEdit* lecInput = new QLineEdit(dialog);
     lecInput->setPlaceholderText("e.g., 1234");
 
     // Price
     QLabel* priceLabel = new QLabel("Price ($):", dialog);
+    Theme::setRole(priceLabel, Theme::Role::FieldLabel);
     QLineEdit* priceInput = new QLineEdit(dialog);
     priceInput->setPlaceholderText("0.00");
     QDoubleValidator* validator = new QDoubleValidator(0, 9999.99, 2, priceInput);
@@ -444,17 +261,12 @@ void ProfilePage::showCreateListingDialog() {
 
     // Image Upload
     QLabel* imageLabel = new QLabel("Book Image:", dialog);
+    Theme::setRole(imageLabel, Theme::Role::FieldLabel);
     QPushButton* imageButton = new QPushButton("Upload Image", dialog);
-    imageButton->setStyleSheet(
-        "background-color: " + sageGreen + ";"
-        "color: white;"
-    );
+    Theme::setRole(imageButton, Theme::Role::PrimaryButton);
     QLabel* imagePreview = new QLabel(dialog);
     imagePreview->setFixedSize(80, 100); 
-    imagePreview->setStyleSheet(
-        "border: 2px dashed #E0E0E0;"
-        "border-radius: 10px;"
-    );
+    Theme::setRole(imagePreview, Theme::Role::ImageFrame);
     imagePreview->setAlignment(Qt::AlignCenter);
 
     QString imagePath;
@@ -473,16 +285,9 @@ void ProfilePage::showCreateListingDialog() {
     QPushButton* cancelButton = new QPushButton("Cancel", dialog);
     QPushButton* createButton = new QPushButton("Create Listing", dialog);
     
-    cancelButton->setStyleSheet(
-        "background-color: white;"
-        "color: " + darkBlue + ";"
-        "border: 2px solid " + sageGreen + ";"
-    );
+    Theme::setRole(cancelButton, Theme::Role::SecondaryButton);
     
-    createButton->setStyleSheet(
-        "background-color: " + sageGreen + ";"
-        "color: white;"
-    );
+    Theme::setRole(createButton, Theme::Role::PrimaryButton);
 
     buttonLayout->addWidget(cancelButton);
     buttonLayout->addWidget(createButton);
@@ -521,18 +326,14 @@ void ProfilePage::showCreateListingDialog() {
             QString assetDir = QCoreApplication::applicationDirPath() + "/../assets/images/textbooks/";
             QDir().mkpath(assetDir);
             
-            // Copy image to assets with unique filename to avoid overwriting
-            QString uniqueFileName = QString::number(QDateTime::currentSecsSinceEpoch()) + "_" + QFileInfo(imagePath).fileName();
-            destPath = assetDir + uniqueFileName;
-            
-            // Remove existing file if it exists
-            if (QFile::exists(destPath)) {
-                QFile::remove(destPath);
-            }
+            // Transcode the upload into a size capped cover with a unique filename to avoid overwriting
+            QString uniqueBaseName = QString::number(QDateTime::currentSecsSinceEpoch()) + "_" + QFileInfo(imagePath).completeBaseName();
+            ImageTranscoder::Report report = ImageTranscoder::transcodeCover(imagePath, assetDir, uniqueBaseName);
             
-            // Copy the new file
-            if (!QFile::copy(imagePath, destPath)) {
-                qDebug() << "Failed to copy image file to:" << destPath;
+            if (report.ok) {
+                destPath = report.outputPath;
+            } else {
+                qDebug() << "Failed to transcode image file:" << imagePath << report.error;
                 destPath = QCoreApplication::applicationDirPath() + "/../assets/images/textbooks/blackwitch.jpeg";
             }
         } else {
@@ -551,7 +352,8 @@ void ProfilePage::showCreateListingDialog() {
             titleInput->text(),
             "", // Author can be added later
             priceInput->text().toDouble(),
-            destPath
+            destPath,
+            userEmail
         )) {
             QMessageBox::information(dialog, "Success", 
                 "Listing created successfully!");
@@ -601,33 +403,13 @@ bool ProfilePage::validateListingForm(const QString& title, const QString& price
 }
 
 void ProfilePage::refreshListings() {
-    // Clear existing grid
-    QLayoutItem* child;
-    while ((child = listingsGrid->takeAt(0)) != nullptr) {
-        delete child->widget();
-        delete child;
-    }
+    // Only the books this user posted, the ones the profile's listing count counts
+    auto listings = dbManager->getListingsBySeller(userEmail);
 
-    // Get listings for current user from database
-    auto listings = dbManager->getTextbooks("", "", "", "", "", 1, 100); // Get all listings
-    
-    // Add new listing cards to grid
-    int row = 0, col = 0;
-    for (const auto& book : listings) {
-        QWidget* card = createListingCard(
-            book.title, 
-            book.price, 
-            "Active", // You might want to add status to your Textbook class
-            book.getImagePath()
-        );
-        listingsGrid->addWidget(card, row, col);
-        
-        col++;
-        if (col >= 2) {  // 2 cards per row
-            col = 0;
-            row++;
-        }
-    }
+    // Cards of listings that are still there are kept and updated in place
+    listingCards->reconcile(listings,
+        [](const Textbook& book) { return book.productId; },
+        [](const Textbook& book) { return new ListingCard(book); });
 }
 
 void ProfilePage::extractNameFromEmail() {
@@ -647,8 +429,8 @@ void ProfilePage::extractNameFromEmail() {
 
 void ProfilePage::loadUserProfile() {
     // Load existing profile data if any
-    QString major = dbManager->getStudentMajor(userEmail);
-    QString semester = dbManager->getStudentSemesterLevel(userEmail);
+    QString major = profile->major();
+    QString semester = profile->semesterLevel();
     
     if (!major.isEmpty()) {
         int majorIndex = majorCombo->findText(major);
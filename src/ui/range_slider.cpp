@@ -0,0 +1,99 @@
+#include "ui/range_slider.h"
+#include "ui/theme.h"
+#include <QPainter>
+#include <QMouseEvent>
+
+namespace {
+constexpr int HANDLE_RADIUS = 8;
+constexpr int TRACK_HEIGHT = 4;
+}
+
+RangeSlider::RangeSlider(QWidget* parent)
+    : QWidget(parent)
+    , maxValue(100)
+    , lowValue(0)
+    , highValue(100)
+    , dragging(Handle::None)
+{
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+    setCursor(Qt::PointingHandCursor);
+}
+
+void RangeSlider::setMaximum(int maximum) {
+    maxValue = qMax(1, maximum);
+    setRange(lowValue, highValue);
+}
+
+void RangeSlider::setRange(int low, int high) {
+    lowValue = qBound(0, low, maxValue);
+    highValue = qBound(lowValue, high, maxValue);
+    update();
+}
+
+QSize RangeSlider::sizeHint() const {
+    return QSize(150, 2 * HANDLE_RADIUS + 4);
+}
+
+int RangeSlider::positionOf(int value) const {
+    const int span = width() - 2 * HANDLE_RADIUS;
+    return HANDLE_RADIUS + int(qint64(span) * value / maxValue);
+}
+
+int RangeSlider::valueAt(int x) const {
+    const int span = qMax(1, width() - 2 * HANDLE_RADIUS);
+    return qBound(0, qRound(double(x - HANDLE_RADIUS) * maxValue / span), maxValue);
+}
+
+void RangeSlider::paintEvent(QPaintEvent*) {
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    const int y = height() / 2;
+    const int lowX = positionOf(lowValue);
+    const int highX = positionOf(highValue);
+
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(Theme::trackGrey);
+    painter.drawRoundedRect(QRect(HANDLE_RADIUS, y - TRACK_HEIGHT / 2, width() - 2 * HANDLE_RADIUS, TRACK_HEIGHT),
+                            TRACK_HEIGHT / 2, TRACK_HEIGHT / 2);
+    painter.setBrush(Theme::sageGreen);
+    painter.drawRect(QRect(lowX, y - TRACK_HEIGHT / 2, highX - lowX, TRACK_HEIGHT));
+
+    painter.setPen(QPen(Theme::sageGreen, 2));
+    painter.setBrush(Theme::white);
+    for (int x : {lowX, highX}) {
+        painter.drawEllipse(QPoint(x, y), HANDLE_RADIUS - 1, HANDLE_RADIUS - 1);
+    }
+}
+
+void RangeSlider::mousePressEvent(QMouseEvent* event) {
+    const int x = event->position().toPoint().x();
+    const int toLow = qAbs(x - positionOf(lowValue));
+    const int toHigh = qAbs(x - positionOf(highValue));
+    // Stacked handles part in the direction of the press
+    if (lowValue == highValue) {
+        dragging = x > positionOf(highValue) ? Handle::High : Handle::Low;
+    } else {
+        dragging = toLow <= toHigh ? Handle::Low : Handle::High;
+    }
+    mouseMoveEvent(event);
+}
+
+void RangeSlider::mouseMoveEvent(QMouseEvent* event) {
+    if (dragging == Handle::None) {
+        return;
+    }
+    const int value = valueAt(event->position().toPoint().x());
+    const int low = dragging == Handle::Low ? qMin(value, highValue) : lowValue;
+    const int high = dragging == Handle::High ? qMax(value, lowValue) : highValue;
+    if (low == lowValue && high == highValue) {
+        return;
+    }
+    lowValue = low;
+    highValue = high;
+    update();
+    emit rangeChanged(lowValue, highValue);
+}
+
+void RangeSlider::mouseReleaseEvent(QMouseEvent*) {
+    dragging = Handle::None;
+}
@@ -1,4 +1,6 @@
 #include "../include/ui/registration_window.h"
+#include "ui/card_frame.h"  // Shadowed card container for the form
+#include "ui/theme.h"  // Widget roles for the application theme
 #include <QVBoxLayout>  // Arranges widgets in a vertical column
 #include <QMessageBox>  // Creates simple dialog boxes for displaying messages
 
@@ -18,105 +20,52 @@ void RegistrationWindow::setupUI() {
     // Main layout for the my login window
     auto mainLayout = new QVBoxLayout(this);
     
-    // Define color scheme
-    QString sageGreen = "#9CAF88";  // Sage green
-    QString darkBlue = "#2C3E50";   // Dark blue
-    QString lightSage = "#E8F0E3";  // Light sage for hover effects
-    
     // Create a container widget for the registration form
-    // Uses shadow effect
-    auto formContainer = new QWidget(this);
+    // Card with a drop shadow
+    auto formContainer = new CardFrame(CardFrame::Shadow::Large, 15, this);
     auto formLayout = new QVBoxLayout(formContainer);  // Layout for my widgets inside the container
-    formContainer->setFixedWidth(450); // Fixes width of container to 450 pixels
-    formContainer->setStyleSheet(
-        "QWidget {"
-        "   background-color: white;"  // Background is white
-        "   border-radius: 15px;"   // Rounded container corners
-        "   border: 1px solid #E0E0E0;"  // Solid gray border
-        "   outline: none;"  // Removes ugly outline
-        "}"
-        "QLabel {"
-        "   background: transparent;"  // Transparent background for my text
-        "   border: none;"  // removed borders
-        "}"
-        "QPushButton {"
-        "   outline: none;"  // Removes ugly outline from buttons
-        "}"
-    );
-  
-    // Adds a drop shadow effect to the form container
-    QGraphicsDropShadowEffect* shadowEffect = new QGraphicsDropShadowEffect;
-    shadowEffect->setBlurRadius(20);  // Makes shadow not harsh
-    shadowEffect->setColor(QColor(0, 0, 0, 50));  // Black Shadow color, 50% opacity
-    shadowEffect->setOffset(0, 5);  // Offset for shadow
-    formContainer->setGraphicsEffect(shadowEffect);  // Applies shadow to container
+    QMargins shadowMargins = formContainer->contentsMargins();
+    formContainer->setFixedWidth(450 + shadowMargins.left() + shadowMargins.right()); // Card itself is 450 pixels wide
 
     // Sets widget allignment and spacing
     formLayout->setAlignment(Qt::AlignCenter);
     formLayout->setSpacing(15);  // Vertical margin
     formLayout->setContentsMargins(30, 30, 30, 30);  // Padding inside container
     
-    // Title with font and styling
+    // Title
     auto titleLabel = new QLabel("Create Your Account", this);
-    titleLabel->setStyleSheet(
-        "font-size: 32px;"
-        "font-weight: bold;"
-        "color: " + darkBlue + ";"
-        "margin: 20px;"
-        "font-family: -apple-system, BlinkMacSystemFont;"
-    );
+    Theme::setRole(titleLabel, Theme::Role::HeroTitle);
+    titleLabel->setContentsMargins(20, 20, 20, 20);
     titleLabel->setAlignment(Qt::AlignCenter);
     
     // Subtitle
     auto subtitleLabel = new QLabel("Join BMCC E-Store Community", this);
-    subtitleLabel->setStyleSheet(
-        "font-size: 16px;"
-        "color: #666;"
-        "margin-bottom: 20px;"
-    );
+    Theme::setRole(subtitleLabel, Theme::Role::Subtitle);
+    subtitleLabel->setContentsMargins(0, 0, 0, 20);
     subtitleLabel->setAlignment(Qt::AlignCenter);  // Center aligned
     
-    // Input fields styling
-    QString inputStyle =
-        "QLineEdit {"
-        "   padding: 12px;"
-        "   font-size: 14px;"
-        "   border: 2px solid #E0E0E0;"
-        "   border-radius: 8px;"
-        "   background-color: white;"
-        "   outline: none;"
-        "}"
-        "QLineEdit:focus {"
-        "   border: 2px solid " + sageGreen + ";"
-        "   background-color: " + lightSage + ";"
-        "   outline: none;"
-        "}";
-    
     // Email input field
     auto emailLabel = new QLabel("Email Address", this);
-    emailLabel->setStyleSheet("font-weight: bold; color: " + darkBlue + ";");
+    Theme::setRole(emailLabel, Theme::Role::FieldLabel);
     emailInput = new QLineEdit(this);
     emailInput->setPlaceholderText("your.email@stu.bmcc.cuny.edu");
     emailInput->setMinimumWidth(350);
-    emailInput->setStyleSheet(inputStyle);  // Apply my defined input style
     
     // Password input field
     auto passwordLabel = new QLabel("Create Password", this);
-    passwordLabel->setStyleSheet("font-weight: bold; color: " + darkBlue + ";");
+    Theme::setRole(passwordLabel, Theme::Role::FieldLabel);
     passwordInput = new QLineEdit(this);
     passwordInput->setPlaceholderText("Enter your password");
     passwordInput->setEchoMode(QLineEdit::Password);
-    passwordInput->setStyleSheet(inputStyle);  // Apply my defined input style
     
     // Confirm password input field
     auto confirmPasswordLabel = new QLabel("Confirm Password", this);
-    confirmPasswordLabel->setStyleSheet("font-weight: bold; color: " + darkBlue + ";");
+    Theme::setRole(confirmPasswordLabel, Theme::Role::FieldLabel);
     confirmPasswordInput = new QLineEdit(this);
     confirmPasswordInput->setPlaceholderText("Confirm your password");
     confirmPasswordInput->setEchoMode(QLineEdit::Password);
-    confirmPasswordInput->setStyleSheet(inputStyle);
     
-    // Password requirements text box
+    // Password requirements text box, small grey text on a light sage panel
     auto requirementsLabel = new QLabel(
         "Password must contain:\n"
         "• At least 8 characters\n"
@@ -124,64 +73,28 @@ void RegistrationWindow::setupUI() {
         "• One number",
         this
     );
-    requirementsLabel->setStyleSheet(
-        "color: #666;"
-        "font-size: 12px;"
-        "padding: 10px;"
-        "background-color: " + lightSage + ";"
-        "border-radius: 5px;"
-    );
-    
-    // Register button with animation effect and hover
+    Theme::setRole(requirementsLabel, Theme::Role::Panel);
+    requirementsLabel->setContentsMargins(10, 10, 10, 10);
+    QFont requirementsFont = requirementsLabel->font();
+    requirementsFont.setPixelSize(12);
+    requirementsLabel->setFont(requirementsFont);
+    QPalette requirementsPalette = requirementsLabel->palette();
+    requirementsPalette.setColor(QPalette::WindowText, Theme::darkGrey);
+    requirementsLabel->setPalette(requirementsPalette);
+    
+    // Register button, sage with dark blue hover
     registerButton = new QPushButton("Create Account", this);
-    registerButton->setStyleSheet(
-        "QPushButton {"
-        "   background-color: " + sageGreen + ";"
-        "   color: white;"
-        "   padding: 12px;"
-        "   font-size: 16px;"
-        "   font-weight: bold;"
-        "   border-radius: 8px;"
-        "   min-width: 200px;"
-        "   border: none;"
-        "   transition: all 0.3s ease-in-out;"
-        "}"
-        "QPushButton:hover {"
-        "   background-color: " + darkBlue + ";"
-        "   transform: scale(1.05);"
-        "}"
-        "QPushButton:pressed {"
-        "   background-color: " + sageGreen + ";"
-        "   transform: scale(0.95);"
-        "}"
-    );
+    Theme::setRole(registerButton, Theme::Role::PrimaryButton);
+    registerButton->setMinimumWidth(200);
     
-   // Login button with hover
+   // Login link, underlined on hover
     loginButton = new QPushButton("Already have an account? Sign in", this);
-    loginButton->setStyleSheet(
-        "QPushButton {"
-        "   color: " + darkBlue + ";"
-        "   text-decoration: none;"
-        "   font-size: 14px;"
-        "   border: none;"
-        "   background: transparent;"
-        "   padding: 5px;"
-        "}"
-        "QPushButton:hover {"
-        "   color: " + sageGreen + ";"
-        "   text-decoration: underline;"
-        "}"
-    );
-    loginButton->setCursor(Qt::PointingHandCursor);   // Adds hand cursor onhover
+    Theme::setRole(loginButton, Theme::Role::LinkButton);
     
     // Status label for error messages
     statusLabel = new QLabel(this);
-    statusLabel->setStyleSheet(
-        "color: #FF5252;"
-        "font-size: 14px;"
-        "padding: 10px;"
-        "border-radius: 5px;"
-    );
+    Theme::setRole(statusLabel, Theme::Role::Error);
+    statusLabel->setContentsMargins(10, 10, 10, 10);
     statusLabel->setAlignment(Qt::AlignCenter);
     
     // Add widgets to form layout with proper spacing
@@ -244,14 +157,20 @@ void RegistrationWindow::handleRegistration() {
         return;
     }
     
-    QString errorMsg;
-    if (authenticator->registerUser(email, password, errorMsg)) {
-        QMessageBox::information(this, "Success",
-            "Registration successful! Please login with your credentials.");
-        emit registrationSuccessful();     // Emits the registration successful signal .
-    } else {
-        statusLabel->setText(errorMsg);
-    }
+    // Password is hashed on a worker thread, the window stays responsive meanwhile
+    registerButton->setEnabled(false);
+    statusLabel->setText("Creating account...");
+    authenticator->registerUser(email, password, this, [this](bool ok, const QString& errorMsg) {
+        registerButton->setEnabled(true);
+        if (ok) {
+            statusLabel->clear();
+            QMessageBox::information(this, "Success",
+                "Registration successful! Please login with your credentials.");
+            emit registrationSuccessful();     // Emits the registration successful signal .
+        } else {
+            statusLabel->setText(errorMsg);
+        }
+    });
 }
 
 // Tells application to switch to login view
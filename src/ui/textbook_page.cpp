@@ -1,20 +1,47 @@
 #include "ui/textbook_page.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QGraphicsDropShadowEffect>
-#include <QMessageBox>
+#include "ui/card_frame.h"
+#include "ui/theme.h"
+#include <QSignalBlocker>
+#include <QStandardItemModel>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
 
-TextbookPage::TextbookPage(DatabaseManager* db, QWidget *parent)
+TextbookPage::TextbookPage(DatabaseManager* db, UserProfile* profile, QWidget *parent)
     : QWidget(parent)
     , dbManager(db)
-    , currentPage(1)
-    , booksGrid(nullptr)
+    , profile(profile)
     , recommendedLayout(nullptr)
+    , addBundleButton(nullptr)
     , filterPanel(nullptr)
+    , priceRangeCents(0, INT_MAX)
+    , didYouMeanButton(nullptr)
+    , booksGrid(nullptr)
+    , prevButton(nullptr)
+    , nextButton(nullptr)
+    , currentPage(1)
+    , queryHandler(new QueryHandler(db, this))
+    , searchDebounce(new QTimer(this))
+    , mutations(new MutationQueue(db, this))
+    , toast(nullptr)
+    , timingClick(false)
+    , nextFeedbackLatency(0)
 {
+    connect(queryHandler, &QueryHandler::searchFinished, this,
+            [this](quint64, const QVector<Textbook>& books) { displayBooks(books); });
+    connect(queryHandler, &QueryHandler::didYouMean, this, &TextbookPage::showDidYouMean);
+    connect(queryHandler, &QueryHandler::facetsUpdated, this, &TextbookPage::updateFacets);
+    connect(profile, &UserProfile::changed, this, &TextbookPage::updateMembership);
+    connect(mutations, &MutationQueue::finished, this, &TextbookPage::finishMutation);
+    feedbackLatencies.reserve(Config::FEEDBACK_LATENCY_WINDOW);
+
     setupUI();
-    loadDepartments();
-    loadCategories();
+    setupLiveSearch();
+
+    toast = new Toast(this);
+    connect(toast, &Toast::painted, this, &TextbookPage::recordFeedback);
 }
 
 void TextbookPage::setupUI() {
@@ -24,27 +51,6 @@ void TextbookPage::setupUI() {
     
     // Create tab widget
     mainTabWidget = new QTabWidget(this);
-    mainTabWidget->setStyleSheet(
-        "QTabWidget::pane {"
-        "    border: none;"
-        "}"
-        "QTabBar::tab {"
-        "    padding: 12px 20px;"
-        "    margin-right: 5px;"
-        "    background-color: white;"
-        "    border: 2px solid " + sageGreen + ";"
-        "    border-radius: 8px;"
-        "    color: " + darkBlue + ";"
-        "    font-weight: bold;"
-        "}"
-        "QTabBar::tab:selected {"
-        "    background-color: " + sageGreen + ";"
-        "    color: white;"
-        "}"
-        "QTabBar::tab:hover {"
-        "    background-color: " + lightSage + ";"
-        "}"
-    );
 
     // Initialize all grids and layouts first
     booksGrid = new QGridLayout;
@@ -55,20 +61,51 @@ void TextbookPage::setupUI() {
     QVBoxLayout* allBooksLayout = new QVBoxLayout(allBooksWidget);
     setupFilterPanel();
     allBooksLayout->addWidget(filterPanel);
+
+    // Shown under the filters when a misspelled search found nothing
+    didYouMeanButton = new QPushButton(allBooksWidget);
+    Theme::setRole(didYouMeanButton, Theme::Role::LinkButton);
+    didYouMeanButton->setCursor(Qt::PointingHandCursor);
+    didYouMeanButton->hide();
+    connect(didYouMeanButton, &QPushButton::clicked, this, &TextbookPage::acceptDidYouMean);
+    allBooksLayout->addWidget(didYouMeanButton, 0, Qt::AlignLeft);
     
     QScrollArea* gridScrollArea = new QScrollArea;
     QWidget* gridContainer = new QWidget;
     booksGrid->setSpacing(20);
     gridContainer->setLayout(booksGrid);
+    bookCards = std::make_unique<RowPool<BookCard>>(booksGrid, 3);  // 3 books per row
+
+    QLabel* noBooksLabel = new QLabel("No books found matching your criteria.", gridContainer);
+    Theme::setRole(noBooksLabel, Theme::Role::Placeholder);
+    noBooksLabel->setAlignment(Qt::AlignCenter);
+    bookCards->setPlaceholder(noBooksLabel);
     gridScrollArea->setWidget(gridContainer);
     gridScrollArea->setWidgetResizable(true);
     gridScrollArea->setFrameShape(QFrame::NoFrame);
     allBooksLayout->addWidget(gridScrollArea);
+
+    // Pagination
+    QHBoxLayout* paginationLayout = new QHBoxLayout;
+    prevButton = new QPushButton("Previous", allBooksWidget);
+    nextButton = new QPushButton("Next", allBooksWidget);
+    Theme::setRole(prevButton, Theme::Role::PrimaryButton);
+    Theme::setRole(nextButton, Theme::Role::PrimaryButton);
+    prevButton->setEnabled(false);
+    paginationLayout->addStretch();
+    paginationLayout->addWidget(prevButton);
+    paginationLayout->addWidget(nextButton);
+    paginationLayout->addStretch();
+    allBooksLayout->addLayout(paginationLayout);
+    connect(prevButton, &QPushButton::clicked, this, &TextbookPage::handlePrevPage);
+    connect(nextButton, &QPushButton::clicked, this, &TextbookPage::handleNextPage);
     
     QWidget* recommendedWidget = createRecommendedTab();
     
     mainTabWidget->addTab(allBooksWidget, "All Books");
     mainTabWidget->addTab(recommendedWidget, "Recommended");
+    // Connected after the tabs are added so building them doesn't count as a switch
+    connect(mainTabWidget, &QTabWidget::currentChanged, this, &TextbookPage::handleTabChange);
     
     mainLayout->addWidget(mainTabWidget);
     
@@ -76,66 +113,6 @@ void TextbookPage::setupUI() {
     handleFilter();
 }
 
-QWidget* TextbookPage::createAllBooksTab() {
-    QWidget* tab = new QWidget;
-    QVBoxLayout* layout = new QVBoxLayout(tab);
-    
-    // Title
-    QLabel* title = new QLabel("Textbooks", tab);
-    title->setStyleSheet(
-        "font-size: 24px;"
-        "font-weight: bold;"
-        "color: " + darkBlue + ";"
-        "margin-bottom: 20px;"
-    );
-    layout->addWidget(title);
-    
-    // Add filter panel
-    setupFilterPanel();
-    layout->addWidget(filterPanel);
-    
-    // Books grid container
-    QScrollArea* scrollArea = new QScrollArea(tab);
-    QWidget* scrollContent = new QWidget;
-    booksGrid = new QGridLayout(scrollContent);
-    booksGrid->setSpacing(20);
-    scrollArea->setWidget(scrollContent);
-    scrollArea->setWidgetResizable(true);
-    layout->addWidget(scrollArea);
-    
-    // Pagination
-    QHBoxLayout* paginationLayout = new QHBoxLayout;
-    prevButton = new QPushButton("Previous", tab);
-    nextButton = new QPushButton("Next", tab);
-    
-    QString buttonStyle = 
-        "QPushButton {"
-        "    background-color: " + sageGreen + ";"
-        "    color: white;"
-        "    padding: 8px 15px;"
-        "    border-radius: 4px;"
-        "    border: none;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: " + darkBlue + ";"
-        "}"
-        "QPushButton:disabled {"
-        "    background-color: #CCCCCC;"
-        "}";
-        
-    prevButton->setStyleSheet(buttonStyle);
-    nextButton->setStyleSheet(buttonStyle);
-    
-    paginationLayout->addStretch();
-    paginationLayout->addWidget(prevButton);
-    paginationLayout->addWidget(nextButton);
-    paginationLayout->addStretch();
-    
-    layout->addLayout(paginationLayout);
-    
-    return tab;
-}
-
 QWidget* TextbookPage::createRecommendedTab() {
     QWidget* tab = new QWidget;
     QVBoxLayout* layout = new QVBoxLayout(tab);
@@ -143,49 +120,45 @@ QWidget* TextbookPage::createRecommendedTab() {
     layout->setContentsMargins(40, 40, 40, 40);
     
     // Header section
+    QHBoxLayout* headerLayout = new QHBoxLayout;
     QLabel* title = new QLabel("Recommended Books", tab);
-    title->setStyleSheet(
-        "font-size: 24px;"
-        "font-weight: bold;"
-        "color: " + darkBlue + ";"
-    );
+    Theme::setRole(title, Theme::Role::SectionTitle);
+
+    addBundleButton = new QPushButton("Add Bundle to Cart", tab);
+    Theme::setRole(addBundleButton, Theme::Role::PrimaryButton);
+    addBundleButton->setEnabled(false);
+    connect(addBundleButton, &QPushButton::clicked, this, &TextbookPage::handleAddBundle);
+
+    headerLayout->addWidget(title);
+    headerLayout->addStretch();
+    headerLayout->addWidget(addBundleButton);
     
     QLabel* subtitle = new QLabel(
         "Based on your major and semester level", tab);
-    subtitle->setStyleSheet(
-        "font-size: 16px;"
-        "color: #666;"
-        "margin-bottom: 20px;"
-    );
+    Theme::setRole(subtitle, Theme::Role::Subtitle);
     
-    layout->addWidget(title);
+    layout->addLayout(headerLayout);
     layout->addWidget(subtitle);
     
     // Scrollable area for recommended books
     QScrollArea* scrollArea = new QScrollArea;
     scrollArea->setWidgetResizable(true);
     scrollArea->setFrameShape(QFrame::NoFrame);
-    scrollArea->setStyleSheet(
-        "QScrollArea {"
-        "    border: none;"
-        "}"
-        "QScrollBar:vertical {"
-        "    border: none;"
-        "    background: #F0F0F0;"
-        "    width: 8px;"
-        "    margin: 0px;"
-        "}"
-        "QScrollBar::handle:vertical {"
-        "    background: " + sageGreen + ";"
-        "    border-radius: 4px;"
-        "}"
-    );
     
     // Container for book list
     QWidget* listContainer = new QWidget;
     recommendedLayout = new QVBoxLayout(listContainer);
     recommendedLayout->setSpacing(15);
     recommendedLayout->setContentsMargins(0, 0, 0, 0);
+    recommendedLayout->addStretch();  // Rows are inserted above it
+    recommendedRows = std::make_unique<RowPool<RecommendedRow>>(recommendedLayout);
+
+    QLabel* placeholder = new QLabel(
+        "No recommendations available.\nPlease update your major and semester level in your profile.",
+        listContainer);
+    Theme::setRole(placeholder, Theme::Role::Placeholder);
+    placeholder->setAlignment(Qt::AlignCenter);
+    recommendedRows->setPlaceholder(placeholder);
     
     scrollArea->setWidget(listContainer);
     layout->addWidget(scrollArea);
@@ -193,152 +166,52 @@ QWidget* TextbookPage::createRecommendedTab() {
     return tab;
 }
 
-QWidget* TextbookPage::createRecommendedBookItem(const Textbook& book) {
-    QWidget* item = new QWidget;
-    item->setStyleSheet(
-        "QWidget {"
-        "    background-color: white;"
-        "    border: 1px solid #E0E0E0;"
-        "    border-radius: 10px;"
-        "    padding: 15px;"
-        "}"
-        "QWidget:hover {"
-        "    background-color: " + lightSage + ";"
-        "}"
-    );
-    
-    QHBoxLayout* layout = new QHBoxLayout(item);
-    layout->setSpacing(20);
-    
-    // Book image
-    QLabel* imageLabel = new QLabel;
-    QPixmap image(book.getImagePath());
-    if (!image.isNull()) {
-        imageLabel->setPixmap(image.scaled(80, 100, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    } else {
-        imageLabel->setText("No Image");
-        imageLabel->setStyleSheet("background: " + lightSage + "; padding: 10px; border-radius: 5px;");
-    }
-    imageLabel->setFixedSize(80, 100);
-    
-    // Book information
-    QWidget* infoWidget = new QWidget;
-    QVBoxLayout* infoLayout = new QVBoxLayout(infoWidget);
-    infoLayout->setSpacing(5);
-    
-    QLabel* titleLabel = new QLabel(book.title);
-    titleLabel->setStyleSheet(
-        "font-weight: bold;"
-        "font-size: 16px;"
-        "color: " + darkBlue + ";"
-    );
-    titleLabel->setWordWrap(true);
-    
-    QLabel* courseLabel = new QLabel(
-        QString("%1 %2 (LEC: %3)")
-            .arg(book.courseCategory)
-            .arg(book.courseCode)
-            .arg(book.lec)
-    );
-    courseLabel->setStyleSheet("color: #666;");
-    
-    QLabel* priceLabel = new QLabel(QString("$%1").arg(book.price, 0, 'f', 2));
-    priceLabel->setStyleSheet(
-        "color: " + sageGreen + ";"
-        "font-size: 16px;"
-        "font-weight: bold;"
-    );
-    
-    infoLayout->addWidget(titleLabel);
-    infoLayout->addWidget(courseLabel);
-    infoLayout->addWidget(priceLabel);
-    infoLayout->addStretch();
-    
-    // Add to cart button
-    QPushButton* cartButton = new QPushButton("Add to Cart");
-    cartButton->setStyleSheet(
-        "QPushButton {"
-        "    background-color: " + sageGreen + ";"
-        "    color: white;"
-        "    padding: 8px 15px;"
-        "    border-radius: 15px;"
-        "    border: none;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: " + darkBlue + ";"
-        "}"
-    );
-    cartButton->setFixedWidth(120);
-    
-    connect(cartButton, &QPushButton::clicked, [=]() {
-        dbManager->addToCart(currentUserEmail, book.productId, 1);
-        QMessageBox::information(this, "Success", "Added to cart!");
-    });
-    
-    // Layout assembly
-    layout->addWidget(imageLabel);
-    layout->addWidget(infoWidget, 1);
-    layout->addWidget(cartButton);
-    
-    // Add shadow effect
-    QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect;
-    shadow->setBlurRadius(10);
-    shadow->setColor(QColor(0, 0, 0, 30));
-    shadow->setOffset(0, 2);
-    item->setGraphicsEffect(shadow);
-    
-    return item;
+RecommendedRow* TextbookPage::createRecommendedRow(const Textbook& book) {
+    RecommendedRow* row = new RecommendedRow(book);
+    row->setInCart(shownInCart(book.productId));
+    connect(row, &RecommendedRow::addToCartRequested, this, &TextbookPage::handleAddToCart);
+    return row;
 }
 
 void TextbookPage::handleTabChange(int index) {
     if (index == 1) { // Recommended tab
+        queryHandler->cancelPrefetch();  // Catalog pages are off screen now
         updateRecommendedBooks();
     }
 }
 
+void TextbookPage::hideEvent(QHideEvent* event) {
+    queryHandler->cancelPrefetch();
+    QWidget::hideEvent(event);
+}
+
 
 void TextbookPage::updateRecommendedBooks() {
     qDebug() << "Updating recommendations for user:" << currentUserEmail;
     
-    // Clear existing items
-    QLayoutItem* item;
-    while ((item = recommendedLayout->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
-    }
-    
     // Get recommended books
-    QVector<Textbook> recommendations = dbManager->getRecommendedBooks(currentUserEmail);
+    QVector<Textbook> recommendations = dbManager->getRecommendedBooks(profile->major(), profile->semesterLevel());
     
     qDebug() << "Received" << recommendations.size() << "recommendations";
-    
-    if (recommendations.isEmpty()) {
-        QLabel* placeholder = new QLabel(
-            "No recommendations available.\nPlease update your major and semester level in your profile.");
-        placeholder->setStyleSheet(
-            "color: #666;"
-            "font-size: 16px;"
-            "padding: 40px;"
-        );
-        placeholder->setAlignment(Qt::AlignCenter);
-        recommendedLayout->addWidget(placeholder);
-        qDebug() << "Added placeholder for empty recommendations";
-        return;
-    }
-    
-    // Add each recommended book as a list item
-    for (const auto& book : recommendations) {
-        recommendedLayout->addWidget(createRecommendedBookItem(book));
-        qDebug() << "Added recommendation:" << book.title;
+    recommendedIds.clear();
+    for (const Textbook& book : std::as_const(recommendations)) {
+        recommendedIds.append(book.productId);
     }
     
-    recommendedLayout->addStretch();
+    // Keep the rows of books that are still recommended, the placeholder shows when empty
+    auto stats = recommendedRows->reconcile(recommendations,
+        [](const Textbook& book) { return book.productId; },
+        [this](const Textbook& book) { return createRecommendedRow(book); });
+
+    qDebug() << "Recommendations reused" << stats.reused << "rows, created" << stats.created
+             << "and removed" << stats.removed;
+    updateMembership();  // Reused rows may show a different book now
 }
 
 
 void TextbookPage::refreshRecommendations() {
-    if (!recommendedLayout) {
-        return;  // Guard against null layout
+    if (!recommendedRows) {
+        return;  // Guard against a list that is not set up yet
     }
     updateRecommendedBooks();
 }
@@ -347,175 +220,208 @@ void TextbookPage::setupFilterPanel() {
     filterPanel = new QWidget(this);
     QHBoxLayout* filterLayout = new QHBoxLayout(filterPanel);
     
-    QString inputStyle = 
-        "QLineEdit, QComboBox {"
-        "    padding: 5px;"
-        "    border: 1px solid #E0E0E0;"
-        "    border-radius: 4px;"
-        "    min-width: 150px;"
-        "}"
-        "QComboBox::drop-down {"
-        "    border: none;"
-        "}"
-        "QComboBox::down-arrow {"
-        "    image: url(:/images/down-arrow.png);"
-        "}";
-    
     departmentCombo = new QComboBox(this);
     lecInput = new QLineEdit(this);
     categoryCombo = new QComboBox(this);
+    priceCombo = new QComboBox(this);
+    sortCombo = new QComboBox(this);
+    priceSlider = new RangeSlider(this);
+    priceRangeLabel = new QLabel(this);
     codeInput = new QLineEdit(this);
     searchInput = new QLineEdit(this);
     
-    departmentCombo->setStyleSheet(inputStyle);
-    lecInput->setStyleSheet(inputStyle);
-    categoryCombo->setStyleSheet(inputStyle);
-    codeInput->setStyleSheet(inputStyle);
-    searchInput->setStyleSheet(inputStyle);
+    departmentCombo->setMinimumWidth(150);
+    lecInput->setMinimumWidth(150);
+    categoryCombo->setMinimumWidth(150);
+    priceCombo->setMinimumWidth(150);
+    sortCombo->setMinimumWidth(150);
+    priceSlider->setMinimumWidth(150);
+    codeInput->setMinimumWidth(150);
+    searchInput->setMinimumWidth(150);
     
     departmentCombo->setPlaceholderText("Department");
     categoryCombo->setPlaceholderText("Course Section");
+    priceCombo->setPlaceholderText("Price");
     lecInput->setPlaceholderText("LEC Code");
     codeInput->setPlaceholderText("Course Code");
     searchInput->setPlaceholderText("Search by Title");
+
+    sortCombo->addItem("Newest", int(CatalogSort::Newest));
+    sortCombo->addItem("Price: Low to High", int(CatalogSort::PriceLowToHigh));
+    sortCombo->addItem("Price: High to Low", int(CatalogSort::PriceHighToLow));
+    sortCombo->addItem("Title A-Z", int(CatalogSort::Title));
+
+    // The slider spans the catalog's own prices, rounded up to a dollar
+    const int maxCents = dbManager->getPriceBoundsCents().second;
+    priceSlider->setMaximum((maxCents + 99) / 100);
+    priceSlider->setRange(0, priceSlider->maximum());
+    Theme::setRole(priceRangeLabel, Theme::Role::Muted);
+    setPriceRange(0, INT_MAX);
+    connect(dbManager, &DatabaseManager::textbookAdded, this, [this](const Textbook& book) {
+        const int dollars = int(std::ceil(book.price));
+        if (dollars > priceSlider->maximum()) {
+            // An open ended range stays open ended
+            const bool wasOpen = priceSlider->high() == priceSlider->maximum();
+            priceSlider->setMaximum(dollars);
+            if (wasOpen) {
+                priceSlider->setRange(priceSlider->low(), dollars);
+            }
+        }
+    });
     
     QPushButton* filterButton = new QPushButton("Apply Filter", this);
-    filterButton->setStyleSheet(
-        "QPushButton {"
-        "    background-color: " + sageGreen + ";"
-        "    color: white;"
-        "    padding: 8px 15px;"
-        "    border-radius: 4px;"
-        "    border: none;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: " + darkBlue + ";"
-        "}"
-    );
+    Theme::setRole(filterButton, Theme::Role::PrimaryButton);
     
     filterLayout->addWidget(departmentCombo);
     filterLayout->addWidget(lecInput);
     filterLayout->addWidget(categoryCombo);
     filterLayout->addWidget(codeInput);
+    filterLayout->addWidget(priceCombo);
+    filterLayout->addWidget(priceSlider);
+    filterLayout->addWidget(priceRangeLabel);
     filterLayout->addWidget(searchInput);
+    filterLayout->addWidget(sortCombo);
     filterLayout->addWidget(filterButton);
     
     connect(filterButton, &QPushButton::clicked, this, &TextbookPage::handleFilter);
+    // A new order starts again from the first page, without waiting for the debounce
+    connect(sortCombo, &QComboBox::currentIndexChanged, this, &TextbookPage::handleFilter);
+}
+
+BookCard* TextbookPage::createBookCard(const Textbook& book) {
+    BookCard* card = new BookCard(book);
+    card->setMembership(shownInCart(book.productId), shownWishlisted(book.productId));
+    connect(card, &BookCard::addToCartRequested, this, &TextbookPage::handleAddToCart);
+    connect(card, &BookCard::addToWishlistRequested, this, &TextbookPage::handleAddToWishlist);
+    connect(card, &BookCard::removeFromWishlistRequested, this, &TextbookPage::handleRemoveFromWishlist);
+    return card;
+}
+
+void TextbookPage::handleAddToCart(const QString& productId) {
+    const QString email = currentUserEmail;
+    mutate({productId}, true, true,
+        [email, productId](DatabaseManager& db) { return db.addToCart(email, productId, 1); },
+        "Added to your cart", "Could not add to cart, please try again.");
+}
+
+void TextbookPage::handleAddToWishlist(const QString& productId) {
+    const QString email = currentUserEmail;
+    mutate({productId}, false, true,
+        [email, productId](DatabaseManager& db) { return db.addToWishlist(email, productId); },
+        "Added to your wishlist", "Could not add to wishlist, please try again.");
+}
+
+void TextbookPage::handleRemoveFromWishlist(const QString& productId) {
+    const QString email = currentUserEmail;
+    mutate({productId}, false, false,
+        [email, productId](DatabaseManager& db) { return db.removeFromWishlist(email, productId); },
+        "Removed from your wishlist", "Could not remove from wishlist, please try again.");
 }
 
-QWidget* TextbookPage::createBookCard(const Textbook& book) {
-    QWidget* card = new QWidget;
-    card->setFixedSize(400, 400);
-    card->setStyleSheet(
-        "QWidget {"
-        "   background-color: white;"
-        "   border: 1px solid #E0E0E0;"
-        "   border-radius: 8px;"
-        "   outline: none;"
-        "}"
-    );
-   
-    QVBoxLayout* cardLayout = new QVBoxLayout(card);
-    cardLayout->setSpacing(10);
-    cardLayout->setContentsMargins(15, 15, 15, 15);
-   
-    // Book image with fallback to default
-    QLabel* imageLabel = new QLabel(card);
-    QPixmap bookImage(book.getImagePath());
-    if (bookImage.isNull()) {
-        // Use default image from assets
-        QString defaultPath = QCoreApplication::applicationDirPath() + "/../assets/images/textbooks/default_book.jpg";
-        bookImage = QPixmap(defaultPath);
-        if (bookImage.isNull()) {
-            qDebug() << "Failed to load image from:" << book.getImagePath();
-            qDebug() << "And failed to load default image from:" << defaultPath;
+// One transaction for the whole bundle, books already in the cart are skipped
+void TextbookPage::handleAddBundle() {
+    QStringList missing;
+    for (const QString& productId : std::as_const(recommendedIds)) {
+        if (!shownInCart(productId)) {
+            missing.append(productId);
         }
     }
-    imageLabel->setPixmap(bookImage.scaled(200, 250, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    imageLabel->setAlignment(Qt::AlignCenter);
-
-   // Title
-   QLabel* titleLabel = new QLabel(book.title);
-   titleLabel->setWordWrap(true);
-   titleLabel->setStyleSheet(
-       "font-weight: bold;"
-       "font-size: 14px;"
-       "color: #2C3E50;"
-   );
-   titleLabel->setAlignment(Qt::AlignCenter);
-   
-   // Course info
-   QLabel* courseLabel = new QLabel(
-       book.courseCategory + " " + book.courseCode + 
-       " (LEC: " + book.lec + ")"
-   );
-   courseLabel->setStyleSheet("color: #666;");
-   courseLabel->setAlignment(Qt::AlignCenter);
-   
-   // Price
-   QLabel* priceLabel = new QLabel(
-       QString("$%1").arg(book.price, 0, 'f', 2)
-   );
-   priceLabel->setStyleSheet(
-       "color: #9CAF88;"
-       "font-size: 18px;"
-       "font-weight: bold;"
-   );
-   priceLabel->setAlignment(Qt::AlignCenter);
-
-    QHBoxLayout* buttonLayout = new QHBoxLayout;
-
-    QPushButton* cartButton = new QPushButton;
-    cartButton->setIcon(QIcon(QCoreApplication::applicationDirPath() + "/../assets/images/nav/cartIcon.png"));
-    cartButton->setIconSize(QSize(24, 24));
-    cartButton->setStyleSheet(
-        "QPushButton {"
-        "    background-color: " + sageGreen + ";"
-        "    border-radius: 20px;"
-        "    padding: 8px;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: " + darkBlue + ";"
-        "}"
-    );
-
-    QPushButton* wishlistButton = new QPushButton;
-    wishlistButton->setIcon(QIcon(QCoreApplication::applicationDirPath() + "/../assets/images/nav/wishlistIcon.png"));
-    wishlistButton->setIconSize(QSize(24, 24));
-    wishlistButton->setStyleSheet(cartButton->styleSheet());
-
-    // Add this connect statement:
-    connect(wishlistButton, &QPushButton::clicked, [=]() {
-        dbManager->addToWishlist(currentUserEmail, book.productId);
-        QMessageBox::information(this, "Success", "Added to wishlist!");
-    });
+    if (missing.isEmpty()) {
+        toast->showMessage("These books are already in your cart");
+        return;
+    }
+    const QString email = currentUserEmail;
+    mutate(missing, true, true,
+        [email, missing](DatabaseManager& db) { return db.addManyToCart(email, missing) >= 0; },
+        QString("Added %1 book%2 to your cart").arg(missing.size()).arg(missing.size() == 1 ? "" : "s"),
+        "Could not add the bundle, please try again.");
+}
 
-    buttonLayout->addWidget(cartButton);
-    buttonLayout->addWidget(wishlistButton);
-    buttonLayout->setAlignment(Qt::AlignRight);
+// Shows the change and its toast before the write is even queued, so the
+// click costs one repaint of the cards no matter how slow SQLite is
+void TextbookPage::mutate(const QStringList& productIds, bool cart, bool state, MutationQueue::Write write,
+                          const QString& message, const QString& failure) {
+    clickTimer.start();
+    const quint64 ticket = mutations->submit(std::move(write));
+    QHash<QString, Pending>& overlay = cart ? pendingCart : pendingWishlist;
+    for (const QString& productId : productIds) {
+        overlay.insert(productId, Pending{ticket, state});
+    }
+    inFlight.insert(ticket, Mutation{productIds, cart, failure});
+    updateMembership();
+    toast->showMessage(message);
+    timingClick = true;
+}
 
+// By now the profile has applied the write's change signals, so dropping the
+// overlay leaves the cards showing either the committed state or, after a
+// failure, the state from before the click
+void TextbookPage::finishMutation(quint64 ticket, bool ok) {
+    const Mutation mutation = inFlight.take(ticket);
+    QHash<QString, Pending>& overlay = mutation.cart ? pendingCart : pendingWishlist;
+    for (const QString& productId : mutation.productIds) {
+        auto pending = overlay.find(productId);
+        if (pending != overlay.end() && pending->ticket == ticket) {
+            overlay.erase(pending);  // A later click on the same book keeps its own state
+        }
+    }
+    updateMembership();
+    if (!ok) {
+        timingClick = false;
+        toast->showMessage(mutation.failure, Toast::Kind::Error);
+    }
+}
 
-    connect(cartButton, &QPushButton::clicked, [=]() {
-        dbManager->addToCart(currentUserEmail, book.productId, 1);
-        QMessageBox::information(this, "Success", "Added to cart!");
+void TextbookPage::recordFeedback() {
+    if (!timingClick) {
+        return;
+    }
+    timingClick = false;
+    const double ms = clickTimer.nsecsElapsed() / 1e6;
+    if (feedbackLatencies.size() < Config::FEEDBACK_LATENCY_WINDOW) {
+        feedbackLatencies.append(ms);
+    } else {
+        feedbackLatencies[nextFeedbackLatency] = ms;
+    }
+    nextFeedbackLatency = (nextFeedbackLatency + 1) % Config::FEEDBACK_LATENCY_WINDOW;
+    if (ms > Config::FEEDBACK_BUDGET_MS) {
+        qDebug() << "Click feedback took" << QString::number(ms, 'f', 1) << "ms, over one frame";
+    }
+}
+
+double TextbookPage::feedbackLatencyPercentile(double percentile) const {
+    if (feedbackLatencies.isEmpty()) {
+        return 0.0;
+    }
+    QVector<double> sorted = feedbackLatencies;
+    std::sort(sorted.begin(), sorted.end());
+    int index = qBound(0, int(percentile / 100.0 * (sorted.size() - 1) + 0.5), int(sorted.size() - 1));
+    return sorted[index];
+}
+
+bool TextbookPage::shownInCart(const QString& productId) const {
+    auto pending = pendingCart.constFind(productId);
+    return pending != pendingCart.constEnd() ? pending->state : profile->isInCart(productId);
+}
+
+bool TextbookPage::shownWishlisted(const QString& productId) const {
+    auto pending = pendingWishlist.constFind(productId);
+    return pending != pendingWishlist.constEnd() ? pending->state : profile->isWishlisted(productId);
+}
+
+// Two binary searches per card in the profile's sorted id arrays, or a
+// hash lookup for books with a write still in flight
+void TextbookPage::updateMembership() {
+    bookCards->forEach([this](BookCard* card) {
+        card->setMembership(shownInCart(card->productId()), shownWishlisted(card->productId()));
+    });
+    bool bundleHasNew = false;
+    recommendedRows->forEach([this, &bundleHasNew](RecommendedRow* row) {
+        const bool inCart = shownInCart(row->productId());
+        row->setInCart(inCart);
+        bundleHasNew = bundleHasNew || !inCart;
     });
-   
-   // Add widgets to layout
-   cardLayout->addWidget(imageLabel);
-   cardLayout->addWidget(titleLabel);
-   cardLayout->addWidget(courseLabel);
-   cardLayout->addWidget(priceLabel);
-   cardLayout->addLayout(buttonLayout);
-   cardLayout->addStretch();
-   
-   // Add shadow effect
-   QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect;
-   shadow->setBlurRadius(15);
-   shadow->setColor(QColor(0, 0, 0, 50));
-   shadow->setOffset(0, 2);
-   card->setGraphicsEffect(shadow);
-   
-   return card;
+    addBundleButton->setEnabled(bundleHasNew);
 }
 
 void TextbookPage::setUserEmail(const QString& email) {
@@ -523,106 +429,157 @@ void TextbookPage::setUserEmail(const QString& email) {
     refreshRecommendations();
 }
 
-void TextbookPage::displayBooks(const QVector<Textbook>& books, QGridLayout* targetGrid) {
-    // Clear existing items
-    QLayoutItem* item;
-    while ((item = targetGrid->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
-    }
-    
-    if (books.isEmpty()) {
-        QLabel* placeholder = new QLabel("No books found matching your criteria.");
-        placeholder->setStyleSheet(
-            "color: #666;"
-            "font-size: 16px;"
-            "padding: 40px;"
-        );
-        placeholder->setAlignment(Qt::AlignCenter);
-        targetGrid->addWidget(placeholder, 0, 0);
-        return;
-    }
-    
-    // Add new books
-    int row = 0, col = 0;
-    for (const auto& book : books) {
-        targetGrid->addWidget(createBookCard(book), row, col);
-        col++;
-        if (col >= 3) {  // 3 books per row
-            col = 0;
-            row++;
-        }
+void TextbookPage::displayBooks(const QVector<Textbook>& books) {
+    if (didYouMeanButton) {
+        didYouMeanButton->hide();  // didYouMean follows right after if there is a correction
     }
+
+    // Cards for books that are still listed are kept, the placeholder shows when empty
+    bookCards->reconcile(books,
+        [](const Textbook& book) { return book.productId; },
+        [this](const Textbook& book) { return createBookCard(book); });
+    updateMembership();  // Reused cards may show a different book now
     
     // Update pagination buttons
-    if (targetGrid == booksGrid) {
+    if (prevButton && nextButton) {
         prevButton->setEnabled(currentPage > 1);
-        nextButton->setEnabled(books.size() == 9);  // Disable if less than full page
+        nextButton->setEnabled(books.size() == Config::CATALOG_PAGE_SIZE);  // Disable if less than full page
     }
 }
 
-void TextbookPage::handleFilter() {
-    if (!booksGrid) {
-        return;  // Guard against null grid
+void TextbookPage::showDidYouMean(quint64, const QString& correction) {
+    suggestedSearch = correction;
+    didYouMeanButton->setText(QString("Did you mean \"%1\"?").arg(correction));
+    didYouMeanButton->show();
+}
+
+void TextbookPage::acceptDidYouMean() {
+    searchInput->setText(suggestedSearch);
+    handleFilter();  // Skip the debounce the text change just started
+}
+
+void TextbookPage::setupLiveSearch() {
+    searchDebounce->setSingleShot(true);
+    searchDebounce->setInterval(Config::SEARCH_DEBOUNCE_MS);
+    connect(searchDebounce, &QTimer::timeout, this, &TextbookPage::handleFilter);
+
+    // Any filter edit restarts the debounce, so a burst of typing runs one search
+    connect(searchInput, &QLineEdit::textChanged, this, &TextbookPage::scheduleSearch);
+    connect(lecInput, &QLineEdit::textChanged, this, &TextbookPage::scheduleSearch);
+    connect(codeInput, &QLineEdit::textChanged, this, &TextbookPage::scheduleSearch);
+    connect(departmentCombo, &QComboBox::currentTextChanged, this, &TextbookPage::scheduleSearch);
+    connect(categoryCombo, &QComboBox::currentTextChanged, this, &TextbookPage::scheduleSearch);
+    connect(priceCombo, &QComboBox::currentIndexChanged, this, &TextbookPage::applyPriceBucket);
+    connect(priceSlider, &RangeSlider::rangeChanged, this, &TextbookPage::applyPriceSlider);
+}
+
+// A picked bucket moves the slider to it and searches the bucket's exact range
+void TextbookPage::applyPriceBucket() {
+    const int bucket = priceCombo->currentData().isValid() ? priceCombo->currentData().toInt() : -1;
+    if (bucket < 0) {
+        priceSlider->setRange(0, priceSlider->maximum());
+        setPriceRange(0, INT_MAX);
+    } else {
+        const QPair<int, int> range = CatalogSnapshot::priceBucketRange(bucket);
+        priceSlider->setRange(range.first / 100,
+                              range.second == INT_MAX ? priceSlider->maximum() : (range.second + 1) / 100);
+        setPriceRange(range.first, range.second);
     }
+    scheduleSearch();
+}
 
-    currentPage = 1;
-    
-    QVector<Textbook> books = dbManager->getTextbooks(
-        departmentCombo->currentText(),
-        lecInput->text(),
-        categoryCombo->currentText(),
-        codeInput->text(),
-        searchInput->text(),
-        currentPage,
-        9
-    );
-    
-    // Clear existing items
-    QLayoutItem* item;
-    while ((item = booksGrid->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
+// Dragging replaces any picked bucket; whole dollars at both ends, inclusive
+void TextbookPage::applyPriceSlider(int lowDollars, int highDollars) {
+    {
+        const QSignalBlocker blocker(priceCombo);
+        priceCombo->setCurrentIndex(priceCombo->findData(-1));
     }
-    
-    // Add books to grid
-    int row = 0, col = 0;
-    for (const auto& book : books) {
-        booksGrid->addWidget(createBookCard(book), row, col);
-        col++;
-        if (col >= 3) {
-            col = 0;
-            row++;
-        }
+    setPriceRange(lowDollars * 100, highDollars == priceSlider->maximum() ? INT_MAX : highDollars * 100);
+    scheduleSearch();
+}
+
+void TextbookPage::setPriceRange(int minCents, int maxCents) {
+    priceRangeCents = qMakePair(minCents, maxCents);
+    if (minCents == 0 && maxCents == INT_MAX) {
+        priceRangeLabel->setText("Any price");
+    } else if (maxCents == INT_MAX) {
+        priceRangeLabel->setText(QString("$%1 and up").arg(minCents / 100));
+    } else {
+        priceRangeLabel->setText(QString("$%1 - $%2").arg(minCents / 100.0, 0, 'f', 2).arg(maxCents / 100.0, 0, 'f', 2));
     }
 }
 
+void TextbookPage::scheduleSearch() {
+    searchDebounce->start();
+}
+
+void TextbookPage::setSearchText(const QString& text) {
+    searchInput->setText(text);
+}
+
+void TextbookPage::handleFilter() {
+    searchDebounce->stop();  // Apply Filter runs right away
+    currentPage = 1;
+    runSearch();
+}
+
+void TextbookPage::runSearch() {
+    if (!bookCards) {
+        return;  // Guard against a grid that is not set up yet
+    }
+
+    QueryHandler::SearchRequest request;
+    request.department = departmentCombo->currentData().toString();
+    request.lec = lecInput->text();
+    request.category = categoryCombo->currentData().toString();
+    request.code = codeInput->text();
+    request.title = searchInput->text();
+    request.minPriceCents = priceRangeCents.first;
+    request.maxPriceCents = priceRangeCents.second;
+    request.sort = CatalogSort(sortCombo->currentData().toInt());
+    request.page = currentPage;
+    request.pageSize = Config::CATALOG_PAGE_SIZE;
+
+    // Results arrive through QueryHandler::searchFinished, older searches are dropped
+    queryHandler->search(request);
+}
+
 void TextbookPage::handleNextPage() {
     currentPage++;
-    handleFilter();
+    runSearch();
 }
 
 void TextbookPage::handlePrevPage() {
     if (currentPage > 1) {
         currentPage--;
-        handleFilter();
+        runSearch();
     }
 }
 
-void TextbookPage::loadDepartments() {
-    departmentCombo->addItem("");  // Empty option for no filter
-    departmentCombo->addItem("Computer Science");
-    departmentCombo->addItem("Social Sciences, Human Services & Criminal Justice");
-    departmentCombo->addItem("English");
-    departmentCombo->addItem("Science");
-    departmentCombo->addItem("Mathematics");
+void TextbookPage::updateFacets(quint64, const CatalogSnapshot::Facets& facets) {
+    fillFacetCombo(departmentCombo, facets.departments);
+    fillFacetCombo(categoryCombo, facets.categories);
+    fillFacetCombo(priceCombo, facets.prices, true);
 }
 
-void TextbookPage::loadCategories() {
-    categoryCombo->addItem("");  // Empty option for no filter
-    categoryCombo->addItem("CSC");
-    categoryCombo->addItem("ECO");
-    categoryCombo->addItem("ENG");
-    categoryCombo->addItem("PHY");
-    categoryCombo->addItem("MAT");
-}
\ No newline at end of file
+// Lists every choice with the number of books it would show. Choices that
+// would show nothing are disabled, unless they are the current choice.
+void TextbookPage::fillFacetCombo(QComboBox* combo, const QVector<CatalogSnapshot::FacetCount>& counts,
+                                  bool valuesAreBuckets) {
+    const QVariant selected = combo->currentData();
+    const QSignalBlocker blocker(combo);  // Refilling is not a filter change
+    combo->clear();
+    combo->addItem("", valuesAreBuckets ? QVariant(-1) : QVariant(QString()));  // No filter
+
+    QStandardItemModel* model = qobject_cast<QStandardItemModel*>(combo->model());
+    for (int i = 0; i < counts.size(); ++i) {
+        const QVariant value = valuesAreBuckets ? QVariant(i) : QVariant(counts[i].value);
+        combo->addItem(QString("%1 (%2)").arg(counts[i].value).arg(counts[i].count), value);
+        if (model && counts[i].count == 0 && value != selected) {
+            model->item(combo->count() - 1)->setEnabled(false);
+        }
+    }
+
+    const int index = selected.isValid() ? combo->findData(selected) : -1;
+    combo->setCurrentIndex(index);
+}
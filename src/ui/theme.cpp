@@ -0,0 +1,481 @@
+#include "ui/theme.h"
+#include <QApplication>
+#include <QStyleFactory>
+#include <QStyleOption>
+#include <QPainter>
+#include <QPainterPath>
+#include <QAbstractButton>
+#include <QPushButton>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QTabBar>
+#include <QScrollBar>
+#include <QLabel>
+#include <QFrame>
+
+namespace Theme {
+
+static const char* ROLE_PROPERTY = "themeRole";
+static const char* SELECTED_PROPERTY = "themeSelected";
+
+// Re-runs polish so a role or selection change made after the widget was shown takes effect
+static void repolish(QWidget* widget) {
+    if (widget->testAttribute(Qt::WA_WState_Polished)) {
+        widget->style()->unpolish(widget);
+        widget->style()->polish(widget);
+        widget->update();
+    }
+}
+
+void setRole(QWidget* widget, Role role) {
+    widget->setProperty(ROLE_PROPERTY, int(role));
+    repolish(widget);
+}
+
+Role role(const QWidget* widget) {
+    if (!widget) {
+        return Role::None;
+    }
+    QVariant value = widget->property(ROLE_PROPERTY);
+    return value.isValid() ? Role(value.toInt()) : Role::None;
+}
+
+void setSelected(QWidget* widget, bool selected) {
+    if (widget->property(SELECTED_PROPERTY).toBool() == selected) {
+        return;
+    }
+    widget->setProperty(SELECTED_PROPERTY, selected);
+    repolish(widget);
+}
+
+bool isSelected(const QWidget* widget) {
+    return widget && widget->property(SELECTED_PROPERTY).toBool();
+}
+
+void apply(QApplication& app) {
+    Style* style = new Style;
+    app.setStyle(style);  // QApplication takes ownership
+
+    QPalette palette = style->standardPalette();
+    style->polish(palette);
+    app.setPalette(palette);
+
+    QFont font = app.font();
+    font.setPixelSize(14);
+    app.setFont(font);
+}
+
+// Font size in pixels and weight for each text role, 0 keeps the app default
+struct TextSpec {
+    int pixelSize;
+    bool bold;
+    QColor color;
+};
+
+static TextSpec textSpec(Role role) {
+    switch (role) {
+    case Role::HeroTitle:       return {32, true, darkBlue};
+    case Role::PageTitle:       return {28, true, darkBlue};
+    case Role::SectionTitle:    return {24, true, darkBlue};
+    case Role::Logo:            return {22, true, darkBlue};
+    case Role::CardTitle:       return {16, true, darkBlue};
+    case Role::Subtitle:        return {16, false, darkGrey};
+    case Role::Muted:           return {0, false, darkGrey};
+    case Role::FieldLabel:      return {0, true, darkBlue};
+    case Role::Price:           return {18, true, sageGreen};
+    case Role::Error:           return {0, false, errorRed};
+    case Role::Success:         return {0, false, successGreen};
+    case Role::Placeholder:     return {16, false, darkGrey};
+    case Role::Badge:           return {11, true, white};
+    case Role::PrimaryButton:
+    case Role::SecondaryButton: return {16, true, darkBlue};
+    case Role::TabButton:       return {16, false, darkBlue};
+    case Role::LinkButton:
+    case Role::DangerLink:
+    case Role::NavButton:
+    case Role::MenuItem:        return {14, false, darkBlue};
+    default:                    return {0, false, QColor()};
+    }
+}
+
+static bool isButtonRole(Role role) {
+    return role >= Role::PrimaryButton && role <= Role::MenuItem;
+}
+
+Style::Style()
+    : QProxyStyle(QStyleFactory::create("Fusion"))
+{}
+
+void Style::polish(QPalette& palette) {
+    QProxyStyle::polish(palette);
+    palette.setColor(QPalette::Window, white);
+    palette.setColor(QPalette::Base, white);
+    palette.setColor(QPalette::AlternateBase, lightSage);
+    palette.setColor(QPalette::Button, white);
+    palette.setColor(QPalette::WindowText, darkBlue);
+    palette.setColor(QPalette::Text, darkBlue);
+    palette.setColor(QPalette::ButtonText, darkBlue);
+    palette.setColor(QPalette::Highlight, sageGreen);
+    palette.setColor(QPalette::HighlightedText, white);
+    palette.setColor(QPalette::Disabled, QPalette::ButtonText, darkGrey);
+}
+
+void Style::polish(QWidget* widget) {
+    QProxyStyle::polish(widget);
+
+    if (qobject_cast<QAbstractButton*>(widget) || qobject_cast<QLineEdit*>(widget) ||
+        qobject_cast<QComboBox*>(widget) || qobject_cast<QTabBar*>(widget) ||
+        qobject_cast<QScrollBar*>(widget)) {
+        widget->setAttribute(Qt::WA_Hover, true);
+    }
+
+    if (QTabBar* tabBar = qobject_cast<QTabBar*>(widget)) {
+        QFont font = QApplication::font();
+        font.setBold(true);
+        tabBar->setFont(font);
+    }
+
+    if (QLineEdit* lineEdit = qobject_cast<QLineEdit*>(widget)) {
+        if (lineEdit->hasFrame()) {
+            int horizontal = role(widget) == Role::SearchField ? 15 : 8;
+            lineEdit->setTextMargins(horizontal, 4, horizontal, 4);
+        }
+    }
+
+    Role r = role(widget);
+    if (r == Role::None) {
+        return;
+    }
+
+    TextSpec spec = textSpec(r);
+    if (spec.pixelSize > 0 || spec.bold) {
+        QFont font = QApplication::font();
+        if (spec.pixelSize > 0) font.setPixelSize(spec.pixelSize);
+        font.setBold(spec.bold);
+        widget->setFont(font);
+    }
+    if (spec.color.isValid()) {
+        QPalette palette = widget->palette();
+        palette.setColor(QPalette::WindowText, spec.color);
+        palette.setColor(QPalette::ButtonText, spec.color);
+        widget->setPalette(palette);
+    }
+
+    if (isButtonRole(r)) {
+        widget->setCursor(Qt::PointingHandCursor);
+    }
+
+    switch (r) {
+    case Role::Placeholder:
+        if (QLabel* label = qobject_cast<QLabel*>(widget)) {
+            label->setContentsMargins(40, 40, 40, 40);
+        }
+        break;
+    case Role::Badge:
+        if (QLabel* label = qobject_cast<QLabel*>(widget)) {
+            label->setAlignment(Qt::AlignCenter);
+            label->setMinimumSize(16, 16);
+            label->setContentsMargins(4, 0, 4, 0);
+            QPalette palette = label->palette();
+            palette.setColor(QPalette::Window, sageGreen);
+            label->setPalette(palette);
+            label->setAutoFillBackground(true);
+        }
+        break;
+    case Role::Panel:
+    case Role::ImageFrame:
+        if (QFrame* frame = qobject_cast<QFrame*>(widget)) {
+            frame->setFrameShape(QFrame::StyledPanel);
+        }
+        break;
+    case Role::Divider:
+    case Role::Indicator: {
+        QColor fill = borderGrey;
+        if (r == Role::Indicator) {
+            fill = isSelected(widget) ? darkGrey : lightGrey;
+        }
+        QPalette palette = widget->palette();
+        palette.setColor(QPalette::Window, fill);
+        widget->setPalette(palette);
+        widget->setAutoFillBackground(true);
+        if (QFrame* frame = qobject_cast<QFrame*>(widget)) {
+            frame->setFrameShape(QFrame::NoFrame);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+int Style::pixelMetric(PixelMetric metric, const QStyleOption* option, const QWidget* widget) const {
+    switch (metric) {
+    case PM_ScrollBarExtent:
+        return 8;
+    case PM_ScrollBarSliderMin:
+        return 20;
+    case PM_DefaultFrameWidth: {
+        Role r = role(widget);
+        if (r == Role::Panel || r == Role::ImageFrame) {
+            return 0;  // Panels are filled shapes, not framed boxes
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return QProxyStyle::pixelMetric(metric, option, widget);
+}
+
+QSize Style::sizeFromContents(ContentsType type, const QStyleOption* option,
+                              const QSize& contentsSize, const QWidget* widget) const {
+    if (type == CT_PushButton) {
+        switch (role(widget)) {
+        case Role::PrimaryButton:
+        case Role::SecondaryButton:
+            return contentsSize + QSize(50, 24);
+        case Role::LinkButton:
+        case Role::DangerLink:
+            return contentsSize + QSize(10, 10);
+        case Role::NavButton:
+            return QSize(qMax(contentsSize.width() + 30, 80), contentsSize.height() + 16);
+        case Role::IconButton:
+        case Role::RoundIconButton:
+            return contentsSize + QSize(16, 16);
+        case Role::TabButton:
+            return contentsSize + QSize(30, 30);
+        case Role::MenuItem:
+            return contentsSize + QSize(40, 30);
+        default:
+            break;
+        }
+    }
+    if (type == CT_TabBarTab) {
+        return QProxyStyle::sizeFromContents(type, option, contentsSize, widget) + QSize(45, 24);
+    }
+    return QProxyStyle::sizeFromContents(type, option, contentsSize, widget);
+}
+
+void Style::drawButtonPanel(const QStyleOption* option, QPainter* painter, const QWidget* widget) const {
+    const bool enabled = option->state & State_Enabled;
+    const bool hovered = enabled && (option->state & State_MouseOver);
+    const bool pressed = option->state & State_Sunken;
+    const QRectF rect = QRectF(option->rect).adjusted(1, 1, -1, -1);
+    const qreal pill = qMin<qreal>(rect.height() / 2.0, 25.0);
+
+    QColor fill;
+    QColor border;
+    qreal radius = pill;
+
+    switch (role(widget)) {
+    case Role::PrimaryButton:
+        fill = !enabled ? QColor(0xCC, 0xCC, 0xCC) : (hovered || pressed) ? darkBlue : sageGreen;
+        break;
+    case Role::SecondaryButton:
+        fill = (hovered || pressed) ? sageGreen : white;
+        border = sageGreen;
+        break;
+    case Role::NavButton:
+        fill = hovered ? lightSage : QColor();
+        radius = 0;
+        break;
+    case Role::IconButton:
+        fill = pressed ? sageGreen : hovered ? lightSage : QColor();
+        radius = rect.height() / 2.0;
+        break;
+    case Role::RoundIconButton:
+        // Selected marks a card's product as already in the cart or wishlist
+        fill = hovered || pressed || isSelected(widget) ? darkBlue : sageGreen;
+        radius = rect.height() / 2.0;
+        break;
+    case Role::MenuItem:
+        fill = hovered ? lightSage : QColor();
+        radius = 0;
+        break;
+    default:
+        return;  // Link and tab buttons have no panel
+    }
+
+    if (!fill.isValid() && !border.isValid()) {
+        return;
+    }
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setBrush(fill.isValid() ? QBrush(fill) : Qt::NoBrush);
+    painter->setPen(border.isValid() ? QPen(border, 2) : Qt::NoPen);
+    painter->drawRoundedRect(rect, radius, radius);
+    painter->restore();
+}
+
+void Style::drawButtonLabel(const QStyleOption* option, QPainter* painter, const QWidget* widget) const {
+    const QStyleOptionButton* button = qstyleoption_cast<const QStyleOptionButton*>(option);
+    if (!button) {
+        return;
+    }
+
+    const bool hovered = (option->state & State_Enabled) && (option->state & State_MouseOver);
+    QStyleOptionButton copy = *button;
+    QColor text = copy.palette.color(QPalette::ButtonText);
+    bool underline = false;
+
+    Role r = role(widget);
+    switch (r) {
+    case Role::PrimaryButton:
+    case Role::RoundIconButton:
+        text = white;
+        break;
+    case Role::SecondaryButton:
+        text = hovered ? white : darkBlue;
+        break;
+    case Role::LinkButton:
+        text = hovered ? sageGreen : darkBlue;
+        underline = hovered;
+        break;
+    case Role::DangerLink:
+        text = errorRed;
+        underline = hovered;
+        break;
+    case Role::NavButton:
+        text = hovered ? sageGreen : darkBlue;
+        break;
+    case Role::TabButton:
+        text = (hovered || isSelected(widget)) ? sageGreen : darkBlue;
+        break;
+    default:
+        break;
+    }
+    copy.palette.setColor(QPalette::ButtonText, text);
+
+    painter->save();
+    if (underline) {
+        QFont font = painter->font();
+        font.setUnderline(true);
+        painter->setFont(font);
+    }
+    if (r == Role::MenuItem) {
+        painter->setPen(text);
+        painter->drawText(copy.rect.adjusted(20, 0, -20, 0), Qt::AlignLeft | Qt::AlignVCenter, copy.text);
+    } else {
+        QProxyStyle::drawControl(CE_PushButtonLabel, &copy, painter, widget);
+    }
+    painter->restore();
+}
+
+void Style::drawPrimitive(PrimitiveElement element, const QStyleOption* option,
+                          QPainter* painter, const QWidget* widget) const {
+    switch (element) {
+    case PE_FrameFocusRect:
+        return;  // No focus outlines anywhere in the app
+
+    case PE_PanelLineEdit: {
+        const QStyleOptionFrame* frame = qstyleoption_cast<const QStyleOptionFrame*>(option);
+        if (frame && frame->lineWidth > 0) {
+            const QRectF rect = QRectF(option->rect).adjusted(1, 1, -1, -1);
+            const qreal radius = role(widget) == Role::SearchField ? rect.height() / 2.0 : 8.0;
+            painter->save();
+            painter->setRenderHint(QPainter::Antialiasing);
+            painter->setBrush(white);
+            painter->setPen(QPen((option->state & State_HasFocus) ? sageGreen : borderGrey, 2));
+            painter->drawRoundedRect(rect, radius, radius);
+            painter->restore();
+            return;
+        }
+        break;
+    }
+    case PE_FrameLineEdit:
+        return;  // Drawn together with the panel above
+
+    case PE_Frame: {
+        Role r = role(widget);
+        if (r == Role::Panel || r == Role::ImageFrame) {
+            painter->save();
+            painter->setRenderHint(QPainter::Antialiasing);
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(lightSage);
+            painter->drawRoundedRect(QRectF(option->rect), 10, 10);
+            painter->restore();
+            return;
+        }
+        break;
+    }
+    case PE_FrameTabWidget:
+    case PE_FrameTabBarBase:
+        return;  // Borderless tab pages
+
+    default:
+        break;
+    }
+    QProxyStyle::drawPrimitive(element, option, painter, widget);
+}
+
+void Style::drawControl(ControlElement element, const QStyleOption* option,
+                        QPainter* painter, const QWidget* widget) const {
+    switch (element) {
+    case CE_PushButtonBevel:
+        if (role(widget) != Role::None) {
+            drawButtonPanel(option, painter, widget);
+            return;
+        }
+        break;
+
+    case CE_PushButtonLabel:
+        if (role(widget) != Role::None) {
+            drawButtonLabel(option, painter, widget);
+            return;
+        }
+        break;
+
+    case CE_ToolBar: {
+        // Flat white bar with a hairline under it
+        const QRect rect = option->rect;
+        painter->fillRect(rect, white);
+        painter->fillRect(QRect(rect.left(), rect.bottom(), rect.width(), 1), borderGrey);
+        return;
+    }
+    case CE_TabBarTabShape: {
+        const bool selected = option->state & State_Selected;
+        const bool hovered = option->state & State_MouseOver;
+        QRectF rect = QRectF(option->rect).adjusted(1, 1, -6, -1);  // 5px gap between tabs
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->setBrush(selected ? sageGreen : hovered ? lightSage : white);
+        painter->setPen(QPen(sageGreen, 2));
+        painter->drawRoundedRect(rect, 8, 8);
+        painter->restore();
+        return;
+    }
+    case CE_TabBarTabLabel:
+        if (const QStyleOptionTab* tab = qstyleoption_cast<const QStyleOptionTab*>(option)) {
+            QStyleOptionTab copy = *tab;
+            copy.rect.adjust(0, 0, -5, 0);
+            copy.palette.setColor(QPalette::WindowText, (option->state & State_Selected) ? white : darkBlue);
+            QProxyStyle::drawControl(element, &copy, painter, widget);
+            return;
+        }
+        break;
+
+    default:
+        break;
+    }
+    QProxyStyle::drawControl(element, option, painter, widget);
+}
+
+void Style::drawComplexControl(ComplexControl control, const QStyleOptionComplex* option,
+                               QPainter* painter, const QWidget* widget) const {
+    if (control == CC_ScrollBar) {
+        // Thin track with a rounded sage handle and no arrow buttons
+        QRect slider = subControlRect(CC_ScrollBar, option, SC_ScrollBarSlider, widget);
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->fillRect(option->rect, trackGrey);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(sageGreen);
+        painter->drawRoundedRect(QRectF(slider), 4, 4);
+        painter->restore();
+        return;
+    }
+    QProxyStyle::drawComplexControl(control, option, painter, widget);
+}
+
+}
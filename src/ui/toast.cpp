@@ -0,0 +1,72 @@
+#include "ui/toast.h"
+#include <QPainter>
+#include <QEvent>
+#include "ui/theme.h"
+#include "utils/config.h"
+
+namespace {
+const int PADDING_X = 24;
+const int PADDING_Y = 12;
+const int BOTTOM_MARGIN = 32;
+}
+
+Toast::Toast(QWidget* parent)
+    : QWidget(parent)
+    , kind(Kind::Info)
+    , awaitingPaint(false)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFocusPolicy(Qt::NoFocus);
+    QFont bold = font();
+    bold.setBold(true);
+    setFont(bold);
+    hide();
+
+    hideTimer.setSingleShot(true);
+    hideTimer.setInterval(Config::TOAST_DURATION_MS);
+    connect(&hideTimer, &QTimer::timeout, this, &QWidget::hide);
+    parent->installEventFilter(this);
+}
+
+void Toast::showMessage(const QString& text, Kind messageKind) {
+    awaitingPaint = true;
+    message = text;
+    kind = messageKind;
+    place();
+    raise();
+    show();
+    update();
+    hideTimer.start();
+}
+
+// Sized to the text and centered above the bottom edge of the parent
+void Toast::place() {
+    const QSize text = fontMetrics().size(Qt::TextSingleLine, message);
+    const QSize size(text.width() + PADDING_X * 2, text.height() + PADDING_Y * 2);
+    const QWidget* host = parentWidget();
+    setGeometry((host->width() - size.width()) / 2, host->height() - size.height() - BOTTOM_MARGIN,
+                size.width(), size.height());
+}
+
+bool Toast::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == parentWidget() && event->type() == QEvent::Resize && isVisible()) {
+        place();
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void Toast::paintEvent(QPaintEvent*) {
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(kind == Kind::Error ? Theme::errorRed : Theme::darkBlue);
+    const qreal radius = height() / 2.0;
+    painter.drawRoundedRect(QRectF(rect()), radius, radius);
+    painter.setPen(Theme::white);
+    painter.drawText(rect(), Qt::AlignCenter, message);
+
+    if (awaitingPaint) {
+        awaitingPaint = false;
+        emit painted();
+    }
+}
@@ -1,6 +1,7 @@
 #include "ui/wishlist_page.h"
 #include <QScrollArea>
-#include <QGraphicsDropShadowEffect>
+#include "ui/card_frame.h"
+#include "ui/theme.h"
 #include <QMessageBox>
 
 WishlistPage::WishlistPage(DatabaseManager* db, const QString& userEmail, QWidget *parent)
@@ -21,22 +22,9 @@ void WishlistPage::setupUI() {
     mainLayout->setAlignment(Qt::AlignCenter);
     
     // Create central card widget
-    QWidget* cardWidget = new QWidget;
+    CardFrame* cardWidget = new CardFrame(CardFrame::Shadow::Large, 20);
+    cardWidget->setBorderColor(Qt::transparent);
     cardWidget->setFixedWidth(1000);
-    cardWidget->setStyleSheet(
-        "QWidget {"
-        "    background-color: white;"
-        "    border-radius: 20px;"
-        "    padding: 20px;"
-        "}"
-    );
-    
-    // Add shadow effect
-    QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect;
-    shadow->setBlurRadius(20);
-    shadow->setColor(QColor(0, 0, 0, 50));
-    shadow->setOffset(0, 5);
-    cardWidget->setGraphicsEffect(shadow);
     
     // Card layout
     QVBoxLayout* cardLayout = new QVBoxLayout(cardWidget);
@@ -48,17 +36,10 @@ void WishlistPage::setupUI() {
     QHBoxLayout* headerLayout = new QHBoxLayout(headerWidget);
     
     QLabel* title = new QLabel("Your Wishlist");
-    title->setStyleSheet(
-        "font-size: 28px;"
-        "font-weight: bold;"
-        "color: " + darkBlue + ";"
-    );
+    Theme::setRole(title, Theme::Role::PageTitle);
     
     itemCountLabel = new QLabel;
-    itemCountLabel->setStyleSheet(
-        "font-size: 16px;"
-        "color: #666;"
-    );
+    Theme::setRole(itemCountLabel, Theme::Role::Subtitle);
     
     headerLayout->addWidget(title);
     headerLayout->addStretch();
@@ -71,6 +52,12 @@ void WishlistPage::setupUI() {
     QWidget* scrollContent = new QWidget;
     wishlistItemsLayout = new QVBoxLayout(scrollContent);
     wishlistItemsLayout->setSpacing(15);
+    wishlistRows = std::make_unique<RowPool<WishlistRow>>(wishlistItemsLayout);
+
+    QLabel* emptyLabel = new QLabel("Your wishlist is empty", scrollContent);
+    Theme::setRole(emptyLabel, Theme::Role::Placeholder);
+    emptyLabel->setAlignment(Qt::AlignCenter);
+    wishlistRows->setPlaceholder(emptyLabel);
     scrollArea->setWidget(scrollContent);
     cardLayout->addWidget(scrollArea);
 
@@ -79,198 +66,52 @@ void WishlistPage::setupUI() {
     buttonLayout->setSpacing(20);
     
     QPushButton* continueButton = createStyledButton("Continue Shopping", false);
+    moveAllButton = createStyledButton("Move All to Cart", true);
     
     buttonLayout->addWidget(continueButton);
+    buttonLayout->addWidget(moveAllButton);
     cardLayout->addLayout(buttonLayout);
     
     mainLayout->addWidget(cardWidget);
     
     connect(continueButton, &QPushButton::clicked, this, &WishlistPage::handleContinueShopping);
+    connect(moveAllButton, &QPushButton::clicked, this, &WishlistPage::handleMoveAllToCart);
 }
 
 QScrollArea* WishlistPage::createStyledScrollArea() {
     QScrollArea* scrollArea = new QScrollArea;
     scrollArea->setWidgetResizable(true);
     scrollArea->setFrameShape(QFrame::NoFrame);
-    scrollArea->setStyleSheet(
-        "QScrollArea { border: none; }"
-        "QScrollBar:vertical {"
-        "    border: none;"
-        "    background: #F0F0F0;"
-        "    width: 8px;"
-        "    margin: 0px;"
-        "}"
-        "QScrollBar::handle:vertical {"
-        "    background: " + sageGreen + ";"
-        "    border-radius: 4px;"
-        "}"
-        "QScrollBar::up-button:vertical, QScrollBar::down-button:vertical {"
-        "    border: none;"
-        "    background: none;"
-        "}"
-    );
     return scrollArea;
 }
 
 QPushButton* WishlistPage::createStyledButton(const QString& text, bool isPrimary) {
     QPushButton* button = new QPushButton(text);
-    button->setStyleSheet(
-        QString("QPushButton {"
-        "    background-color: %1;"
-        "    color: %2;"
-        "    padding: 15px 30px;"
-        "    border-radius: 25px;"
-        "    font-size: 16px;"
-        "    font-weight: bold;"
-        "    min-width: 200px;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: " + darkBlue + ";"
-        "    color: white;"
-        "}").arg(isPrimary ? sageGreen : "white", isPrimary ? "white" : darkBlue)
-    );
+    Theme::setRole(button, isPrimary ? Theme::Role::PrimaryButton : Theme::Role::SecondaryButton);
+    button->setMinimumWidth(200);
     return button;
 }
 
-QWidget* WishlistPage::createWishlistItem(const Textbook& book) {
-    QWidget* itemWidget = new QWidget;
-    itemWidget->setStyleSheet(
-        "QWidget {"
-        "    background-color: white;"
-        "    border: 1px solid #E0E0E0;"
-        "    border-radius: 15px;"
-        "    padding: 20px;"
-        "}"
-    );
-
-    QHBoxLayout* layout = new QHBoxLayout(itemWidget);
-    layout->setSpacing(20);
-
-    // Image
-    QLabel* imageLabel = new QLabel;
-    QPixmap image(book.getImagePath());
-    if (!image.isNull()) {
-        imageLabel->setPixmap(image.scaled(100, 120, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    }
-    imageLabel->setFixedSize(100, 120);
-    imageLabel->setStyleSheet(
-        "border: 1px solid #E0E0E0;"
-        "border-radius: 10px;"
-        "padding: 5px;"
-    );
-
-    // Info section
-    QVBoxLayout* infoLayout = new QVBoxLayout;
-    
-    QLabel* titleLabel = new QLabel(book.title);
-    titleLabel->setStyleSheet(
-        "font-weight: bold;"
-        "font-size: 16px;"
-        "color: " + darkBlue + ";"
-    );
-    titleLabel->setWordWrap(true);
-    
-    QLabel* detailsLabel = new QLabel(
-        QString("%1 - %2 %3 (LEC: %4)")
-            .arg(book.department)
-            .arg(book.courseCategory)
-            .arg(book.courseCode)
-            .arg(book.lec)
-    );
-    detailsLabel->setStyleSheet("color: #666;");
-    
-    QLabel* priceLabel = new QLabel(QString("$%1").arg(book.price, 0, 'f', 2));
-    priceLabel->setStyleSheet(
-        "font-weight: bold;"
-        "font-size: 18px;"
-        "color: " + sageGreen + ";"
-    );
-    
-    infoLayout->addWidget(titleLabel);
-    infoLayout->addWidget(detailsLabel);
-    infoLayout->addWidget(priceLabel);
-    infoLayout->addStretch();
-
-    // Buttons section
-    QVBoxLayout* buttonsLayout = new QVBoxLayout;
-    buttonsLayout->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-    
-    QPushButton* moveToCartButton = new QPushButton("Move to Cart");
-    moveToCartButton->setStyleSheet(
-        "QPushButton {"
-        "    background-color: " + sageGreen + ";"
-        "    color: white;"
-        "    padding: 8px 15px;"
-        "    border-radius: 15px;"
-        "    font-weight: bold;"
-        "}"
-        "QPushButton:hover {"
-        "    background-color: " + darkBlue + ";"
-        "}"
-    );
-
-    QPushButton* removeButton = new QPushButton("Remove");
-    removeButton->setStyleSheet(
-        "QPushButton {"
-        "    color: #FF5252;"
-        "    border: none;"
-        "    background: none;"
-        "    padding: 5px;"
-        "}"
-        "QPushButton:hover {"
-        "    text-decoration: underline;"
-        "}"
-    );
-
-    buttonsLayout->addWidget(moveToCartButton);
-    buttonsLayout->addWidget(removeButton);
-    buttonsLayout->addStretch();
-
-    layout->addWidget(imageLabel);
-    layout->addLayout(infoLayout, 1);
-    layout->addLayout(buttonsLayout);
-
-    // Add shadow effect
-    QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect;
-    shadow->setBlurRadius(10);
-    shadow->setColor(QColor(0, 0, 0, 30));
-    shadow->setOffset(0, 2);
-    itemWidget->setGraphicsEffect(shadow);
-
-    // Connect buttons
-    connect(moveToCartButton, &QPushButton::clicked, 
-            [this, book]() { handleMoveToCart(book.productId); });
-    connect(removeButton, &QPushButton::clicked, 
-            [this, book]() { handleRemoveItem(book.productId); });
-
-    return itemWidget;
+WishlistRow* WishlistPage::createWishlistRow(const Textbook& book) {
+    WishlistRow* row = new WishlistRow(book);
+    connect(row, &WishlistRow::moveToCartRequested, this, &WishlistPage::handleMoveToCart);
+    connect(row, &WishlistRow::removeRequested, this, &WishlistPage::handleRemoveItem);
+    return row;
 }
 
 void WishlistPage::refreshWishlist() {
-    // Clear existing items
-    QLayoutItem* item;
-    while ((item = wishlistItemsLayout->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
-    }
-
     auto wishlistItems = dbManager->getWishlist(currentUserEmail);
     itemCount = wishlistItems.size();
-    
-    if (wishlistItems.isEmpty()) {
-        QLabel* emptyLabel = new QLabel("Your wishlist is empty");
-        emptyLabel->setStyleSheet(
-            "color: #666;"
-            "font-size: 16px;"
-            "padding: 40px;"
-        );
-        emptyLabel->setAlignment(Qt::AlignCenter);
-        wishlistItemsLayout->addWidget(emptyLabel);
-    } else {
-        for (const auto& book : wishlistItems) {
-            wishlistItemsLayout->addWidget(createWishlistItem(book));
-        }
+    productIds.clear();
+    for (const Textbook& book : std::as_const(wishlistItems)) {
+        productIds.append(book.productId);
     }
+    moveAllButton->setEnabled(itemCount > 0);
+
+    // Reuse the rows of books still on the wishlist, only new books get a new row
+    wishlistRows->reconcile(wishlistItems,
+        [](const Textbook& book) { return book.productId; },
+        [this](const Textbook& book) { return createWishlistRow(book); });
 
     updateItemCount();
 }
@@ -281,14 +122,25 @@ void WishlistPage::updateItemCount() {
         .arg(itemCount == 1 ? "" : "s"));
 }
 
+// Adding to the cart and leaving the wishlist commit together
 void WishlistPage::handleMoveToCart(const QString& productId) {
-    if (dbManager->addToCart(currentUserEmail, productId, 1)) {
-        dbManager->removeFromWishlist(currentUserEmail, productId);
+    if (dbManager->moveWishlistToCart(currentUserEmail, {productId}) > 0) {
         refreshWishlist();
         QMessageBox::information(this, "Success", "Item moved to cart!");
     }
 }
 
+void WishlistPage::handleMoveAllToCart() {
+    const int moved = dbManager->moveWishlistToCart(currentUserEmail, productIds);
+    if (moved < 0) {
+        QMessageBox::warning(this, "Error", "Could not move your wishlist, please try again.");
+        return;
+    }
+    refreshWishlist();
+    QMessageBox::information(this, "Success",
+        QString("Moved %1 item%2 to your cart!").arg(moved).arg(moved == 1 ? "" : "s"));
+}
+
 void WishlistPage::handleRemoveItem(const QString& productId) {
     if (dbManager->removeFromWishlist(currentUserEmail, productId)) {
         refreshWishlist();
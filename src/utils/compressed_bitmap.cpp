@@ -0,0 +1,84 @@
+#include "utils/compressed_bitmap.h"
+#include <QtAlgorithms>
+#include <algorithm>
+
+void CompressedBitmap::add(quint32 row) {
+    const quint32 key = row >> 16;
+    const quint16 offset = quint16(row & 0xFFFF);
+    if (chunks.isEmpty() || chunks.last().key != key) {
+        chunks.append(Chunk{key, {}, {}});
+    }
+
+    Chunk& chunk = chunks.last();
+    if (chunk.bits.isEmpty()) {
+        if (!chunk.offsets.isEmpty() && chunk.offsets.last() == offset) {
+            return;  // Already there
+        }
+        chunk.offsets.append(offset);
+        ++total;
+        if (chunk.offsets.size() > ARRAY_LIMIT) {
+            chunk.bits.fill(0, CHUNK_WORDS);
+            for (quint16 o : std::as_const(chunk.offsets)) {
+                chunk.bits[o >> 6] |= quint64(1) << (o & 63);
+            }
+            chunk.offsets.clear();
+            chunk.offsets.squeeze();
+        }
+        return;
+    }
+
+    quint64& word = chunk.bits[offset >> 6];
+    const quint64 bit = quint64(1) << (offset & 63);
+    if (!(word & bit)) {
+        word |= bit;
+        ++total;
+    }
+}
+
+bool CompressedBitmap::contains(quint32 row) const {
+    const quint32 key = row >> 16;
+    const quint16 offset = quint16(row & 0xFFFF);
+    auto chunk = std::lower_bound(chunks.cbegin(), chunks.cend(), key,
+                                  [](const Chunk& c, quint32 k) { return c.key < k; });
+    if (chunk == chunks.cend() || chunk->key != key) {
+        return false;
+    }
+    if (!chunk->bits.isEmpty()) {
+        return chunk->bits[offset >> 6] & (quint64(1) << (offset & 63));
+    }
+    return std::binary_search(chunk->offsets.cbegin(), chunk->offsets.cend(), offset);
+}
+
+int CompressedBitmap::intersectionCount(const QVector<quint64>& words) const {
+    int count = 0;
+    for (const Chunk& chunk : chunks) {
+        const qsizetype base = qsizetype(chunk.key) * CHUNK_WORDS;
+        if (base >= words.size()) {
+            break;
+        }
+        if (!chunk.bits.isEmpty()) {
+            // Bitset against bitset: one popcount per 64 rows
+            const qsizetype end = std::min<qsizetype>(CHUNK_WORDS, words.size() - base);
+            for (qsizetype i = 0; i < end; ++i) {
+                count += qPopulationCount(chunk.bits[i] & words[base + i]);
+            }
+        } else {
+            for (quint16 offset : chunk.offsets) {
+                const qsizetype index = base + (offset >> 6);
+                if (index >= words.size()) {
+                    break;
+                }
+                count += (words[index] >> (offset & 63)) & 1;
+            }
+        }
+    }
+    return count;
+}
+
+qint64 CompressedBitmap::byteSize() const {
+    qint64 bytes = chunks.size() * qint64(sizeof(Chunk));
+    for (const Chunk& chunk : chunks) {
+        bytes += chunk.offsets.size() * qint64(sizeof(quint16)) + chunk.bits.size() * qint64(sizeof(quint64));
+    }
+    return bytes;
+}
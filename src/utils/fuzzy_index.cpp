@@ -0,0 +1,240 @@
+#include "utils/fuzzy_index.h"
+#include <QRegularExpression>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// Myers' bit-parallel edit distance: one 64-bit word holds a whole column of
+// the DP matrix, so each character of the text costs a handful of word
+// operations instead of a pass over the pattern. Built once per pattern.
+class BitPattern {
+public:
+    explicit BitPattern(QStringView pattern) : length(pattern.size()) {
+        std::memset(ascii, 0, sizeof(ascii));
+        for (int i = 0; i < length; ++i) {
+            const ushort c = pattern[i].unicode();
+            if (c < 128) {
+                ascii[c] |= quint64(1) << i;
+                continue;
+            }
+            auto it = std::find_if(other.begin(), other.end(),
+                                   [c](const QPair<ushort, quint64>& e) { return e.first == c; });
+            if (it == other.end()) {
+                other.append(qMakePair(c, quint64(1) << i));
+            } else {
+                it->second |= quint64(1) << i;
+            }
+        }
+    }
+
+    // Patterns longer than 64 characters fall back to the plain DP
+    bool fits() const { return length > 0 && length <= 64; }
+
+    int distance(QStringView text) const {
+        quint64 pv = ~quint64(0);
+        quint64 mv = 0;
+        const quint64 last = quint64(1) << (length - 1);
+        int score = length;
+        for (QChar ch : text) {
+            const quint64 eq = mask(ch.unicode());
+            const quint64 xv = eq | mv;
+            const quint64 xh = (((eq & pv) + pv) ^ pv) | eq;
+            quint64 ph = mv | ~(xh | pv);
+            quint64 mh = pv & xh;
+            if (ph & last) {
+                ++score;
+            } else if (mh & last) {
+                --score;
+            }
+            ph = (ph << 1) | 1;  // Row zero grows by one per column
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+        }
+        return score;
+    }
+
+private:
+    quint64 mask(ushort c) const {
+        if (c < 128) {
+            return ascii[c];
+        }
+        for (const auto& e : other) {
+            if (e.first == c) {
+                return e.second;
+            }
+        }
+        return 0;
+    }
+
+    int length;
+    quint64 ascii[128];
+    QVarLengthArray<QPair<ushort, quint64>, 8> other;
+};
+
+int dpDistance(QStringView a, QStringView b) {
+    QVector<int> row(b.size() + 1);
+    for (int j = 0; j <= b.size(); ++j) {
+        row[j] = j;
+    }
+    for (int i = 1; i <= a.size(); ++i) {
+        int diagonal = row[0];
+        row[0] = i;
+        for (int j = 1; j <= b.size(); ++j) {
+            const int above = row[j];
+            row[j] = std::min({above + 1, row[j - 1] + 1, diagonal + (a[i - 1] != b[j - 1] ? 1 : 0)});
+            diagonal = above;
+        }
+    }
+    return row[b.size()];
+}
+
+int boundedDistance(const BitPattern& bits, QStringView pattern, QStringView text, int maxDistance) {
+    if (std::abs(int(pattern.size() - text.size())) > maxDistance) {
+        return maxDistance + 1;
+    }
+    const int distance = bits.fits() ? bits.distance(text) : dpDistance(pattern, text);
+    return std::min(distance, maxDistance + 1);
+}
+
+}
+
+FuzzyIndex::FuzzyIndex() {}
+
+void FuzzyIndex::clear() {
+    keys.clear();
+    display.clear();
+    frequencies.clear();
+    termIds.clear();
+    postings.clear();
+}
+
+QString FuzzyIndex::fold(const QString& word) {
+    return word.toCaseFolded();
+}
+
+// Trigrams of the word padded with two leading and one trailing space, so
+// the first letters weigh more and short words still have a few grams
+QVector<quint64> FuzzyIndex::trigrams(QStringView key) {
+    QVector<quint64> grams;
+    grams.reserve(key.size() + 1);
+    auto at = [&key](int i) -> quint64 {
+        return (i < 0 || i >= key.size()) ? ' ' : key[i].unicode();
+    };
+    for (int i = -2; i < key.size() - 1; ++i) {
+        const quint64 gram = (at(i) << 32) | (at(i + 1) << 16) | at(i + 2);
+        if (!grams.contains(gram)) {
+            grams.append(gram);
+        }
+    }
+    return grams;
+}
+
+int FuzzyIndex::maxDistanceFor(int length) {
+    if (length <= 4) {
+        return 1;
+    }
+    return length <= 8 ? 2 : 3;
+}
+
+int FuzzyIndex::editDistance(QStringView pattern, QStringView text, int maxDistance) {
+    return boundedDistance(BitPattern(pattern), pattern, text, maxDistance);
+}
+
+void FuzzyIndex::insertText(const QString& text) {
+    static const QRegularExpression separators("[^\\w']+");
+    const QStringList words = text.split(separators, Qt::SkipEmptyParts);
+    for (const QString& word : words) {
+        insert(word);
+    }
+}
+
+void FuzzyIndex::insert(const QString& word, quint32 count) {
+    const QString key = fold(word);
+    if (key.isEmpty()) {
+        return;
+    }
+    auto existing = termIds.constFind(key);
+    if (existing != termIds.constEnd()) {
+        frequencies[*existing] += count;
+        return;
+    }
+
+    const quint32 id = keys.size();
+    keys.append(key);
+    display.append(word);
+    frequencies.append(count);
+    termIds.insert(key, id);
+    for (quint64 gram : trigrams(key)) {
+        postings[gram].append(id);
+    }
+}
+
+QVector<FuzzyIndex::Match> FuzzyIndex::lookup(const QString& word, int limit) const {
+    const QString key = fold(word);
+    if (key.isEmpty()) {
+        return {};
+    }
+    const int maxDistance = maxDistanceFor(key.size());
+    const QVector<quint64> grams = trigrams(key);
+    const int needed = std::max(1, int(grams.size()) - 3 * maxDistance);
+
+    // Count shared trigrams per term; only terms that reach the bound are verified
+    QVector<quint16> shared(keys.size(), 0);
+    QVector<quint32> candidates;
+    for (quint64 gram : grams) {
+        auto list = postings.constFind(gram);
+        if (list == postings.constEnd()) {
+            continue;
+        }
+        for (quint32 id : *list) {
+            if (++shared[id] == needed) {
+                candidates.append(id);
+            }
+        }
+    }
+
+    const BitPattern bits(key);
+    QVector<Match> matches;
+    for (quint32 id : candidates) {
+        const int distance = boundedDistance(bits, key, keys[id], maxDistance);
+        if (distance <= maxDistance) {
+            matches.append({display[id], distance, frequencies[id]});
+        }
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) {
+        if (a.distance != b.distance) {
+            return a.distance < b.distance;
+        }
+        return a.frequency > b.frequency;
+    });
+    if (matches.size() > limit) {
+        matches.resize(limit);
+    }
+    return matches;
+}
+
+QString FuzzyIndex::correct(const QString& query) const {
+    const QStringList words = query.simplified().split(' ', Qt::SkipEmptyParts);
+    QStringList corrected;
+    bool changed = false;
+    for (const QString& word : words) {
+        // Very short words are too ambiguous to correct
+        if (word.size() < 3 || contains(word)) {
+            corrected.append(word);
+            continue;
+        }
+        const QVector<Match> best = lookup(word, 1);
+        if (best.isEmpty()) {
+            corrected.append(word);
+            continue;
+        }
+        corrected.append(best.first().term);
+        changed = true;
+    }
+    return changed ? corrected.join(' ') : QString();
+}
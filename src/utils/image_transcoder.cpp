@@ -0,0 +1,108 @@
+#include "utils/image_transcoder.h"
+#include <QImage>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QPainter>
+#include <QFileInfo>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QDebug>
+
+QByteArray ImageTranscoder::preferredFormat() {
+    // WebP is roughly 30% smaller than JPEG at the same visual quality,
+    // but it is only available when the qwebp image plugin is installed
+    static const QByteArray format =
+        QImageWriter::supportedImageFormats().contains("webp") ? QByteArray("webp") : QByteArray("jpg");
+    return format;
+}
+
+ImageTranscoder::Report ImageTranscoder::transcodeCover(const QString& sourcePath,
+                                                        const QString& destDir,
+                                                        const QString& baseName) {
+    Report report;
+    report.sourceBytes = QFileInfo(sourcePath).size();
+
+    QImageReader reader(sourcePath);
+    reader.setAutoTransform(true);  // Bake the EXIF orientation into the pixels
+    report.sourceSize = reader.size();
+
+    // Let the decoder downscale JPEGs while reading instead of decoding full size
+    if (report.sourceSize.isValid() &&
+        (report.sourceSize.width() > MAX_COVER_WIDTH || report.sourceSize.height() > MAX_COVER_HEIGHT)) {
+        reader.setScaledSize(report.sourceSize.scaled(MAX_COVER_WIDTH, MAX_COVER_HEIGHT, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        report.error = reader.errorString();
+        return report;
+    }
+
+    // Some plugins ignore setScaledSize, so enforce the cap here as well
+    if (image.width() > MAX_COVER_WIDTH || image.height() > MAX_COVER_HEIGHT) {
+        image = image.scaled(MAX_COVER_WIDTH, MAX_COVER_HEIGHT, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    // Painting into a fresh image flattens transparency onto white and
+    // leaves every text/EXIF key from the original file behind
+    QImage clean(image.size(), QImage::Format_RGB32);
+    clean.fill(Qt::white);
+    {
+        QPainter painter(&clean);
+        painter.drawImage(0, 0, image);
+    }
+
+    report.format = preferredFormat();
+    report.outputSize = clean.size();
+    report.outputPath = QDir(destDir).filePath(baseName + "." + QString::fromLatin1(report.format));
+
+    QImageWriter writer(report.outputPath, report.format);
+    if (report.format == "webp") {
+        writer.setQuality(WEBP_QUALITY);
+    } else {
+        writer.setQuality(JPEG_QUALITY);
+        writer.setOptimizedWrite(true);
+        writer.setProgressiveScanWrite(true);
+    }
+
+    if (!writer.write(clean)) {
+        report.error = writer.errorString();
+        return report;
+    }
+
+    report.ok = true;
+    report.outputBytes = QFileInfo(report.outputPath).size();
+    report.decodeMs = measureDecodeMs(report.outputPath);
+
+    int coverCount = 0;
+    qint64 volumeBytes = directoryFootprint(destDir, &coverCount);
+    qDebug() << "Transcoded cover" << QFileInfo(sourcePath).fileName()
+             << report.sourceSize << "->" << report.outputSize << report.format
+             << "|" << report.sourceBytes / 1024 << "KB ->" << report.outputBytes / 1024 << "KB"
+             << "| decode" << QString::number(report.decodeMs, 'f', 2) << "ms"
+             << "| asset volume" << volumeBytes / 1024 << "KB across" << coverCount << "covers";
+    return report;
+}
+
+qint64 ImageTranscoder::directoryFootprint(const QString& dir, int* fileCount) {
+    qint64 total = 0;
+    const QFileInfoList files = QDir(dir).entryInfoList(QDir::Files);
+    for (const QFileInfo& info : files) {
+        total += info.size();
+    }
+    if (fileCount) {
+        *fileCount = files.size();
+    }
+    return total;
+}
+
+double ImageTranscoder::measureDecodeMs(const QString& path) {
+    QElapsedTimer timer;
+    timer.start();
+    QImageReader reader(path);
+    QImage decoded = reader.read();
+    if (decoded.isNull()) {
+        return -1.0;
+    }
+    return timer.nsecsElapsed() / 1e6;
+}
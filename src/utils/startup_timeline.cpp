@@ -0,0 +1,58 @@
+#include "utils/startup_timeline.h"
+#include <QCoreApplication>
+#include <QThread>
+
+StartupTimeline::Phase::Phase(const QString& name) : index(StartupTimeline::instance().begin(name)) {}
+
+StartupTimeline::Phase::~Phase() {
+    StartupTimeline::instance().end(index);
+}
+
+StartupTimeline& StartupTimeline::instance() {
+    static StartupTimeline timeline;
+    return timeline;
+}
+
+StartupTimeline::StartupTimeline() {
+    clock.start();
+}
+
+double StartupTimeline::elapsedMs() const {
+    return clock.nsecsElapsed() / 1e6;
+}
+
+int StartupTimeline::begin(const QString& name) {
+    const QCoreApplication* app = QCoreApplication::instance();
+    const bool gui = !app || QThread::currentThread() == app->thread();
+    const QString thread = gui ? QString("gui")
+                               : QString("worker %1").arg(quintptr(QThread::currentThreadId()) % 10000);
+    QMutexLocker locker(&lock);
+    entries.append(Entry{name, thread, elapsedMs(), -1.0});
+    return entries.size() - 1;
+}
+
+void StartupTimeline::end(int phase) {
+    QMutexLocker locker(&lock);
+    entries[phase].endMs = elapsedMs();
+}
+
+void StartupTimeline::mark(const QString& name) {
+    const int phase = begin(name);
+    QMutexLocker locker(&lock);
+    entries[phase].endMs = entries[phase].startMs;
+}
+
+QString StartupTimeline::report() const {
+    QMutexLocker locker(&lock);
+    QString text = QString("%1 %2 %3 %4\n")
+        .arg("phase", -24).arg("thread", -12).arg("start ms", 10).arg("took ms", 10);
+    for (const Entry& entry : entries) {
+        const QString took = entry.endMs < 0 ? QString("running")
+                           : entry.endMs == entry.startMs ? QString("-")
+                           : QString::number(entry.endMs - entry.startMs, 'f', 1);
+        text += QString("%1 %2 %3 %4\n")
+            .arg(entry.name, -24).arg(entry.thread, -12)
+            .arg(QString::number(entry.startMs, 'f', 1), 10).arg(took, 10);
+    }
+    return text;
+}
@@ -0,0 +1,163 @@
+#include "utils/suggestion_index.h"
+#include <utility>
+
+SuggestionIndex::SuggestionIndex() {
+    clear();
+}
+
+void SuggestionIndex::clear() {
+    nodes.clear();
+    entries.clear();
+    labels.clear();
+    nodes.append(Node());  // Root, with an empty edge label
+}
+
+// Keys ignore case and repeated whitespace, so "csc  101" finds "CSC 101"
+QString SuggestionIndex::normalize(const QString& text) {
+    return text.simplified().toCaseFolded();
+}
+
+void SuggestionIndex::insert(const QString& text, quint32 weight) {
+    const QString key = normalize(text);
+    if (key.isEmpty()) {
+        return;
+    }
+
+    // Walk down the trie, splitting the edge where the key leaves it
+    QVector<quint32> path;
+    quint32 node = 0;
+    int pos = 0;
+    while (true) {
+        path.append(node);
+        if (pos == key.size()) {
+            break;
+        }
+        quint32 child = findChild(node, key[pos]);
+        if (child == NONE) {
+            node = addNode(node, key, pos);
+            path.append(node);
+            break;
+        }
+
+        const quint32 start = nodes[child].labelStart;
+        const quint32 length = nodes[child].labelLength;
+        quint32 match = 1;  // findChild already matched the first character
+        while (match < length && pos + int(match) < key.size()
+               && labels[start + match] == key[pos + match]) {
+            ++match;
+        }
+        if (match < length) {
+            child = splitEdge(child, match);
+        }
+        pos += match;
+        node = child;
+    }
+
+    quint32 entry = nodes[node].entry;
+    if (entry == NONE) {
+        entry = entries.size();
+        entries.append({text.simplified(), weight});
+        nodes[node].entry = entry;
+    } else {
+        entries[entry].weight += weight;
+    }
+
+    for (quint32 step : path) {
+        promote(step, entry);
+    }
+}
+
+QStringList SuggestionIndex::complete(const QString& prefix, int limit) const {
+    const QString key = normalize(prefix);
+    quint32 node = 0;
+    int pos = 0;
+    while (pos < key.size()) {
+        quint32 child = findChild(node, key[pos]);
+        if (child == NONE) {
+            return {};
+        }
+        const Node& next = nodes[child];
+        quint32 match = 1;
+        while (match < next.labelLength && pos + int(match) < key.size()) {
+            if (labels[next.labelStart + match] != key[pos + match]) {
+                return {};
+            }
+            ++match;
+        }
+        pos += match;
+        node = child;
+    }
+
+    const Node& found = nodes[node];
+    QStringList results;
+    for (quint32 i = 0; i < found.topCount && int(i) < limit; ++i) {
+        results.append(entries[found.top[i]].text);
+    }
+    return results;
+}
+
+quint32 SuggestionIndex::findChild(quint32 node, QChar first) const {
+    for (quint32 child = nodes[node].firstChild; child != NONE; child = nodes[child].nextSibling) {
+        if (labels[nodes[child].labelStart] == first) {
+            return child;
+        }
+    }
+    return NONE;
+}
+
+// Hangs the rest of key, from position from, under parent as one new leaf
+quint32 SuggestionIndex::addNode(quint32 parent, const QString& key, int from) {
+    Node leaf;
+    leaf.labelStart = labels.size();
+    leaf.labelLength = key.size() - from;
+    leaf.nextSibling = nodes[parent].firstChild;
+    labels.append(QStringView(key).mid(from));
+
+    quint32 index = nodes.size();
+    nodes.append(leaf);
+    nodes[parent].firstChild = index;
+    return index;
+}
+
+// Cuts node's edge after at characters. The node keeps its place under its
+// parent and its top list (its subtree is unchanged); everything it held moves
+// to a new child carrying the rest of the label.
+quint32 SuggestionIndex::splitEdge(quint32 node, quint32 at) {
+    Node tail = nodes[node];
+    tail.labelStart += at;
+    tail.labelLength -= at;
+    tail.nextSibling = NONE;
+
+    quint32 index = nodes.size();
+    nodes.append(tail);
+
+    Node& head = nodes[node];
+    head.labelLength = at;
+    head.firstChild = index;
+    head.entry = NONE;
+    return node;
+}
+
+// Moves entry into node's top list if it is now heavy enough, keeping the
+// list ordered by weight
+void SuggestionIndex::promote(quint32 node, quint32 entry) {
+    Node& n = nodes[node];
+    quint32 i = 0;
+    while (i < n.topCount && n.top[i] != entry) {
+        ++i;
+    }
+    if (i == n.topCount) {
+        if (n.topCount < quint32(TOP_K)) {
+            ++n.topCount;
+        } else if (entries[entry].weight > entries[n.top[TOP_K - 1]].weight) {
+            i = TOP_K - 1;
+        } else {
+            return;
+        }
+        n.top[i] = entry;
+    }
+    while (i > 0 && entries[n.top[i - 1]].weight < entries[n.top[i]].weight) {
+        std::swap(n.top[i - 1], n.top[i]);
+        --i;
+    }
+}
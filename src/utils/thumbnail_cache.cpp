@@ -0,0 +1,64 @@
+#include "utils/thumbnail_cache.h"
+#include "utils/config.h"
+#include <QImageReader>
+
+ThumbnailCache& ThumbnailCache::shared() {
+    static ThumbnailCache cache;
+    return cache;
+}
+
+ThumbnailCache::ThumbnailCache()
+    : images(Config::THUMBNAIL_CACHE_KB)
+    , hitCount(0)
+    , missCount(0)
+{}
+
+QString ThumbnailCache::keyFor(const QString& path, const QSize& bounds) {
+    return QString("%1x%2:%3").arg(bounds.width()).arg(bounds.height()).arg(path);
+}
+
+QImage ThumbnailCache::load(const QString& path, const QSize& bounds) {
+    const QString key = keyFor(path, bounds);
+    {
+        QMutexLocker locker(&lock);
+        if (const QImage* image = images.object(key)) {
+            ++hitCount;
+            return *image;
+        }
+        ++missCount;
+    }
+
+    // Decoded outside the lock, two threads racing on one cover just both decode it.
+    // A scaled read lets the JPEG decoder skip most of the full size image.
+    QImageReader reader(path);
+    const QSize size = reader.size();
+    if (size.isValid() && (size.width() > bounds.width() || size.height() > bounds.height())) {
+        reader.setScaledSize(size.scaled(bounds, Qt::KeepAspectRatio));
+    }
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return image;
+    }
+    if (image.width() > bounds.width() || image.height() > bounds.height()) {
+        image = image.scaled(bounds, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    QMutexLocker locker(&lock);
+    images.insert(key, new QImage(image), qMax<qsizetype>(1, image.sizeInBytes() / 1024));
+    return image;
+}
+
+bool ThumbnailCache::contains(const QString& path, const QSize& bounds) const {
+    QMutexLocker locker(&lock);
+    return images.contains(keyFor(path, bounds));
+}
+
+int ThumbnailCache::hits() const {
+    QMutexLocker locker(&lock);
+    return hitCount;
+}
+
+int ThumbnailCache::misses() const {
+    QMutexLocker locker(&lock);
+    return missCount;
+}
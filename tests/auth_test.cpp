@@ -0,0 +1,373 @@
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QEventLoop>
+#include <QTimer>
+#include <QDir>
+#include <QDebug>
+#include <QElapsedTimer>
+#include "auth/database_manager.h"
+#include "auth/session_manager.h"
+#include "auth/email_validator.h"
+#include "auth/password_validator.h"
+#include "auth/login_throttle.h"
+#include <QRandomGenerator>
+#include <QRegularExpression>
+#include "utils/config.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Authentication tests. The credential store writes to a bmcc_store.db in a
+// temporary working directory.
+
+namespace {
+
+// Runs one store operation and waits for its callback
+AuthDatabaseManager::Status await(const std::function<void(QObject*, AuthDatabaseManager::Callback)>& call) {
+    QObject context;
+    QEventLoop loop;
+    AuthDatabaseManager::Status result = AuthDatabaseManager::Status::DatabaseError;
+    call(&context, [&](AuthDatabaseManager::Status status) {
+        result = status;
+        loop.quit();
+    });
+    QTimer::singleShot(30000, &loop, &QEventLoop::quit);
+    loop.exec();
+    return result;
+}
+
+}
+
+// RFC 7914 section 11 vectors for PBKDF2-HMAC-SHA256
+bool testPbkdf2Vectors() {
+    struct Vector {
+        const char* password;
+        const char* salt;
+        int iterations;
+        int length;
+        const char* hex;
+    };
+    const Vector vectors[] = {
+        {"passwd", "salt", 1, 64,
+         "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+         "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783"},
+        {"Password", "NaCl", 80000, 64,
+         "4ddcd8f60b98be21830cee5ef22701f9641a4418d04c0414aeff08876b34ab56"
+         "a1d425a1225833549adb841b51c9b3176a272bdebba1d078478f62b397f33c8d"},
+    };
+    for (const Vector& vector : vectors) {
+        const QByteArray key = AuthDatabaseManager::pbkdf2Sha256(
+            vector.password, vector.salt, vector.iterations, vector.length);
+        if (key.toHex() != QByteArray(vector.hex)) {
+            qDebug() << "PBKDF2 of" << vector.password << "gave" << key.toHex();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Credentials survive the store that wrote them and are checked off the calling thread
+bool testCredentialsPersist() {
+    const QString email = "student@stu.bmcc.cuny.edu";
+    {
+        AuthDatabaseManager store;
+        const auto added = await([&](QObject* context, AuthDatabaseManager::Callback done) {
+            store.addUser(email, "Password123", context, done);
+        });
+        const auto duplicate = await([&](QObject* context, AuthDatabaseManager::Callback done) {
+            store.addUser(email, "Other4567", context, done);
+        });
+        if (added != AuthDatabaseManager::Status::Ok || duplicate != AuthDatabaseManager::Status::EmailTaken) {
+            qDebug() << "Add returned" << int(added) << "then" << int(duplicate);
+            return false;
+        }
+        if (store.iterations() < Config::PASSWORD_HASH_MIN_ITERATIONS) {
+            qDebug() << "Calibrated to" << store.iterations() << "iterations";
+            return false;
+        }
+    }
+
+    // A new store, as after a restart
+    AuthDatabaseManager store;
+    QElapsedTimer timer;
+    timer.start();
+    const auto right = await([&](QObject* context, AuthDatabaseManager::Callback done) {
+        store.verify(email, "Password123", context, done);
+    });
+    const double verifyMs = timer.nsecsElapsed() / 1e6;
+    const auto wrong = await([&](QObject* context, AuthDatabaseManager::Callback done) {
+        store.verify(email, "Password124", context, done);
+    });
+    const auto unknown = await([&](QObject* context, AuthDatabaseManager::Callback done) {
+        store.verify("nobody@stu.bmcc.cuny.edu", "Password123", context, done);
+    });
+    qDebug() << "Verified at" << store.iterations() << "iterations, first check took"
+             << verifyMs << "ms including calibration";
+    return right == AuthDatabaseManager::Status::Ok
+        && wrong == AuthDatabaseManager::Status::WrongPassword
+        && unknown == AuthDatabaseManager::Status::UnknownEmail;
+}
+
+// Remember me tokens are single use, and a forged validator revokes the user's tokens
+bool testRememberTokens() {
+    AuthDatabaseManager store;
+    QObject context;
+    QEventLoop loop;
+    QTimer::singleShot(30000, &loop, &QEventLoop::quit);
+    QString issued;
+    store.issueRememberToken("student@stu.bmcc.cuny.edu", &context, [&](const QString& token) {
+        issued = token;
+        loop.quit();
+    });
+    loop.exec();
+
+    auto redeem = [&](const QString& token) {
+        AuthDatabaseManager::Resumed result;
+        QEventLoop wait;
+        store.redeemRememberToken(token, &context, [&](const AuthDatabaseManager::Resumed& resumed) {
+            result = resumed;
+            wait.quit();
+        });
+        wait.exec();
+        return result;
+    };
+
+    const AuthDatabaseManager::Resumed first = redeem(issued);
+    const AuthDatabaseManager::Resumed replayed = redeem(issued);
+    // Same selector as the rotated token, different validator
+    const QString forged = first.token.section(':', 0, 0) + ":" + issued.section(':', 1, 1);
+    const AuthDatabaseManager::Resumed forgedResult = redeem(forged);
+    const AuthDatabaseManager::Resumed afterForgery = redeem(first.token);
+
+    return !issued.isEmpty()
+        && first.email == "student@stu.bmcc.cuny.edu" && !first.token.isEmpty() && first.token != issued
+        && replayed.email.isEmpty() && forgedResult.email.isEmpty() && afterForgery.email.isEmpty();
+}
+
+// 100k sessions: O(1) checks, all reclaimed by the wheel after their
+// lifetime, and the records reused by the next 100k
+bool testSessionWheelAt100k() {
+    const int users = 100000;
+    const qint64 lifetimeSecs = Config::SESSION_LIFETIME_SECS;
+    qint64 now = 0;
+    SessionManager sessions(lifetimeSecs, [&now]() { return now; });
+
+    QElapsedTimer timer;
+    timer.start();
+    QVector<QUuid> tokens;
+    tokens.reserve(users);
+    for (int i = 0; i < users; ++i) {
+        now += 5;  // Logins spread over the first 500 seconds
+        tokens.append(sessions.create(QString("user%1@stu.bmcc.cuny.edu").arg(i)));
+    }
+    const double createMs = timer.nsecsElapsed() / 1e6;
+
+    timer.restart();
+    int valid = 0;
+    for (const QUuid& token : std::as_const(tokens)) {
+        valid += sessions.isValid(token) ? 1 : 0;
+    }
+    const double checkNs = double(timer.nsecsElapsed()) / users;
+    const int records = sessions.capacity();
+
+    // Refreshed halfway, the first user outlives everyone else
+    now = lifetimeSecs * 1000 / 2;
+    const bool refreshed = sessions.refresh(tokens.first());
+    now = lifetimeSecs * 1000 + 600 * 1000;
+    sessions.advance();
+    const bool survivorOk = sessions.count() == 1 && sessions.isValid(tokens.first())
+                         && !sessions.isValid(tokens.last()) && sessions.evictions() == quint64(users - 1);
+
+    for (int i = 0; i < users; ++i) {
+        now += 5;
+        sessions.create(QString("user%1@stu.bmcc.cuny.edu").arg(i));
+    }
+    qDebug() << users << "sessions created in" << createMs << "ms, checked in"
+             << checkNs << "ns each," << sessions.evictions() << "evicted";
+    return valid == users && refreshed && survivorOk
+        && sessions.count() == users && sessions.capacity() == records;
+}
+
+// One email gets its burst then one attempt per refill interval, without
+// touching anyone else's bucket or the global one
+bool testLoginThrottle() {
+    qint64 now = 0;
+    LoginThrottle throttle([&now]() { return now; });
+    const QString victim = "victim@stu.bmcc.cuny.edu";
+
+    int allowed = 0;
+    for (int i = 0; i < 100; ++i) {
+        allowed += throttle.tryAcquire(victim) == LoginThrottle::Verdict::Allowed ? 1 : 0;
+    }
+    const bool burstOk = allowed == Config::LOGIN_ACCOUNT_BURST
+                      && throttle.accountLimited() == quint64(100 - allowed);
+    const bool othersOk = throttle.tryAcquire("other@stu.bmcc.cuny.edu") == LoginThrottle::Verdict::Allowed;
+
+    now += 60000 / Config::LOGIN_ACCOUNT_PER_MINUTE;
+    const bool refilled = throttle.tryAcquire(victim) == LoginThrottle::Verdict::Allowed
+                       && throttle.tryAcquire(victim) == LoginThrottle::Verdict::AccountLimited;
+
+    // Many distinct emails at once run into the global bucket
+    int globalAllowed = 0;
+    for (int i = 0; i < 10000; ++i) {
+        globalAllowed += throttle.tryAcquire(QString("bot%1@stu.bmcc.cuny.edu").arg(i))
+                         == LoginThrottle::Verdict::Allowed ? 1 : 0;
+    }
+    return burstOk && othersOk && refilled
+        && globalAllowed <= Config::LOGIN_GLOBAL_BURST && throttle.globalLimited() > 0;
+}
+
+// Attackers on 1 to 8 threads try a new email every attempt for a second.
+// Attempts grow with the threads, but the hashes let through, which are what
+// costs CPU, stay at the global burst plus one second of refill.
+bool testThrottleUnderAttack() {
+    const QByteArray salt = "attack-salt";
+    const qint64 perSecond = Config::LOGIN_GLOBAL_PER_MINUTE / 60;
+    bool flat = true;
+    for (int threads : {1, 4, 8}) {
+        LoginThrottle throttle;
+        std::atomic<quint64> attempts{0};
+        std::atomic<int> hashes{0};
+        QElapsedTimer timer;
+        timer.start();
+        std::vector<std::thread> attackers;
+        for (int t = 0; t < threads; ++t) {
+            attackers.emplace_back([&, t]() {
+                quint64 mine = 0;
+                while (timer.elapsed() < 1000) {
+                    const QString email = QString("bot%1-%2@stu.bmcc.cuny.edu").arg(t).arg(mine++);
+                    if (throttle.tryAcquire(email) == LoginThrottle::Verdict::Allowed) {
+                        AuthDatabaseManager::pbkdf2Sha256("Password1", salt, 1000);
+                        hashes.fetch_add(1);
+                    }
+                }
+                attempts.fetch_add(mine);
+            });
+        }
+        for (std::thread& attacker : attackers) {
+            attacker.join();
+        }
+        const double seconds = timer.nsecsElapsed() / 1e9;
+        const qint64 limit = Config::LOGIN_GLOBAL_BURST + qint64(perSecond * seconds) + 1;
+        qDebug() << threads << "attackers:" << qint64(attempts / seconds) << "attempts/s,"
+                 << hashes.load() << "hashed, limit" << limit;
+        flat = flat && hashes.load() <= limit && throttle.allowed() == quint64(hashes.load());
+    }
+    return flat;
+}
+
+// The validators before the scanners, kept to check the rules didn't change
+bool regexIsValidEmail(const QString& email) {
+    QRegularExpression emailRegex("^[A-Za-z0-9._%+-]+@[A-Za-z0-9.-]+\\.[A-Za-z]{2,}$");
+    if (!emailRegex.match(email).hasMatch()) {
+        return false;
+    }
+    const int atIndex = email.indexOf('@');
+    return atIndex != -1 && email.mid(atIndex) == "@stu.bmcc.cuny.edu";
+}
+
+PasswordValidator::Problem regexCheckPassword(const QString& password) {
+    if (password.length() < 8) {
+        return PasswordValidator::Problem::TooShort;
+    }
+    if (password.length() > 16) {
+        return PasswordValidator::Problem::TooLong;
+    }
+    if (!password.contains(QRegularExpression("[A-Z]"))) {
+        return PasswordValidator::Problem::NoUppercase;
+    }
+    if (!password.contains(QRegularExpression("[0-9]"))) {
+        return PasswordValidator::Problem::NoDigit;
+    }
+    return PasswordValidator::Problem::None;
+}
+
+// A 40k roster, valid and near miss inputs, gives the same answers as the
+// regexes, one at a time and in a parallel batch
+bool testValidatorsMatchRegex() {
+    QRandomGenerator random(44);
+    const QString alphabet = QString::fromUtf8("abcXYZ019._%+-@ !#\né\u00c9");
+    const QStringList domains = {"@stu.bmcc.cuny.edu", "@stu.bmcc.cuny.edu", "@STU.bmcc.cuny.edu",
+                                 "@bmcc.cuny.edu", "@stu.bmcc.cuny.edu\n", "@stu.bmcc.cuny.edu.",
+                                 "stu.bmcc.cuny.edu", "@@stu.bmcc.cuny.edu", ""};
+    auto randomText = [&](int minLength, int maxLength) {
+        QString text;
+        const int length = random.bounded(minLength, maxLength + 1);
+        for (int i = 0; i < length; ++i) {
+            // Mostly plain characters, so plenty of inputs are valid
+            const int pick = random.bounded(4) == 0 ? random.bounded(int(alphabet.size()))
+                                                    : random.bounded(9);
+            text += alphabet[pick];
+        }
+        return text;
+    };
+
+    const int roster = 40000;
+    QStringList emails;
+    QStringList passwords;
+    for (int i = 0; i < roster; ++i) {
+        emails.append(randomText(0, 12) + domains[random.bounded(int(domains.size()))]);
+        passwords.append(randomText(5, 19));
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QVector<bool> expectedEmails;
+    QVector<PasswordValidator::Problem> expectedPasswords;
+    for (int i = 0; i < roster; ++i) {
+        expectedEmails.append(regexIsValidEmail(emails[i]));
+        expectedPasswords.append(regexCheckPassword(passwords[i]));
+    }
+    const double regexMs = timer.nsecsElapsed() / 1e6;
+
+    EmailValidator validator;
+    timer.restart();
+    QVector<bool> scannedEmails;
+    QVector<PasswordValidator::Problem> scannedPasswords;
+    for (int i = 0; i < roster; ++i) {
+        scannedEmails.append(validator.isValidEmail(emails[i]));
+        scannedPasswords.append(PasswordValidator::check(passwords[i]));
+    }
+    const double scanMs = timer.nsecsElapsed() / 1e6;
+
+    timer.restart();
+    const QVector<bool> batchEmails = validator.validateAll(emails);
+    const QVector<PasswordValidator::Problem> batchPasswords = PasswordValidator::checkAll(passwords);
+    const double batchMs = timer.nsecsElapsed() / 1e6;
+
+    qDebug() << roster << "emails and passwords: regex" << regexMs << "ms, scanner"
+             << scanMs << "ms, parallel batch" << batchMs << "ms,"
+             << expectedEmails.count(true) << "valid emails";
+    return scannedEmails == expectedEmails && batchEmails == expectedEmails
+        && scannedPasswords == expectedPasswords && batchPasswords == expectedPasswords
+        && expectedEmails.count(true) > 0;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir dir;
+    QDir::setCurrent(dir.path());
+
+    struct Test {
+        const char* name;
+        bool (*run)();
+    };
+    const Test tests[] = {
+        {"pbkdf2 vectors", testPbkdf2Vectors},
+        {"credentials persist", testCredentialsPersist},
+        {"remember tokens", testRememberTokens},
+        {"session wheel at 100k", testSessionWheelAt100k},
+        {"validators match regex", testValidatorsMatchRegex},
+        {"login throttle", testLoginThrottle},
+        {"throttle under attack", testThrottleUnderAttack},
+    };
+
+    int failures = 0;
+    for (const Test& test : tests) {
+        bool ok = test.run();
+        qDebug() << (ok ? "PASS" : "FAIL") << test.name;
+        failures += ok ? 0 : 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,746 @@
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QEventLoop>
+#include <QTimer>
+#include <QDir>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include "database/database_manager.h"
+#include "database/query_handler.h"
+#include "database/mutation_queue.h"
+#include "database/catalog_snapshot.h"
+#include "database/db_connector.h"
+#include "database/user_profile.h"
+#include <QSqlQuery>
+#include <QThread>
+#include <atomic>
+#include <functional>
+#include "utils/suggestion_index.h"
+#include "utils/fuzzy_index.h"
+#include "utils/compressed_bitmap.h"
+
+// Catalog search tests. Each test runs against the seeded bmcc_store.db that
+// DatabaseManager creates in a temporary working directory.
+
+// A burst of searches must only ever deliver the newest one
+bool testSupersededSearchesAreDropped(DatabaseManager& db) {
+    QueryHandler handler(&db);
+    QVector<quint64> delivered;
+    QVector<Textbook> lastResults;
+    QObject::connect(&handler, &QueryHandler::searchFinished,
+                     [&](quint64 generation, const QVector<Textbook>& results) {
+                         delivered.append(generation);
+                         lastResults = results;
+                     });
+
+    const QStringList typed = {"F", "Fr", "Fra", "Fran", "Frank", "Franke", "Franken", "Frankenstein"};
+    quint64 newest = 0;
+    for (const QString& text : typed) {
+        QueryHandler::SearchRequest request;
+        request.title = text;
+        newest = handler.search(request);
+    }
+
+    // Give the worker time to finish everything that was queued
+    QEventLoop loop;
+    QTimer::singleShot(1000, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    if (delivered != QVector<quint64>{newest}) {
+        qDebug() << "Expected only generation" << newest << "but got" << delivered;
+        return false;
+    }
+    if (lastResults.size() != 1 || lastResults.first().title != "Frankenstein") {
+        qDebug() << "Expected the Frankenstein listing, got" << lastResults.size() << "books";
+        return false;
+    }
+    qDebug() << "Superseded searches dropped, p95 latency"
+             << handler.latencyPercentile(95) << "ms";
+    return true;
+}
+
+// After a pause on a page its neighbours are fetched in the background, so
+// turning to them never waits for the worker; a new filter starts over
+bool testPageTurnsServedFromPrefetch(DatabaseManager& db) {
+    QueryHandler handler(&db);
+    QVector<Textbook> lastResults;
+    int delivered = 0;
+    QObject::connect(&handler, &QueryHandler::searchFinished,
+                     [&](quint64, const QVector<Textbook>& results) {
+                         lastResults = results;
+                         ++delivered;
+                     });
+    // Runs the event loop until done() holds, with a deadline only a hung worker reaches
+    auto waitFor = [](const std::function<bool()>& done) {
+        QElapsedTimer deadline;
+        deadline.start();
+        while (!done() && deadline.elapsed() < 30000) {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+            QThread::msleep(1);
+        }
+        return done();
+    };
+
+    // The ten seeded books are one full page and one more book
+    QueryHandler::SearchRequest request;
+    handler.search(request);
+    if (!waitFor([&]() { return delivered == 1 && handler.hasPrefetched(2); })) {
+        qDebug() << "Page 2 was never prefetched";
+        return false;
+    }
+    request.page = 2;
+    handler.search(request);
+    waitFor([&]() { return delivered == 2; });
+    const bool nextPageReady = handler.prefetchHits() == 1 && lastResults.size() == 1;
+    request.page = 1;
+    handler.search(request);
+    waitFor([&]() { return delivered == 3; });
+    const bool previousPageReady = handler.prefetchHits() == 2 && lastResults.size() == Config::CATALOG_PAGE_SIZE;
+
+    request.sort = CatalogSort::Title;
+    handler.search(request);
+    request.page = 2;
+    handler.search(request);  // Straight away, nothing prefetched yet
+    waitFor([&]() { return lastResults.size() == 1 && handler.prefetchMisses() == 1; });
+    qDebug() << handler.prefetchHits() << "prefetch hits," << handler.prefetchMisses() << "misses";
+    return nextPageReady && previousPageReady && handler.prefetchMisses() == 1 && lastResults.size() == 1;
+}
+
+// Search text goes to SQLite as a bound value, so quotes are just characters
+bool testSearchTextIsBound(DatabaseManager& db) {
+    QVector<Textbook> books = db.getTextbooks("", "", "", "", "O'Brien' OR '1'='1");
+    if (!books.isEmpty()) {
+        qDebug() << "Quoted search text matched" << books.size() << "books";
+        return false;
+    }
+    return true;
+}
+
+// Seeded books are suggested by title, author and course code, in any case
+bool testSuggestionsFromCatalog(DatabaseManager& db) {
+    SuggestionIndex index;
+    for (const auto& book : db.getTextbookPopularity()) {
+        for (const QString& term : book.first.searchTerms()) {
+            index.insert(term, 1 + book.second);
+        }
+    }
+
+    const QStringList byTitle = index.complete("frank");
+    const QStringList byCode = index.complete("csc  1");
+    if (byTitle.value(0) != "Frankenstein") {
+        qDebug() << "Expected Frankenstein, got" << byTitle;
+        return false;
+    }
+    if (byCode.isEmpty() || !byCode.first().startsWith("CSC 1")) {
+        qDebug() << "Expected CSC course codes, got" << byCode;
+        return false;
+    }
+    if (!index.complete("zzzz").isEmpty()) {
+        qDebug() << "Unknown prefix returned suggestions";
+        return false;
+    }
+    return true;
+}
+
+// Heavier entries win and repeated inserts add up
+bool testSuggestionRanking(DatabaseManager&) {
+    SuggestionIndex index;
+    index.insert("Calculus", 3);
+    index.insert("Calculus: Early Transcendentals", 5);
+    index.insert("Campbell Biology", 4);
+    index.insert("Calculus", 4);
+
+    const QStringList results = index.complete("ca");
+    const QStringList expected = {"Calculus", "Calculus: Early Transcendentals", "Campbell Biology"};
+    if (results != expected || index.size() != 3) {
+        qDebug() << "Unexpected ranking" << results;
+        return false;
+    }
+    return index.complete("calc", 1) == QStringList{"Calculus"};
+}
+
+// Every prefix completes to a full list at 500k entries; the per keystroke
+// lookup time, which should stay under a millisecond, is logged
+bool testSuggestionLatency(DatabaseManager&) {
+    const int entryCount = 500000;
+    const QStringList words = {"intro", "calculus", "biology", "chemistry", "history",
+                               "physics", "algebra", "writing", "economics", "psychology"};
+    QRandomGenerator random(42);
+
+    SuggestionIndex index;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < entryCount; ++i) {
+        QString text = words[random.bounded(words.size())] + " "
+                     + words[random.bounded(words.size())] + " " + QString::number(i);
+        index.insert(text, random.bounded(1000));
+    }
+    const qint64 buildMs = timer.elapsed();
+
+    QStringList prefixes;
+    for (int i = 0; i < 10000; ++i) {
+        const QString& word = words[random.bounded(words.size())];
+        prefixes.append(word.left(1 + random.bounded(word.size())));
+    }
+
+    int found = 0;
+    timer.restart();
+    for (const QString& prefix : prefixes) {
+        found += index.complete(prefix).size();
+    }
+    const double perLookupMs = timer.nsecsElapsed() / 1e6 / prefixes.size();
+
+    qDebug() << "Suggestion index:" << index.size() << "entries," << index.nodeCount()
+             << "nodes, built in" << buildMs << "ms," << perLookupMs << "ms per lookup";
+    return found == prefixes.size() * SuggestionIndex::TOP_K;
+}
+
+// A misspelled title finds nothing, and the correction is offered after the empty results
+bool testDidYouMean(DatabaseManager& db) {
+    QueryHandler handler(&db);
+    QString correction;
+    int resultCount = -1;
+    QObject::connect(&handler, &QueryHandler::searchFinished,
+                     [&](quint64, const QVector<Textbook>& results) { resultCount = results.size(); });
+    QObject::connect(&handler, &QueryHandler::didYouMean,
+                     [&](quint64, const QString& text) { correction = text; });
+
+    QueryHandler::SearchRequest request;
+    request.title = "frankenstien";
+    handler.search(request);
+
+    QEventLoop loop;
+    QTimer::singleShot(1000, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    if (resultCount != 0 || correction != "Frankenstein") {
+        qDebug() << "Expected no books and Frankenstein, got" << resultCount << correction;
+        return false;
+    }
+    return true;
+}
+
+// The bit-parallel distance agrees with the textbook definition
+bool testEditDistance(DatabaseManager&) {
+    struct Case {
+        const char* a;
+        const char* b;
+        int distance;
+    };
+    const Case cases[] = {
+        {"calculas", "calculus", 1},
+        {"frankenstien", "frankenstein", 2},
+        {"kitten", "sitting", 3},
+        {"biology", "biology", 0},
+        {"a", "", 1},
+    };
+    for (const Case& c : cases) {
+        const int distance = FuzzyIndex::editDistance(QString(c.a), QString(c.b), 5);
+        if (distance != c.distance) {
+            qDebug() << c.a << c.b << "expected" << c.distance << "got" << distance;
+            return false;
+        }
+    }
+    // Past the bound the exact value does not matter
+    return FuzzyIndex::editDistance(QString("abc"), QString("xyzxyz"), 2) == 3;
+}
+
+// Every one letter typo over the words of a million titles gets a
+// correction; the per lookup time is logged
+bool testFuzzyLatency(DatabaseManager&) {
+    const QStringList syllables = {"ca", "lo", "bi", "chem", "ter", "ous", "ics", "na",
+                                   "phy", "sto", "ry", "al", "ge", "bra", "mi", "tion"};
+    QRandomGenerator random(7);
+    auto makeWord = [&]() {
+        QString word;
+        const int parts = 2 + random.bounded(3);
+        for (int i = 0; i < parts; ++i) {
+            word += syllables[random.bounded(syllables.size())];
+        }
+        return word;
+    };
+
+    FuzzyIndex index;
+    QElapsedTimer timer;
+    timer.start();
+    const int titleCount = 1000000;
+    for (int i = 0; i < titleCount; ++i) {
+        for (int w = 0; w < 4; ++w) {
+            index.insert(makeWord());
+        }
+    }
+    const qint64 buildMs = timer.elapsed();
+
+    // Misspell real terms by dropping one letter
+    QStringList typos;
+    for (int i = 0; i < 1000; ++i) {
+        QString word = makeWord();
+        word.remove(random.bounded(word.size()), 1);
+        typos.append(word);
+    }
+
+    int corrected = 0;
+    timer.restart();
+    for (const QString& typo : typos) {
+        corrected += index.lookup(typo, 5).isEmpty() ? 0 : 1;
+    }
+    const double perLookupMs = timer.nsecsElapsed() / 1e6 / typos.size();
+
+    qDebug() << "Fuzzy index:" << index.size() << "terms from" << titleCount << "titles, built in"
+             << buildMs << "ms," << perLookupMs << "ms per lookup";
+    return corrected == typos.size();
+}
+
+// The snapshot returns the same pages as SQLite on a million rows; both
+// timings are logged for comparison. The benchmark rows are removed again afterwards.
+bool testSnapshotMatchesSqlite(DatabaseManager& db) {
+    const int rowCount = 1000000;
+    const QStringList departments = {"CSC", "Mathematics", "English", "Science", "Social Sciences"};
+    const QStringList categories = {"CSC", "MAT", "ENG", "PHY", "ECO"};
+    QRandomGenerator random(11);
+
+    // Bulk rows go straight into the table, the catalog is reloaded once after
+    QSqlDatabase connection = DbConnector::database();
+    connection.transaction();
+    QSqlQuery insert(connection);
+    insert.prepare("INSERT INTO textbooks VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    for (int i = 0; i < rowCount; ++i) {
+        const int d = random.bounded(departments.size());
+        insert.addBindValue("bench-" + QString::number(i));
+        insert.addBindValue(departments[d]);
+        insert.addBindValue(QString::number(1 + random.bounded(3)));
+        insert.addBindValue(categories[d]);
+        insert.addBindValue(QString::number(100 + random.bounded(200)));
+        insert.addBindValue("Bench Title " + QString::number(i));
+        insert.addBindValue("Author " + QString::number(random.bounded(5000)));
+        insert.addBindValue(10 + random.bounded(20000) / 100.0);
+        insert.addBindValue(QString());
+        insert.exec();
+    }
+    connection.commit();
+
+    QElapsedTimer timer;
+    timer.start();
+    db.reloadCatalog();
+    const CatalogStore::Pin snapshot = db.catalog().pin();
+    qDebug() << "Snapshot of" << snapshot->size() << "rows loaded in" << timer.elapsed() << "ms";
+
+    struct Case {
+        CatalogSnapshot::Filter filter;
+        int page;
+    };
+    auto filter = [](QString department, QString lec, QString category, QString code, QString text,
+                     CatalogSort sort = CatalogSort::Newest) {
+        CatalogSnapshot::Filter f;
+        f.department = department;
+        f.lec = lec;
+        f.category = category;
+        f.code = code;
+        f.text = text;
+        f.sort = sort;
+        return f;
+    };
+    const QVector<Case> cases = {
+        {filter("", "", "MAT", "", ""), 1},
+        {filter("", "", "MAT", "", ""), 500},
+        {filter("", "", "CSC", "150", ""), 1},
+        {filter("Science", "", "", "", ""), 200},
+        {filter("", "2", "ENG", "", ""), 1},
+        {filter("", "", "ECO", "", "Author 42"), 3},
+        {filter("", "", "PHY", "999", ""), 1},
+        {filter("", "", "MAT", "", "", CatalogSort::PriceLowToHigh), 40},
+        {filter("", "", "", "", "", CatalogSort::PriceHighToLow), 1},
+        {filter("", "", "CSC", "150", "", CatalogSort::Title), 1},
+        {filter("", "", "ECO", "", "Author 42", CatalogSort::Title), 2},
+    };
+
+    bool same = true;
+    double sqliteMs = 0, snapshotMs = 0;
+    for (const Case& c : cases) {
+        timer.restart();
+        const QVector<Textbook> expected = db.getTextbooks(c.filter.department, c.filter.lec, c.filter.category,
+                                                           c.filter.code, c.filter.text, c.page, 9,
+                                                           c.filter.minPriceCents, c.filter.maxPriceCents,
+                                                           c.filter.sort);
+        sqliteMs += timer.nsecsElapsed() / 1e6;
+
+        timer.restart();
+        const QVector<Textbook> actual = snapshot->search(c.filter, c.page, 9);
+        snapshotMs += timer.nsecsElapsed() / 1e6;
+
+        QStringList expectedIds, actualIds;
+        for (const Textbook& book : expected) {
+            expectedIds.append(book.productId);
+        }
+        for (const Textbook& book : actual) {
+            actualIds.append(book.productId);
+        }
+        if (expectedIds != actualIds) {
+            qDebug() << "Page" << c.page << "differs:" << expectedIds << "vs" << actualIds;
+            same = false;
+        }
+    }
+    qDebug() << "SQLite" << sqliteMs << "ms, snapshot" << snapshotMs << "ms for" << cases.size() << "filters";
+
+    QSqlQuery cleanup(connection);
+    cleanup.exec("DELETE FROM textbooks WHERE product_id LIKE 'bench-%'");
+    db.reloadCatalog();
+    return same;
+}
+
+// Array and bitset chunks both count the same intersections as a plain scan
+bool testCompressedBitmap(DatabaseManager&) {
+    const int rows = 300000;
+    QRandomGenerator random(5);
+    CompressedBitmap sparse, dense;
+    QVector<quint64> selection((rows + 63) / 64, 0);
+    QVector<bool> inSparse(rows), inDense(rows), selected(rows);
+    for (int row = 0; row < rows; ++row) {
+        inSparse[row] = random.bounded(100) == 0;   // Stays in array chunks
+        inDense[row] = random.bounded(3) == 0;      // Turns into bitsets
+        selected[row] = random.bounded(2) == 0;
+        if (inSparse[row]) {
+            sparse.add(row);
+        }
+        if (inDense[row]) {
+            dense.add(row);
+        }
+        if (selected[row]) {
+            selection[row / 64] |= quint64(1) << (row % 64);
+        }
+    }
+
+    int sparseExpected = 0, denseExpected = 0;
+    for (int row = 0; row < rows; ++row) {
+        sparseExpected += inSparse[row] && selected[row];
+        denseExpected += inDense[row] && selected[row];
+        if (sparse.contains(row) != inSparse[row] || dense.contains(row) != inDense[row]) {
+            qDebug() << "Membership differs at row" << row;
+            return false;
+        }
+    }
+    qDebug() << "Sparse facet" << sparse.byteSize() << "bytes, dense facet" << dense.byteSize() << "bytes";
+    return sparse.intersectionCount(selection) == sparseExpected
+        && dense.intersectionCount(selection) == denseExpected;
+}
+
+// Each facet count is the number of books picking that choice would return
+bool testFacetCountsMatchResults(DatabaseManager& db) {
+    const CatalogStore::Pin catalog = db.catalog().pin();
+    CatalogSnapshot::Filter filter;
+    filter.category = "CSC";
+    const CatalogSnapshot::Facets facets = catalog->facets(filter);
+
+    for (const CatalogSnapshot::FacetCount& facet : facets.categories) {
+        CatalogSnapshot::Filter pick = filter;
+        pick.category = facet.value;
+        const int actual = catalog->search(pick, 1, catalog->size()).size();
+        if (actual != facet.count) {
+            qDebug() << "Category" << facet.value << "counted" << facet.count << "but returns" << actual;
+            return false;
+        }
+    }
+    for (const CatalogSnapshot::FacetCount& facet : facets.departments) {
+        CatalogSnapshot::Filter pick = filter;
+        pick.department = facet.value;
+        const int actual = catalog->search(pick, 1, catalog->size()).size();
+        if (actual != facet.count) {
+            qDebug() << "Department" << facet.value << "counted" << facet.count << "but returns" << actual;
+            return false;
+        }
+    }
+    for (int bucket = 0; bucket < facets.prices.size(); ++bucket) {
+        CatalogSnapshot::Filter pick = filter;
+        pick.minPriceCents = CatalogSnapshot::priceBucketRange(bucket).first;
+        pick.maxPriceCents = CatalogSnapshot::priceBucketRange(bucket).second;
+        if (catalog->search(pick, 1, catalog->size()).size() != facets.prices[bucket].count) {
+            qDebug() << "Price bucket" << facets.prices[bucket].value << "count differs";
+            return false;
+        }
+    }
+    return !facets.categories.isEmpty();
+}
+
+// Every sort reads its pages in index (or table) order for every filter
+// combination, so no plan falls back to sorting in a temp b-tree
+bool testSortedSearchesSkipTempSort(DatabaseManager& db) {
+    const QVector<CatalogSort> sorts = {CatalogSort::Newest, CatalogSort::PriceLowToHigh,
+                                        CatalogSort::PriceHighToLow, CatalogSort::Title};
+    QVector<CatalogSnapshot::Filter> filters(6);
+    filters[1].department = "English";
+    filters[2].category = "CSC";
+    filters[2].code = "101";
+    filters[3].text = "Calc";
+    filters[4].minPriceCents = 500;
+    filters[4].maxPriceCents = 9999;
+    filters[5].department = "Computer Science";
+    filters[5].lec = "1100";
+    filters[5].text = "C++";
+    filters[5].maxPriceCents = 19999;
+
+    bool ok = true;
+    for (CatalogSort sort : sorts) {
+        for (CatalogSnapshot::Filter filter : filters) {
+            filter.sort = sort;
+            const QString plan = db.explainTextbookSearch(filter).join(" | ");
+            const bool needsIndex = sort != CatalogSort::Newest;
+            // A price range is read from a price index, so only the price sorts come presorted
+            const bool rangeSorted = (filter.minPriceCents == 0 && filter.maxPriceCents == INT_MAX)
+                || sort == CatalogSort::PriceLowToHigh || sort == CatalogSort::PriceHighToLow;
+            if (plan.isEmpty() || (rangeSorted && plan.contains("TEMP B-TREE"))
+                || (needsIndex && !plan.contains("COVERING INDEX"))) {
+                qDebug() << "Sort" << int(sort) << "plan:" << plan;
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+// Price bounds compare whole cents, compose with the text filter, and are
+// answered by a range seek on a price index rather than a scan
+bool testPriceRangeIsIndexRange(DatabaseManager& db) {
+    auto ids = [](const QVector<Textbook>& books) {
+        QStringList productIds;
+        for (const Textbook& book : books) {
+            productIds.append(book.productId);
+        }
+        productIds.sort();
+        return productIds;
+    };
+    const CatalogStore::Pin catalog = db.catalog().pin();
+    CatalogSnapshot::Filter nineDollars;
+    nineDollars.minPriceCents = 900;
+    nineDollars.maxPriceCents = 900;
+    CatalogSnapshot::Filter frankenstein = nineDollars;
+    frankenstein.text = "Frank";
+
+    bool ok = ids(db.getTextbooks("", "", "", "", "", 1, 50, 900, 900)) == QStringList({"0006", "0007"})
+        && ids(catalog->search(nineDollars, 1, 50)) == QStringList({"0006", "0007"})
+        && ids(db.getTextbooks("", "", "", "", "Frank", 1, 50, 900, 900)) == QStringList({"0006"})
+        && ids(catalog->search(frankenstein, 1, 50)) == QStringList({"0006"})
+        && ids(db.getTextbooks("", "", "", "", "", 1, 50, 11070, 11070)) == QStringList({"0001"});
+
+    // Every sort reads a price range as an index range, with or without a category
+    const QVector<CatalogSort> sorts = {CatalogSort::Newest, CatalogSort::PriceLowToHigh,
+                                        CatalogSort::PriceHighToLow, CatalogSort::Title};
+    for (CatalogSort sort : sorts) {
+        CatalogSnapshot::Filter range;
+        range.minPriceCents = 500;
+        range.maxPriceCents = 9999;
+        range.sort = sort;
+        const QString rangePlan = db.explainTextbookSearch(range).join(" | ");
+        range.category = "ENG";
+        const QString categoryPlan = db.explainTextbookSearch(range).join(" | ");
+        if (!rangePlan.contains("SEARCH textbooks USING COVERING INDEX idx_textbooks_price_cents (<expr>")
+            || !categoryPlan.contains("idx_textbooks_category_price (course_category=? AND")) {
+            qDebug() << "Sort" << int(sort) << "range plans:" << rangePlan << categoryPlan;
+            ok = false;
+        }
+    }
+    const QPair<int, int> bounds = db.getPriceBoundsCents();
+    return ok && bounds.first == 515 && bounds.second == 18224;
+}
+
+// Readers on several threads always see a complete version while one writer
+// keeps publishing, and every replaced version is freed once they are done
+bool testCatalogStoreStress(DatabaseManager&) {
+    CatalogStore store;
+    store.publish(CatalogSnapshot());
+
+    const int readerCount = 8;
+    const int versions = 2000;
+    std::atomic<bool> writing{true};
+    std::atomic<int> errors{0};
+    std::atomic<qint64> reads{0};
+
+    QVector<QThread*> readers;
+    for (int r = 0; r < readerCount; ++r) {
+        readers.append(QThread::create([&]() {
+            quint64 lastSeen = 0;
+            while (writing.load()) {
+                const CatalogStore::Pin pin = store.pin();
+                // Version n holds exactly n - 1 books, numbered in order
+                const int size = pin->size();
+                if (pin.number() < lastSeen || size != int(pin.number()) - 1
+                    || (size > 0 && pin->book(size - 1).productId != QString::number(size))) {
+                    ++errors;
+                }
+                lastSeen = pin.number();
+                ++reads;
+            }
+        }));
+        readers.last()->start();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 1; i < versions; ++i) {
+        store.update([i](CatalogSnapshot& snapshot) {
+            snapshot.append(Textbook("CSC", "1", "CSC", "101", "Stress", "Writer",
+                                     QString::number(i), 1.0, QString()));
+        });
+    }
+    const qint64 writeMs = timer.elapsed();
+    writing = false;
+    for (QThread* reader : readers) {
+        reader->wait();
+        delete reader;
+    }
+
+    const int leftOver = store.reclaim();
+    qDebug() << reads.load() << "pinned reads across" << readerCount << "threads while publishing"
+             << versions << "versions in" << writeMs << "ms," << errors.load() << "inconsistent,"
+             << leftOver << "versions not reclaimed";
+    return errors.load() == 0 && leftOver == 0 && store.version() == quint64(versions);
+}
+
+// The profile loaded in one read at login follows cart, wishlist, profile
+// and listing changes, and ends up where a fresh load would
+bool testUserProfileFollowsChanges(DatabaseManager& db) {
+    const QString email = "profile.test@stu.bmcc.cuny.edu";
+    UserProfile profile(&db);
+    profile.load(email);
+    int notifications = 0;
+    QObject::connect(&profile, &UserProfile::changed, [&notifications]() { ++notifications; });
+    const bool emptyOk = profile.cartCount() == 0 && profile.wishlist().isEmpty()
+                      && profile.listingCount() == 0 && profile.major().isEmpty();
+
+    db.addToCart(email, "0006", 2);
+    db.addToCart("someone.else@stu.bmcc.cuny.edu", "0006", 5);
+    db.addToWishlist(email, "0006");
+    db.addToWishlist(email, "0007");
+    db.addToWishlist(email, "0007");  // Already there, no change
+    db.removeFromWishlist(email, "0006");
+    db.updateStudentProfile(email, "Computer Science", "Semester 2");
+    db.createTextbookListing("CSC", "1", "CSC", {"CSC 101"}, "Profile Test", "Author", 5.0, QString(), email);
+    const bool followed = notifications == 6 && profile.cartCount() == 2
+                       && qAbs(profile.cartTotal() - 18.0) < 0.001
+                       && profile.isInCart("0006") && !profile.isInCart("0007")
+                       && profile.wishlist().toList() == QStringList({"0007"})
+                       && profile.major() == "Computer Science" && profile.listingCount() == 1;
+
+    UserProfile fresh(&db);
+    fresh.load(email);
+    return emptyOk && followed && fresh.cartCount() == profile.cartCount()
+        && qAbs(fresh.cartTotal() - profile.cartTotal()) < 0.001 && fresh.wishlist() == profile.wishlist()
+        && fresh.cart() == profile.cart()
+        && fresh.semesterLevel() == profile.semesterLevel() && fresh.listingCount() == profile.listingCount()
+        && db.getListingsBySeller(email).size() == profile.listingCount();
+}
+
+// Each batch call is one change notification, duplicates and missing items are skipped
+bool testBatchCartAndWishlist(DatabaseManager& db) {
+    const QString email = "batch.test@stu.bmcc.cuny.edu";
+    UserProfile profile(&db);
+    profile.load(email);
+    int notifications = 0;
+    QObject::connect(&profile, &UserProfile::changed, [&notifications]() { ++notifications; });
+
+    const int added = db.addManyToCart(email, {"0001", "0002", "0001"});
+    const int addedAgain = db.addManyToCart(email, {"0001", "0002"});
+    db.addToWishlist(email, "0002");
+    db.addToWishlist(email, "0003");
+    const int moved = db.moveWishlistToCart(email, {"0002", "0003", "0004"});
+    const int removed = db.removeMany(email, {"0001", "0009"}, DatabaseManager::ItemList::Cart);
+
+    UserProfile fresh(&db);
+    fresh.load(email);
+    return added == 2 && addedAgain == 0 && moved == 2 && removed == 1 && notifications == 6
+        && profile.cart().toList() == QStringList({"0002", "0003"}) && profile.wishlist().isEmpty()
+        && fresh.cart() == profile.cart() && fresh.wishlist().isEmpty() && fresh.cartCount() == 2
+        && qAbs(fresh.cartTotal() - profile.cartTotal()) < 0.001;
+}
+
+// Background writes finish in submit order, failures are reported, and the
+// profile has applied a write's changes by the time its finished arrives
+bool testMutationQueueKeepsOrder(DatabaseManager& db) {
+    const QString email = "queue.test@stu.bmcc.cuny.edu";
+    UserProfile profile(&db);
+    profile.load(email);
+    MutationQueue queue(&db);
+
+    QVector<quint64> order;
+    QVector<bool> results;
+    bool profileAhead = true;
+    QEventLoop loop;
+    QObject::connect(&queue, &MutationQueue::finished, [&](quint64 ticket, bool ok) {
+        order.append(ticket);
+        results.append(ok);
+        if (ticket == 3) {
+            profileAhead = profile.isInCart("0005") && !profile.isWishlisted("0005");
+        }
+        if (queue.pending() == 0) {
+            loop.quit();
+        }
+    });
+
+    queue.submit([email](DatabaseManager& d) { return d.addToWishlist(email, "0005"); });
+    queue.submit([email](DatabaseManager& d) { return d.removeFromWishlist(email, "0005"); });
+    queue.submit([email](DatabaseManager& d) { return d.addToCart(email, "0005", 1); });
+    queue.submit([](DatabaseManager&) { return false; });
+    QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    return order == QVector<quint64>({1, 2, 3, 4}) && results == QVector<bool>({true, true, true, false})
+        && profileAhead && profile.cart().toList() == QStringList({"0005"}) && profile.wishlist().isEmpty();
+}
+
+// Adding a product that is already in the cart raises its quantity, it never adds a second row
+bool testAddToCartRaisesQuantity(DatabaseManager& db) {
+    const QString email = "quantity.test@stu.bmcc.cuny.edu";
+    const bool added = db.addToCart(email, "0003", 1) && db.addToCart(email, "0003", 2);
+
+    QSqlQuery query(DbConnector::database());
+    query.prepare("SELECT COUNT(*), SUM(quantity) FROM cart WHERE user_email = ? AND product_id = ?");
+    query.addBindValue(email);
+    query.addBindValue("0003");
+    if (!added || !query.exec() || !query.next()) {
+        return false;
+    }
+    return query.value(0).toInt() == 1 && query.value(1).toInt() == 3
+        && db.getCartSummary(email).first == 3;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir dir;
+    QDir::setCurrent(dir.path());
+    DatabaseManager db;
+
+    struct Test {
+        const char* name;
+        bool (*run)(DatabaseManager&);
+    };
+    const Test tests[] = {
+        {"superseded searches are dropped", testSupersededSearchesAreDropped},
+        {"search text is bound", testSearchTextIsBound},
+        {"page turns served from prefetch", testPageTurnsServedFromPrefetch},
+        {"suggestions from catalog", testSuggestionsFromCatalog},
+        {"suggestion ranking", testSuggestionRanking},
+        {"suggestion latency", testSuggestionLatency},
+        {"did you mean", testDidYouMean},
+        {"edit distance", testEditDistance},
+        {"fuzzy latency", testFuzzyLatency},
+        {"snapshot matches sqlite", testSnapshotMatchesSqlite},
+        {"catalog store stress", testCatalogStoreStress},
+        {"compressed bitmap", testCompressedBitmap},
+        {"facet counts match results", testFacetCountsMatchResults},
+        {"sorted searches skip temp sort", testSortedSearchesSkipTempSort},
+        {"price range is an index range", testPriceRangeIsIndexRange},
+        {"user profile follows changes", testUserProfileFollowsChanges},
+        {"batch cart and wishlist", testBatchCartAndWishlist},
+        {"add to cart raises quantity", testAddToCartRaisesQuantity},
+        {"mutation queue keeps click order", testMutationQueueKeepsOrder},
+    };
+
+    int failures = 0;
+    for (const Test& test : tests) {
+        bool ok = test.run(db);
+        qDebug() << (ok ? "PASS" : "FAIL") << test.name;
+        failures += ok ? 0 : 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
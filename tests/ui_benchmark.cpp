@@ -0,0 +1,250 @@
+#include <QApplication>
+#include <QWidget>
+#include <QGridLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QFile>
+#include <QPixmap>
+#include <QElapsedTimer>
+#include <QGraphicsDropShadowEffect>
+#include <QDebug>
+#include "ui/card_frame.h"
+#include "ui/theme.h"
+#include "ui/listing_widget.h"
+#include "ui/row_pool.h"
+#include <unistd.h>
+
+// Paint time benchmarks for the shop pages. Run with QT_QPA_PLATFORM=offscreen
+// when there is no display.
+
+static const int CARD_COUNT = 60;   // A full catalog page
+static const int FRAMES = 30;       // Repaints averaged per measurement
+
+// Old approach: stylesheet card with its own QGraphicsDropShadowEffect
+static QWidget* buildEffectPage() {
+    QWidget* page = new QWidget;
+    QGridLayout* grid = new QGridLayout(page);
+    grid->setSpacing(20);
+    for (int i = 0; i < CARD_COUNT; ++i) {
+        QWidget* card = new QWidget;
+        card->setFixedSize(250, 300);
+        card->setStyleSheet(
+            "QWidget {"
+            "    background-color: white;"
+            "    border: 1px solid #E0E0E0;"
+            "    border-radius: 10px;"
+            "}"
+        );
+        QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect;
+        shadow->setBlurRadius(10);
+        shadow->setColor(QColor(0, 0, 0, 30));
+        shadow->setOffset(0, 2);
+        card->setGraphicsEffect(shadow);
+        grid->addWidget(card, i / 6, i % 6);
+    }
+    return page;
+}
+
+// New approach: CardFrame with the shared nine-patch shadow
+static QWidget* buildCardFramePage() {
+    QWidget* page = new QWidget;
+    QGridLayout* grid = new QGridLayout(page);
+    grid->setSpacing(20);
+    for (int i = 0; i < CARD_COUNT; ++i) {
+        CardFrame* card = new CardFrame(CardFrame::Shadow::Small, 10);
+        card->setFixedCardSize(250, 300);
+        grid->addWidget(card, i / 6, i % 6);
+    }
+    return page;
+}
+
+// Old approach: every label and button gets its own concatenated style sheet
+static QWidget* buildStyleSheetPage() {
+    const QString sageGreen = "#9CAF88";
+    const QString darkBlue = "#2C3E50";
+    QWidget* page = new QWidget;
+    QGridLayout* grid = new QGridLayout(page);
+    for (int i = 0; i < CARD_COUNT; ++i) {
+        QWidget* card = new QWidget;
+        QVBoxLayout* layout = new QVBoxLayout(card);
+        QLabel* title = new QLabel(QString("Textbook %1").arg(i));
+        title->setStyleSheet("font-size: 16px; font-weight: bold; color: " + darkBlue + ";");
+        QLabel* price = new QLabel("$42.00");
+        price->setStyleSheet("font-size: 18px; font-weight: bold; color: " + sageGreen + ";");
+        QPushButton* button = new QPushButton("Add to Cart");
+        button->setStyleSheet(
+            "QPushButton {"
+            "    background-color: " + sageGreen + ";"
+            "    color: white;"
+            "    border: none;"
+            "    border-radius: 20px;"
+            "    padding: 12px 25px;"
+            "    font-size: 16px;"
+            "    font-weight: bold;"
+            "}"
+            "QPushButton:hover {"
+            "    background-color: " + darkBlue + ";"
+            "}"
+        );
+        layout->addWidget(title);
+        layout->addWidget(price);
+        layout->addWidget(button);
+        grid->addWidget(card, i / 6, i % 6);
+    }
+    return page;
+}
+
+// New approach: the same widgets tagged with theme roles
+static QWidget* buildRolePage() {
+    QWidget* page = new QWidget;
+    QGridLayout* grid = new QGridLayout(page);
+    for (int i = 0; i < CARD_COUNT; ++i) {
+        QWidget* card = new QWidget;
+        QVBoxLayout* layout = new QVBoxLayout(card);
+        QLabel* title = new QLabel(QString("Textbook %1").arg(i));
+        Theme::setRole(title, Theme::Role::CardTitle);
+        QLabel* price = new QLabel("$42.00");
+        Theme::setRole(price, Theme::Role::Price);
+        QPushButton* button = new QPushButton("Add to Cart");
+        Theme::setRole(button, Theme::Role::PrimaryButton);
+        layout->addWidget(title);
+        layout->addWidget(price);
+        layout->addWidget(button);
+        grid->addWidget(card, i / 6, i % 6);
+    }
+    return page;
+}
+
+// Resident set size in kilobytes, 0 where /proc is not available
+static qint64 residentKb() {
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    QList<QByteArray> fields = statm.readAll().split(' ');
+    return fields.size() > 1 ? fields[1].toLongLong() * (sysconf(_SC_PAGESIZE) / 1024) : 0;
+}
+
+struct BuildResult {
+    double ms;
+    qint64 kb;
+};
+
+// Milliseconds to build, polish and lay out a page, and the memory it added
+static BuildResult measureBuild(QWidget* (*build)()) {
+    qint64 before = residentKb();
+    QElapsedTimer timer;
+    timer.start();
+    QWidget* page = build();
+    page->resize(page->sizeHint());
+    page->show();  // Polishes every widget
+    QApplication::processEvents();
+    BuildResult result = {timer.nsecsElapsed() / 1e6, residentKb() - before};
+    delete page;
+    QApplication::processEvents();
+    return result;
+}
+
+static QVector<Textbook> sampleBooks(double firstPrice) {
+    QVector<Textbook> books;
+    for (int i = 0; i < CARD_COUNT; ++i) {
+        books.append(Textbook("Computer Science", "1234", "CSC", QString::number(100 + i),
+                              QString("Textbook %1").arg(i), "Author", QString("tb_%1").arg(i),
+                              i == 0 ? firstPrice : 42.0, ""));
+    }
+    return books;
+}
+
+// Average milliseconds per catalog refresh where only one book's price changed,
+// rebuilding every card against reconciling a RowPool
+static void measureRefresh(double& rebuildMs, double& reconcileMs) {
+    QWidget page;
+    QGridLayout* grid = new QGridLayout(&page);
+    page.show();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        QLayoutItem* item;
+        while ((item = grid->takeAt(0)) != nullptr) {
+            delete item->widget();
+            delete item;
+        }
+        QVector<Textbook> books = sampleBooks(frame);
+        for (int i = 0; i < books.size(); ++i) {
+            grid->addWidget(new BookCard(books[i]), i / 3, i % 3);
+        }
+        QApplication::processEvents();
+    }
+    rebuildMs = timer.nsecsElapsed() / 1e6 / FRAMES;
+
+    QLayoutItem* item;
+    while ((item = grid->takeAt(0)) != nullptr) {
+        delete item->widget();
+        delete item;
+    }
+
+    RowPool<BookCard> pool(grid, 3);
+    timer.restart();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        pool.reconcile(sampleBooks(frame),
+            [](const Textbook& book) { return book.productId; },
+            [](const Textbook& book) { return new BookCard(book); });
+        QApplication::processEvents();
+    }
+    reconcileMs = timer.nsecsElapsed() / 1e6 / FRAMES;
+}
+
+// Average milliseconds to repaint the whole page into a pixmap
+static double measurePaint(QWidget* page) {
+    page->resize(page->sizeHint());
+    page->show();
+    QApplication::processEvents();
+
+    QPixmap target(page->size());
+    page->render(&target);  // Warm up caches
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < FRAMES; ++i) {
+        page->render(&target);
+    }
+    return timer.nsecsElapsed() / 1e6 / FRAMES;
+}
+
+int main(int argc, char *argv[]) {
+    QApplication app(argc, argv);
+    Theme::apply(app);
+
+    QWidget* effectPage = buildEffectPage();
+    double effectMs = measurePaint(effectPage);
+    delete effectPage;
+
+    QWidget* framePage = buildCardFramePage();
+    double frameMs = measurePaint(framePage);
+    delete framePage;
+
+    qDebug() << "Card shadows," << CARD_COUNT << "cards, average of" << FRAMES << "repaints";
+    qDebug() << "  QGraphicsDropShadowEffect:" << QString::number(effectMs, 'f', 2) << "ms/frame";
+    qDebug() << "  CardFrame nine-patch:     " << QString::number(frameMs, 'f', 2) << "ms/frame";
+    qDebug() << "  Speedup:" << QString::number(effectMs / qMax(frameMs, 0.001), 'f', 1) << "x";
+
+    // Build each page once before measuring so fonts and style plugins are loaded
+    delete buildStyleSheetPage();
+    delete buildRolePage();
+    BuildResult sheet = measureBuild(buildStyleSheetPage);
+    BuildResult roles = measureBuild(buildRolePage);
+
+    qDebug() << "Page build," << CARD_COUNT << "cards with a title, price and button";
+    qDebug() << "  Per-widget style sheets:" << QString::number(sheet.ms, 'f', 2) << "ms," << sheet.kb << "KB";
+    qDebug() << "  Theme roles:            " << QString::number(roles.ms, 'f', 2) << "ms," << roles.kb << "KB";
+
+    double rebuildMs = 0, reconcileMs = 0;
+    measureRefresh(rebuildMs, reconcileMs);
+    qDebug() << "Catalog refresh," << CARD_COUNT << "cards with one price change, average of" << FRAMES << "refreshes";
+    qDebug() << "  Rebuild every card:" << QString::number(rebuildMs, 'f', 2) << "ms";
+    qDebug() << "  RowPool reconcile: " << QString::number(reconcileMs, 'f', 2) << "ms";
+
+    return 0;
+}